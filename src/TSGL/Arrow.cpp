@@ -291,14 +291,15 @@ void Arrow::setLength(GLfloat length) {
         return;
     }
     attribMutex.lock();
+    Transform t = getTransform();
     float ratio = length / myLength;
     myLength = length;
-    myEndpointX1 = (myEndpointX1 - myCenterX) * ratio + myCenterX;
-    myEndpointY1 = (myEndpointY1 - myCenterY) * ratio + myCenterY;
-    myEndpointZ1 = (myEndpointZ1 - myCenterZ) * ratio + myCenterZ;
-    myEndpointX2 = (myEndpointX2 - myCenterX) * ratio + myCenterX;
-    myEndpointY2 = (myEndpointY2 - myCenterY) * ratio + myCenterY;
-    myEndpointZ2 = (myEndpointZ2 - myCenterZ) * ratio + myCenterZ;
+    myEndpointX1 = (myEndpointX1 - t.centerX) * ratio + t.centerX;
+    myEndpointY1 = (myEndpointY1 - t.centerY) * ratio + t.centerY;
+    myEndpointZ1 = (myEndpointZ1 - t.centerZ) * ratio + t.centerZ;
+    myEndpointX2 = (myEndpointX2 - t.centerX) * ratio + t.centerX;
+    myEndpointY2 = (myEndpointY2 - t.centerY) * ratio + t.centerY;
+    myEndpointZ2 = (myEndpointZ2 - t.centerZ) * ratio + t.centerZ;
     attribMutex.unlock();
     recalculateVertices();
 }
@@ -313,14 +314,15 @@ void Arrow::changeLengthBy(GLfloat delta) {
         return;
     }
     attribMutex.lock();
+    Transform t = getTransform();
     float ratio = (myLength + delta) / myLength;
     myLength += delta;
-    myEndpointX1 = (myEndpointX1 - myCenterX) * ratio + myCenterX;
-    myEndpointY1 = (myEndpointY1 - myCenterY) * ratio + myCenterY;
-    myEndpointZ1 = (myEndpointZ1 - myCenterZ) * ratio + myCenterZ;
-    myEndpointX2 = (myEndpointX2 - myCenterX) * ratio + myCenterX;
-    myEndpointY2 = (myEndpointY2 - myCenterY) * ratio + myCenterY;
-    myEndpointZ2 = (myEndpointZ2 - myCenterZ) * ratio + myCenterZ;
+    myEndpointX1 = (myEndpointX1 - t.centerX) * ratio + t.centerX;
+    myEndpointY1 = (myEndpointY1 - t.centerY) * ratio + t.centerY;
+    myEndpointZ1 = (myEndpointZ1 - t.centerZ) * ratio + t.centerZ;
+    myEndpointX2 = (myEndpointX2 - t.centerX) * ratio + t.centerX;
+    myEndpointY2 = (myEndpointY2 - t.centerY) * ratio + t.centerY;
+    myEndpointZ2 = (myEndpointZ2 - t.centerZ) * ratio + t.centerZ;
     attribMutex.unlock();
     recalculateVertices();
 }
@@ -364,6 +366,7 @@ void Arrow::changeWidthBy(GLfloat delta) {
 void Arrow::setFirstEndpoint(GLfloat x, GLfloat y, GLfloat z) {
     attribMutex.lock();
     myEndpointX1 = x; myEndpointY1 = y; myEndpointZ1 = z;
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointX = (myEndpointX2 + myEndpointX1) / 2;
         myRotationPointY = (myEndpointY2 + myEndpointY1) / 2;
@@ -377,6 +380,7 @@ void Arrow::setFirstEndpoint(GLfloat x, GLfloat y, GLfloat z) {
         myCenterZ = (myEndpointZ2 + myEndpointZ1) / 2;
     }
     myCurrentYaw = myCurrentPitch = myCurrentRoll = 0;
+    endTransform();
     myLength = sqrt(pow(myEndpointX2 - myEndpointX1, 2) + pow(myEndpointY2 - myEndpointY1, 2) + pow(myEndpointZ2 - myEndpointZ1, 2));
     attribMutex.unlock(); 
     recalculateVertices();
@@ -391,6 +395,7 @@ void Arrow::setFirstEndpoint(GLfloat x, GLfloat y, GLfloat z) {
 void Arrow::setSecondEndpoint(GLfloat x, GLfloat y, GLfloat z) {
     attribMutex.lock();
     myEndpointX2 = x; myEndpointY2 = y; myEndpointZ2 = z;
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointX = (myEndpointX2 + myEndpointX1) / 2;
         myRotationPointY = (myEndpointY2 + myEndpointY1) / 2;
@@ -404,6 +409,7 @@ void Arrow::setSecondEndpoint(GLfloat x, GLfloat y, GLfloat z) {
         myCenterZ = (myEndpointZ2 + myEndpointZ1) / 2;
     }
     myCurrentYaw = myCurrentPitch = myCurrentRoll = 0;
+    endTransform();
     myLength = sqrt(pow(myEndpointX2 - myEndpointX1, 2) + pow(myEndpointY2 - myEndpointY1, 2) + pow(myEndpointZ2 - myEndpointZ1, 2)); 
     attribMutex.unlock();
     recalculateVertices();
@@ -416,25 +422,26 @@ void Arrow::setSecondEndpoint(GLfloat x, GLfloat y, GLfloat z) {
  */
 float Arrow::getFirstEndpointX() {
     attribMutex.lock();
+    Transform t = getTransform();
     float ex1;
-    if (myEndpointX1 == myRotationPointX && myEndpointY1 == myRotationPointY && myEndpointZ1 == myRotationPointZ) {
+    if (myEndpointX1 == t.rotationX && myEndpointY1 == t.rotationY && myEndpointZ1 == t.rotationZ) {
         ex1 = myEndpointX1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ex1;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ex1 = myEndpointX1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ex1;
     }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ex1 = cosYaw * cosPitch * (myEndpointX1 - myRotationPointX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myEndpointY1 - myRotationPointY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myEndpointZ1 - myRotationPointZ) + myRotationPointX;
-    attribMutex.unlock();
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ex1 = cosYaw * cosPitch * (myEndpointX1 - t.rotationX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myEndpointY1 - t.rotationY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myEndpointZ1 - t.rotationZ) + t.rotationX;
+    attribMutex.unlockUnchanged();
     return ex1;
 }
 
@@ -445,25 +452,26 @@ float Arrow::getFirstEndpointX() {
  */
 float Arrow::getFirstEndpointY() {
     attribMutex.lock();
+    Transform t = getTransform();
     float ey1;
-    if (myEndpointX1 == myRotationPointX && myEndpointY1 == myRotationPointY && myEndpointZ1 == myRotationPointZ) {
+    if (myEndpointX1 == t.rotationX && myEndpointY1 == t.rotationY && myEndpointZ1 == t.rotationZ) {
         ey1 = myEndpointY1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ey1;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ey1 = myEndpointY1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ey1;
     }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ey1 = sinYaw * cosPitch * (myEndpointX1 - myRotationPointX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myEndpointY1 - myRotationPointY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myEndpointZ1 - myRotationPointZ)  + myRotationPointY;
-    attribMutex.unlock();
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ey1 = sinYaw * cosPitch * (myEndpointX1 - t.rotationX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myEndpointY1 - t.rotationY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myEndpointZ1 - t.rotationZ)  + t.rotationY;
+    attribMutex.unlockUnchanged();
     return ey1;
 }
 
@@ -474,23 +482,24 @@ float Arrow::getFirstEndpointY() {
  */
 float Arrow::getFirstEndpointZ() {
     attribMutex.lock();
+    Transform t = getTransform();
     float ez1;
-    if (myEndpointX1 == myRotationPointX && myEndpointY1 == myRotationPointY && myEndpointZ1 == myRotationPointZ) {
+    if (myEndpointX1 == t.rotationX && myEndpointY1 == t.rotationY && myEndpointZ1 == t.rotationZ) {
         ez1 = myEndpointZ1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ez1;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ez1 = myEndpointZ1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ez1;
     }
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ez1 = -sinPitch * (myEndpointX1 - myRotationPointX) + cosPitch * sinRoll * (myEndpointY1 - myRotationPointY) + cosPitch * cosRoll * (myEndpointZ1 - myRotationPointZ) + myRotationPointZ;
-    attribMutex.unlock();
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ez1 = -sinPitch * (myEndpointX1 - t.rotationX) + cosPitch * sinRoll * (myEndpointY1 - t.rotationY) + cosPitch * cosRoll * (myEndpointZ1 - t.rotationZ) + t.rotationZ;
+    attribMutex.unlockUnchanged();
     return ez1;
 }
 
@@ -501,25 +510,26 @@ float Arrow::getFirstEndpointZ() {
  */
 float Arrow::getSecondEndpointX() {
     attribMutex.lock();
+    Transform t = getTransform();
     float ex2;
-    if (myEndpointX2 == myRotationPointX && myEndpointY2 == myRotationPointY && myEndpointZ2 == myRotationPointZ) {
+    if (myEndpointX2 == t.rotationX && myEndpointY2 == t.rotationY && myEndpointZ2 == t.rotationZ) {
         ex2 = myEndpointX2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ex2;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ex2 = myEndpointX2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ex2;
     }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ex2 = cosYaw * cosPitch * (myEndpointX2 - myRotationPointX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myEndpointY2 - myRotationPointY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myEndpointZ2 - myRotationPointZ) + myRotationPointX;
-    attribMutex.unlock();
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ex2 = cosYaw * cosPitch * (myEndpointX2 - t.rotationX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myEndpointY2 - t.rotationY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myEndpointZ2 - t.rotationZ) + t.rotationX;
+    attribMutex.unlockUnchanged();
     return ex2;
 }
 
@@ -530,25 +540,26 @@ float Arrow::getSecondEndpointX() {
  */
 float Arrow::getSecondEndpointY() {
     attribMutex.lock();
+    Transform t = getTransform();
     float ey2;
-    if (myEndpointX2 == myRotationPointX && myEndpointY2 == myRotationPointY && myEndpointZ2 == myRotationPointZ) {
+    if (myEndpointX2 == t.rotationX && myEndpointY2 == t.rotationY && myEndpointZ2 == t.rotationZ) {
         ey2 = myEndpointY2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ey2;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ey2 = myEndpointY2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ey2;
     }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ey2 = sinYaw * cosPitch * (myEndpointX2 - myRotationPointX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myEndpointY2 - myRotationPointY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myEndpointZ2 - myRotationPointZ)  + myRotationPointY;
-    attribMutex.unlock();
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ey2 = sinYaw * cosPitch * (myEndpointX2 - t.rotationX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myEndpointY2 - t.rotationY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myEndpointZ2 - t.rotationZ)  + t.rotationY;
+    attribMutex.unlockUnchanged();
     return ey2;
 }
 
@@ -559,23 +570,24 @@ float Arrow::getSecondEndpointY() {
  */
 float Arrow::getSecondEndpointZ() {
     attribMutex.lock();
+    Transform t = getTransform();
     float ez2;
-    if (myEndpointX2 == myRotationPointX && myEndpointY2 == myRotationPointY && myEndpointZ2 == myRotationPointZ) {
+    if (myEndpointX2 == t.rotationX && myEndpointY2 == t.rotationY && myEndpointZ2 == t.rotationZ) {
         ez2 = myEndpointZ2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ez2;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ez2 = myEndpointZ2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ez2;
     }
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ez2 = -sinPitch * (myEndpointX2 - myRotationPointX) + cosPitch * sinRoll * (myEndpointY2 - myRotationPointY) + cosPitch * cosRoll * (myEndpointZ2 - myRotationPointZ) + myRotationPointZ;
-    attribMutex.unlock();
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ez2 = -sinPitch * (myEndpointX2 - t.rotationX) + cosPitch * sinRoll * (myEndpointY2 - t.rotationY) + cosPitch * cosRoll * (myEndpointZ2 - t.rotationZ) + t.rotationZ;
+    attribMutex.unlockUnchanged();
     return ez2;
 }
 
@@ -588,17 +600,11 @@ void Arrow::setColor(ColorFloat c[]) {
     attribMutex.lock();
     myAlpha = (c[0].A + c[1].A) / 2;
     for(int i = 0; i < 7; i++) {
-        vertices[i*7 + 3] = c[i/5].R;
-        vertices[i*7 + 4] = c[i/5].G;
-        vertices[i*7 + 5] = c[i/5].B;
-        vertices[i*7 + 6] = c[i/5].A;
+        setVertexColor(i, c[i/5]);
     }
     if (isDoubleArrow) {
         for(int i = 7; i < 10; i++) {
-            vertices[i*7 + 3] = c[1].R;
-            vertices[i*7 + 4] = c[1].G;
-            vertices[i*7 + 5] = c[1].B;
-            vertices[i*7 + 6] = c[1].A;
+            setVertexColor(i, c[1]);
         }
     }
     attribMutex.unlock();
@@ -612,57 +618,60 @@ void Arrow::setColor(ColorFloat c[]) {
  */
 void Arrow::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
-    colorVec.push_back(ColorFloat(vertices[3],vertices[4],vertices[5],vertices[6]));
-    colorVec.push_back(ColorFloat(vertices[38],vertices[39],vertices[40],vertices[41]));
-    attribMutex.unlock();
+    colorVec.push_back(getVertexColor(0));
+    colorVec.push_back(getVertexColor(5));
+    attribMutex.unlockUnchanged();
 }
 
 /*! \brief Private helper method that recalculates vertices array whenever endpoints are altered.
- *  \details Assigns new values to coordinates section of vertices[], principally based on myEndpoint and myWidth.
+ *  \details Assigns new values to coordinates section of vertices[], principally based on myEndpoint and myWidth,
+ *   and triangulates the new outline.
  */
 void Arrow::recalculateVertices() {
     attribMutex.lock();
+    Transform t = getTransform();
     glm::vec3 v1 = { myEndpointX2 - myEndpointX1, myEndpointY2 - myEndpointY1, myEndpointZ2 - myEndpointZ1 };
     glm::vec3 v2 = { 0,0,1 };
     glm::vec3 cross = glm::normalize(glm::cross(v1, v2));
     cross *= myWidth;
-    glm::vec3 e1 = { myEndpointX1 - myCenterX, myEndpointY1 - myCenterY, myEndpointZ1 - myCenterZ };
-    glm::vec3 e2 = { myEndpointX2 - myCenterX, myEndpointY2 - myCenterY, myEndpointZ2 - myCenterZ };
+    glm::vec3 e1 = { myEndpointX1 - t.centerX, myEndpointY1 - t.centerY, myEndpointZ1 - t.centerZ };
+    glm::vec3 e2 = { myEndpointX2 - t.centerX, myEndpointY2 - t.centerY, myEndpointZ2 - t.centerZ };
 
     glm::vec3 base1 = { e1.x + v1.x / 10, e1.y + v1.y / 10, e1.z + v1.z / 10 };
     glm::vec3 base2 = { e2.x - v1.x / 10, e2.y - v1.y / 10, e2.z - v1.z / 10 };
 
-    vertices[0] = base1.x + cross.x * 0.2; vertices[1] = base1.y + cross.y * 0.2; vertices[2] = base1.z + cross.z * 0.2;
-    vertices[7] = base1.x + cross.x * 0.5; vertices[8] = base1.y + cross.y * 0.5; vertices[9] = base1.z + cross.z * 0.5;
-    vertices[14] = e1.x;                   vertices[15] = e1.y;                   vertices[16] = e1.z;
-    vertices[21] = base1.x + cross.x * -0.5; vertices[22] = base1.y + cross.y * -0.5; vertices[23] = base1.z + cross.z * -0.5;
-    vertices[28] = base1.x + cross.x * -0.2; vertices[29] = base1.y + cross.y * -0.2; vertices[30] = base1.z + cross.z * -0.2;
+    setVertexPosition(0, base1.x + cross.x * 0.2, base1.y + cross.y * 0.2, base1.z + cross.z * 0.2);
+    setVertexPosition(1, base1.x + cross.x * 0.5, base1.y + cross.y * 0.5, base1.z + cross.z * 0.5);
+    setVertexPosition(2, e1.x, e1.y, e1.z);
+    setVertexPosition(3, base1.x + cross.x * -0.5, base1.y + cross.y * -0.5, base1.z + cross.z * -0.5);
+    setVertexPosition(4, base1.x + cross.x * -0.2, base1.y + cross.y * -0.2, base1.z + cross.z * -0.2);
 
-    outlineVertices[0] = base1.x + cross.x * 0.2; outlineVertices[1] = base1.y + cross.y * 0.2; outlineVertices[2] = base1.z + cross.z * 0.2;
-    outlineVertices[7] = base1.x + cross.x * 0.5; outlineVertices[8] = base1.y + cross.y * 0.5; outlineVertices[9] = base1.z + cross.z * 0.5;
-    outlineVertices[14] = e1.x;                   outlineVertices[15] = e1.y;                   outlineVertices[16] = e1.z;
-    outlineVertices[21] = base1.x + cross.x * -0.5; outlineVertices[22] = base1.y + cross.y * -0.5; outlineVertices[23] = base1.z + cross.z * -0.5;
-    outlineVertices[28] = base1.x + cross.x * -0.2; outlineVertices[29] = base1.y + cross.y * -0.2; outlineVertices[30] = base1.z + cross.z * -0.2;
+    setOutlineVertexPosition(0, base1.x + cross.x * 0.2, base1.y + cross.y * 0.2, base1.z + cross.z * 0.2);
+    setOutlineVertexPosition(1, base1.x + cross.x * 0.5, base1.y + cross.y * 0.5, base1.z + cross.z * 0.5);
+    setOutlineVertexPosition(2, e1.x, e1.y, e1.z);
+    setOutlineVertexPosition(3, base1.x + cross.x * -0.5, base1.y + cross.y * -0.5, base1.z + cross.z * -0.5);
+    setOutlineVertexPosition(4, base1.x + cross.x * -0.2, base1.y + cross.y * -0.2, base1.z + cross.z * -0.2);
 
     if( isDoubleArrow ) {
-        vertices[35] = base2.x + cross.x * -0.2; vertices[36] = base2.y + cross.y * -0.2; vertices[37] = base2.z + cross.z * -0.2;
-        vertices[42] = base2.x + cross.x * -0.5; vertices[43] = base2.y + cross.y * -0.5; vertices[44] = base2.z + cross.z * -0.5;
-        vertices[49] = e2.x;                   vertices[50] = e2.y;                   vertices[51] = e2.z;
-        vertices[56] = base2.x + cross.x * 0.5; vertices[57] = base2.y + cross.y * 0.5; vertices[58] = base2.z + cross.z * 0.5;
-        vertices[63] = base2.x + cross.x * 0.2; vertices[64] = base2.y + cross.y * 0.2; vertices[65] = base2.z + cross.z * 0.2;
-
-        outlineVertices[35] = base2.x + cross.x * -0.2; outlineVertices[36] = base2.y + cross.y * -0.2; outlineVertices[37] = base2.z + cross.z * -0.2;
-        outlineVertices[42] = base2.x + cross.x * -0.5; outlineVertices[43] = base2.y + cross.y * -0.5; outlineVertices[44] = base2.z + cross.z * -0.5;
-        outlineVertices[49] = e2.x;                     outlineVertices[50] = e2.y;                   outlineVertices[51] = e2.z;
-        outlineVertices[56] = base2.x + cross.x * 0.5; outlineVertices[57] = base2.y + cross.y * 0.5; outlineVertices[58] = base2.z + cross.z * 0.5;
-        outlineVertices[63] = base2.x + cross.x * 0.2; outlineVertices[64] = base2.y + cross.y * 0.2; outlineVertices[65] = base2.z + cross.z * 0.2;
+        setVertexPosition(5, base2.x + cross.x * -0.2, base2.y + cross.y * -0.2, base2.z + cross.z * -0.2);
+        setVertexPosition(6, base2.x + cross.x * -0.5, base2.y + cross.y * -0.5, base2.z + cross.z * -0.5);
+        setVertexPosition(7, e2.x, e2.y, e2.z);
+        setVertexPosition(8, base2.x + cross.x * 0.5, base2.y + cross.y * 0.5, base2.z + cross.z * 0.5);
+        setVertexPosition(9, base2.x + cross.x * 0.2, base2.y + cross.y * 0.2, base2.z + cross.z * 0.2);
+
+        setOutlineVertexPosition(5, base2.x + cross.x * -0.2, base2.y + cross.y * -0.2, base2.z + cross.z * -0.2);
+        setOutlineVertexPosition(6, base2.x + cross.x * -0.5, base2.y + cross.y * -0.5, base2.z + cross.z * -0.5);
+        setOutlineVertexPosition(7, e2.x, e2.y, e2.z);
+        setOutlineVertexPosition(8, base2.x + cross.x * 0.5, base2.y + cross.y * 0.5, base2.z + cross.z * 0.5);
+        setOutlineVertexPosition(9, base2.x + cross.x * 0.2, base2.y + cross.y * 0.2, base2.z + cross.z * 0.2);
     } else {
-        vertices[35] = e2.x + cross.x * -0.2; vertices[36] = e2.y + cross.y * -0.2; vertices[37] = e2.z + cross.z * -0.2;
-        vertices[42] = e2.x + cross.x *  0.2; vertices[43] = e2.y + cross.y *  0.2; vertices[44] = e2.z + cross.z *  0.2;
+        setVertexPosition(5, e2.x + cross.x * -0.2, e2.y + cross.y * -0.2, e2.z + cross.z * -0.2);
+        setVertexPosition(6, e2.x + cross.x *  0.2, e2.y + cross.y *  0.2, e2.z + cross.z *  0.2);
     
-        outlineVertices[35] = e2.x + cross.x * -0.2; outlineVertices[36] = e2.y + cross.y * -0.2; outlineVertices[37] = e2.z + cross.z * -0.2;
-        outlineVertices[42] = e2.x + cross.x *  0.2; outlineVertices[43] = e2.y + cross.y *  0.2; outlineVertices[44] = e2.z + cross.z *  0.2;
+        setOutlineVertexPosition(5, e2.x + cross.x * -0.2, e2.y + cross.y * -0.2, e2.z + cross.z * -0.2);
+        setOutlineVertexPosition(6, e2.x + cross.x *  0.2, e2.y + cross.y *  0.2, e2.z + cross.z *  0.2);
     }
+    triangulate();
     attribMutex.unlock();
 }
 
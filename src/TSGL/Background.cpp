@@ -23,6 +23,8 @@ Background::Background(GLint width, GLint height, const ColorFloat &clearColor)
     toClear = false;
     complete = false;
     newPixelsDrawn = true;
+    viewportX = viewportY = viewportWidth = viewportHeight = 0;
+    readPixelBuffer = nullptr;
 
     pixelTextureBuffer = new uint8_t[myWidth * myHeight * 4];
     for (int i = 0; i < myWidth * myHeight * 4; ++i) {
@@ -139,6 +141,7 @@ void Background::draw() {
 
     attribMutex.lock();
     if (toClear) {
+        glClearColor(baseColor.R, baseColor.G, baseColor.B, baseColor.A);   // Other Backgrounds may share the context
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         toClear = false;
     }
@@ -147,6 +150,20 @@ void Background::draw() {
     glViewport(0,0,myWidth,myHeight);
 
     drawableMutex.lock();
+    takeSubmissions();
+    // asynchronously loaded Images are drawn on the first frame after they finish decoding
+    for (unsigned int i = 0; i < myPendingImages.size(); ) {
+        Image * image = myPendingImages[i];
+        if (image->isLoaded() || image->loadFailed()) {
+            if (image->isLoaded())
+                myDrawables->push(image);
+            else
+                delete image;
+            myPendingImages.erase(myPendingImages.begin() + i);
+        } else {
+            i++;
+        }
+    }
     for (unsigned int i = 0; i < myDrawables->size(); i++)
     {
         Drawable* d = (*myDrawables)[i];
@@ -206,7 +223,7 @@ void Background::draw() {
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    glViewport(0,0,framebufferWidth,framebufferHeight);
+    applyViewport();
 
     glDisable(GL_DEPTH_TEST);
 
@@ -231,6 +248,18 @@ void Background::draw() {
     glEnable(GL_DEPTH_TEST);
 }
 
+// Queues a procedurally drawn Drawable for the next frame, without waiting on other drawing threads
+void Background::submit(Drawable * d) {
+    mySubmissions.push(d);
+    drawableMutex.raise();
+}
+
+// Called by the rendering thread, with drawableMutex locked, to move every submitted Drawable into myDrawables
+void Background::takeSubmissions() {
+    Array<Drawable*> * drawables = myDrawables;
+    mySubmissions.drain([drawables](Drawable * d) { drawables->push(d); });
+}
+
 /*! \brief Activates the corresponding Shader for a given Drawable.
  *  \param sType Unsigned int with a corresponding value for each type of Shader.
  */
@@ -279,6 +308,9 @@ void Background::selectShaders(unsigned int sType) {
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "view"), 1, GL_FALSE, &view[0][0]);
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    program->projection = projection;
+    program->view = view;
+    program->viewportHeight = myHeight;
 }
 
 /*!\brief Procedurally draws an Arrow to the Background.
@@ -297,9 +329,7 @@ void Background::selectShaders(unsigned int sType) {
 void Background::drawArrow(float x, float y, float z, float length, float width, float yaw, float pitch, float roll, ColorFloat color, bool doubleArrow, bool outlined) {
     Arrow * a = new Arrow(x,y,z,length,width,yaw,pitch,roll,color,doubleArrow);
     a->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(a);
-    drawableMutex.unlock();
+    submit(a);
 }
 
 /*!\brief Procedurally draws an Arrow to the Background.
@@ -318,9 +348,7 @@ void Background::drawArrow(float x, float y, float z, float length, float width,
 void Background::drawArrow(float x, float y, float z, float length, float width, float yaw, float pitch, float roll, ColorFloat color[], bool doubleArrow, bool outlined) {
     Arrow * a = new Arrow(x,y,z,length,width,yaw,pitch,roll,color,doubleArrow);
     a->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(a);
-    drawableMutex.unlock();
+    submit(a);
 }
 
 /*!\brief Procedurally draws a Circle to the Background.
@@ -338,9 +366,7 @@ void Background::drawArrow(float x, float y, float z, float length, float width,
 void Background::drawCircle(float x, float y, float z, float radius, float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     Circle * c = new Circle(x,y,z,radius,yaw,pitch,roll,color);
     c->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(c);
-    drawableMutex.unlock();
+    submit(c);
 }
 
 /*!\brief Procedurally draws a Circle to the Background.
@@ -358,9 +384,7 @@ void Background::drawCircle(float x, float y, float z, float radius, float yaw,
 void Background::drawCircle(float x, float y, float z, float radius, float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     Circle * c = new Circle(x,y,z,radius,yaw,pitch,roll,color);
     c->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(c);
-    drawableMutex.unlock();
+    submit(c);
 }
 
 /*!\brief Procedurally draws a ConcavePolygon to the Background.
@@ -381,9 +405,7 @@ void Background::drawCircle(float x, float y, float z, float radius, float yaw,
 void Background::drawConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     ConcavePolygon * c = new ConcavePolygon(centerX,centerY,centerZ,numVertices,x,y,yaw,pitch,roll,color);
     c->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(c);
-    drawableMutex.unlock();
+    submit(c);
 }
 
 /*!\brief Procedurally draws a ConcavePolygon to the Background.
@@ -404,9 +426,7 @@ void Background::drawConcavePolygon(float centerX, float centerY, float centerZ,
 void Background::drawConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     ConcavePolygon * c = new ConcavePolygon(centerX,centerY,centerZ,numVertices,x,y,yaw,pitch,roll,color);
     c->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(c);
-    drawableMutex.unlock();
+    submit(c);
 }
 
 /*!\brief Procedurally draws a ConvexPolygon to the Background.
@@ -426,9 +446,7 @@ void Background::drawConcavePolygon(float centerX, float centerY, float centerZ,
 void Background::drawConvexPolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     ConvexPolygon * c = new ConvexPolygon(centerX,centerY,centerZ,numVertices,x,y,yaw,pitch,roll,color);
     c->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(c);
-    drawableMutex.unlock();
+    submit(c);
 }
 
 /*!\brief Procedurally draws a ConvexPolygon to the Background.
@@ -448,9 +466,7 @@ void Background::drawConvexPolygon(float centerX, float centerY, float centerZ,
 void Background::drawConvexPolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     ConvexPolygon * c = new ConvexPolygon(centerX,centerY,centerZ,numVertices,x,y,yaw,pitch,roll,color);
     c->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(c);
-    drawableMutex.unlock();
+    submit(c);
 }
 
 /*!\brief Procedurally draws an Ellipse to the Background.
@@ -469,9 +485,7 @@ void Background::drawConvexPolygon(float centerX, float centerY, float centerZ,
 void Background::drawEllipse(float x, float y, float z, float xRadius, float yRadius, float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     Ellipse * e = new Ellipse(x,y,z,xRadius,yRadius,yaw,pitch,roll,color);
     e->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(e);
-    drawableMutex.unlock();
+    submit(e);
 }
 
 /*!\brief Procedurally draws an Ellipse to the Background.
@@ -490,9 +504,7 @@ void Background::drawEllipse(float x, float y, float z, float xRadius, float yRa
 void Background::drawEllipse(float x, float y, float z, float xRadius, float yRadius, float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     Ellipse * e = new Ellipse(x,y,z,xRadius,yRadius,yaw,pitch,roll,color);
     e->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(e);
-    drawableMutex.unlock();
+    submit(e);
 }
 
 /*!\brief Procedurally draws an Image to the Background.
@@ -505,12 +517,34 @@ void Background::drawEllipse(float x, float y, float z, float xRadius, float yRa
  * \param pitch The Image's pitch rotation.
  * \param roll The Image's roll rotation.
  * \param alpha Alpha value for the Image's transparency.
+ * \param async Whether to decode the file on a worker thread instead of before returning. The Image is
+ *   then drawn on the first frame after it has been decoded, on top of whatever was drawn before it.
+ * \note The Background keeps each file it has drawn decoded (and uploaded) until it is destroyed,
+ *   so drawing the same file every frame does not reload it.
  */
-void Background::drawImage(float x, float y, float z, std::string filename, float width, float height, float yaw, float pitch, float roll, float alpha) {
-    Image * i = new Image(x,y,z,filename,width,height,yaw,pitch,roll,alpha);
+void Background::drawImage(float x, float y, float z, std::string filename, float width, float height, float yaw, float pitch, float roll, float alpha, bool async) {
     drawableMutex.lock();
-    myDrawables->push(i);
+    bool cached = myImages.find(filename) != myImages.end();
     drawableMutex.unlock();
+    if (!cached) {
+        // Decode without drawableMutex, which the render thread needs every frame
+        TextureCache::Entry * entry = TextureCache::acquire(filename, async);
+        drawableMutex.lock();
+        if (myImages.find(filename) == myImages.end()) {
+            myImages[filename] = entry;
+            entry = nullptr;
+        }
+        drawableMutex.unlock();
+        TextureCache::release(entry);       // Another thread cached the file first
+    }
+    Image * i = new Image(x,y,z,filename,width,height,yaw,pitch,roll,alpha,async);
+    if (async && !i->isLoaded()) {
+        drawableMutex.lock();
+        myPendingImages.push_back(i);
+        drawableMutex.unlock();
+    } else {
+        submit(i);
+    }
 }
 
 /*!
@@ -529,9 +563,7 @@ void Background::drawImage(float x, float y, float z, std::string filename, floa
  */
 void Background::drawLine(float x1, float y1, float z1, float x2, float y2, float z2, float yaw, float pitch, float roll, ColorFloat color) {
     Line * l = new Line(x1,y1,z1,x2,y2,z2,yaw,pitch,roll,color);
-    drawableMutex.lock();
-    myDrawables->push(l);
-    drawableMutex.unlock();
+    submit(l);
 }
 
 /*!
@@ -550,9 +582,7 @@ void Background::drawLine(float x1, float y1, float z1, float x2, float y2, floa
  */
 void Background::drawLine(float x1, float y1, float z1, float x2, float y2, float z2, float yaw, float pitch, float roll, ColorFloat color[]) {
     Line * l = new Line(x1,y1,z1,x2,y2,z2,yaw,pitch,roll,color);
-    drawableMutex.lock();
-    myDrawables->push(l);
-    drawableMutex.unlock();
+    submit(l);
 }
 
 /*!\brief Procedurally draws a Line to the Background.
@@ -568,9 +598,7 @@ void Background::drawLine(float x1, float y1, float z1, float x2, float y2, floa
  */
 void Background::drawLine(float x, float y, float z, float length, float yaw, float pitch, float roll, ColorFloat color) {
     Line * l = new Line(x,y,z,length,yaw,pitch,roll,color);
-    drawableMutex.lock();
-    myDrawables->push(l);
-    drawableMutex.unlock();
+    submit(l);
 }
 
 /*!\brief Procedurally draws a Line to the Background.
@@ -586,9 +614,7 @@ void Background::drawLine(float x, float y, float z, float length, float yaw, fl
  */
 void Background::drawLine(float x, float y, float z, float length, float yaw, float pitch, float roll, ColorFloat color[]) {
     Line * l = new Line(x,y,z,length,yaw,pitch,roll,color);
-    drawableMutex.lock();
-    myDrawables->push(l);
-    drawableMutex.unlock();
+    submit(l);
 }
 
  /*!
@@ -652,9 +678,7 @@ void Background::drawPixel(float x, float y, ColorInt c) {
  */
 void Background::drawPolyline(float x, float y, float z, int numVertices, float lineVertices[], float yaw, float pitch, float roll, ColorFloat color) {
     Polyline * p = new Polyline(x,y,z,numVertices,lineVertices,yaw,pitch,roll,color);
-    drawableMutex.lock();
-    myDrawables->push(p);
-    drawableMutex.unlock();
+    submit(p);
 }
 
 /*!\brief Procedurally draws a Polyline to the Background.
@@ -671,9 +695,7 @@ void Background::drawPolyline(float x, float y, float z, int numVertices, float
  */
 void Background::drawPolyline(float x, float y, float z, int numVertices, float lineVertices[], float yaw, float pitch, float roll, ColorFloat color[]) {
     Polyline * p = new Polyline(x,y,z,numVertices,lineVertices,yaw,pitch,roll,color);
-    drawableMutex.lock();
-    myDrawables->push(p);
-    drawableMutex.unlock();
+    submit(p);
 }
 
 /*!\brief Procedurally draws a Rectangle to the Background.
@@ -692,9 +714,7 @@ void Background::drawPolyline(float x, float y, float z, int numVertices, float
 void Background::drawRectangle(float x, float y, float z, float width, float height, float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     Rectangle * r = new Rectangle(x,y,z,width,height,yaw,pitch,roll,color);
     r->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(r);
-    drawableMutex.unlock();
+    submit(r);
 }
 /*!\brief Procedurally draws a Rectangle to the Background.
  * \details Initializes a new Rectangle based on the parameter values, and then adds it to the Array of Drawables to be rendered.
@@ -712,9 +732,7 @@ void Background::drawRectangle(float x, float y, float z, float width, float hei
 void Background::drawRectangle(float x, float y, float z, float width, float height, float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     Rectangle * r = new Rectangle(x,y,z,width,height,yaw,pitch,roll,color);
     r->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(r);
-    drawableMutex.unlock();
+    submit(r);
 }
 
 /*!\brief Procedurally draws a RegularPolygon to the Background.
@@ -733,9 +751,7 @@ void Background::drawRectangle(float x, float y, float z, float width, float hei
 void Background::drawRegularPolygon(float x, float y, float z, float radius, int sides, float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     RegularPolygon * r = new RegularPolygon(x,y,z,radius,sides,yaw,pitch,roll,color);
     r->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(r);
-    drawableMutex.unlock();
+    submit(r);
 }
 
 /*!\brief Procedurally draws a RegularPolygon to the Background.
@@ -754,9 +770,7 @@ void Background::drawRegularPolygon(float x, float y, float z, float radius, int
 void Background::drawRegularPolygon(float x, float y, float z, float radius, int sides, float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     RegularPolygon * r = new RegularPolygon(x,y,z,radius,sides,yaw,pitch,roll,color);
     r->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(r);
-    drawableMutex.unlock();
+    submit(r);
 }
 
 /*!\brief Procedurally draws a Square to the Background.
@@ -774,9 +788,7 @@ void Background::drawRegularPolygon(float x, float y, float z, float radius, int
 void Background::drawSquare(float x, float y, float z, float sidelength, float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     Square * s = new Square(x,y,z,sidelength,yaw,pitch,roll,color);
     s->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(s);  // Push it onto our drawing buffer
-    drawableMutex.unlock();
+    submit(s);  // Push it onto our drawing buffer
 }
 
 /*!\brief Procedurally draws a Square to the Background.
@@ -794,9 +806,7 @@ void Background::drawSquare(float x, float y, float z, float sidelength, float y
 void Background::drawSquare(float x, float y, float z, float sidelength, float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     Square * s = new Square(x,y,z,sidelength,yaw,pitch,roll,color);
     s->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(s);  // Push it onto our drawing buffer
-    drawableMutex.unlock();
+    submit(s);  // Push it onto our drawing buffer
 }
 
 /*!\brief Procedurally draws a Star to the Background.
@@ -816,9 +826,7 @@ void Background::drawSquare(float x, float y, float z, float sidelength, float y
 void Background::drawStar(float x, float y, float z, float radius, int points, float yaw, float pitch, float roll, ColorFloat color, bool ninja, bool outlined) {
     Star * s = new Star(x,y,z,radius,points,yaw,pitch,roll,color,ninja);
     s->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(s);  // Push it onto our drawing buffer
-    drawableMutex.unlock();   
+    submit(s);  // Push it onto our drawing buffer
 }
 
 /*!\brief Procedurally draws a Star to the Background.
@@ -838,9 +846,7 @@ void Background::drawStar(float x, float y, float z, float radius, int points, f
 void Background::drawStar(float x, float y, float z, float radius, int points, float yaw, float pitch, float roll, ColorFloat color[], bool ninja, bool outlined) {
     Star * s = new Star(x,y,z,radius,points,yaw,pitch,roll,color,ninja);
     s->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(s);  // Push it onto our drawing buffer
-    drawableMutex.unlock();   
+    submit(s);  // Push it onto our drawing buffer
 }
 
 /*!\brief Procedurally draws Text to the Background.
@@ -877,9 +883,7 @@ void Background::drawText(float x, float y, float z, std::string text, std::stri
  */
 void Background::drawText(float x, float y, float z, std::wstring text, std::string fontFilename, float size, float yaw, float pitch, float roll, const ColorFloat &color) {
     Text * t = new Text(x,y,z,text,fontFilename,size,yaw,pitch,roll,color);
-    drawableMutex.lock();
-    myDrawables->push(t);  // Push it onto our drawing buffer
-    drawableMutex.unlock();
+    submit(t);  // Push it onto our drawing buffer
 }
 
 /*!\brief Procedurally draws a Triangle to the Background.
@@ -902,9 +906,7 @@ void Background::drawText(float x, float y, float z, std::wstring text, std::str
 void Background::drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     Triangle * t = new Triangle(x1,y1,z1,x2,y2,z2,x3,y3,z3,yaw,pitch,roll,color);
     t->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(t);  // Push it onto our drawing buffer
-    drawableMutex.unlock();
+    submit(t);  // Push it onto our drawing buffer
 }
 
 /*!\brief Procedurally draws a Triangle to the Background.
@@ -927,9 +929,7 @@ void Background::drawTriangle(float x1, float y1, float z1, float x2, float y2,
 void Background::drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     Triangle * t = new Triangle(x1,y1,z1,x2,y2,z2,x3,y3,z3,yaw,pitch,roll,color);
     t->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(t);  // Push it onto our drawing buffer
-    drawableMutex.unlock();
+    submit(t);  // Push it onto our drawing buffer
 }
 
 /*!\brief Procedurally draws a TriangleStrip to the Background.
@@ -950,9 +950,7 @@ void Background::drawTriangle(float x1, float y1, float z1, float x2, float y2,
 void Background::drawTriangleStrip(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float z[], float yaw, float pitch, float roll, ColorFloat color, bool outlined) {
     TriangleStrip * t = new TriangleStrip(centerX,centerY,centerZ,numVertices,x,y,z,yaw,pitch,roll,color);
     t->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(t);  // Push it onto our drawing buffer
-    drawableMutex.unlock();
+    submit(t);  // Push it onto our drawing buffer
 }
 
 /*!\brief Procedurally draws a TriangleStrip to the Background.
@@ -973,9 +971,7 @@ void Background::drawTriangleStrip(float centerX, float centerY, float centerZ,
 void Background::drawTriangleStrip(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float z[], float yaw, float pitch, float roll, ColorFloat color[], bool outlined) {
     TriangleStrip * t = new TriangleStrip(centerX,centerY,centerZ,numVertices,x,y,z,yaw,pitch,roll,color);
     t->setIsOutlined(outlined);
-    drawableMutex.lock();
-    myDrawables->push(t);  // Push it onto our drawing buffer
-    drawableMutex.unlock();
+    submit(t);  // Push it onto our drawing buffer
 }
 
  /*!
@@ -1010,11 +1006,53 @@ void Background::setClearColor(ColorFloat c) {
     attribMutex.unlock();
 }
 
+/*!
+* \brief Mutator for the ChangeSignal raised when the Background is drawn to or cleared.
+* \details Canvas calls this when the Background is given to it, and when the Canvas is deleted.
+*   \param signal The Canvas' ChangeSignal, or nullptr for none.
+*/
+void Background::setChangeSignal(ChangeSignal * signal) {
+    attribMutex.setSignal(signal);
+    drawableMutex.setSignal(signal);
+    pixelBufferMutex.setSignal(signal);
+}
+
+/*!
+* \brief Mutator for the part of the window the Background is drawn into.
+* \details By default, a Background is stretched over the whole window. A Canvas calls this to draw the
+*   Background of a Viewport into just the Viewport.
+*   \param x The x coordinate in framebuffer pixels of the left of the region, from the left of the window.
+*   \param y The y coordinate in framebuffer pixels of the bottom of the region, from the bottom of the window.
+*   \param width The width of the region in framebuffer pixels, or 0 for the whole window.
+*   \param height The height of the region in framebuffer pixels.
+*/
+void Background::setViewport(GLint x, GLint y, GLint width, GLint height) {
+    attribMutex.lock();
+    viewportX = x, viewportY = y;
+    viewportWidth = width, viewportHeight = height;
+    attribMutex.unlock();
+}
+
+// Sets the GL viewport to the part of the window the Background is drawn into
+void Background::applyViewport() {
+    attribMutex.lock();
+    if (viewportWidth > 0)
+        glViewport(viewportX, viewportY, viewportWidth, viewportHeight);
+    else
+        glViewport(0,0,framebufferWidth,framebufferHeight);
+    attribMutex.unlock();
+}
+
 /*!
 * \brief Destructor for the Background.
 */
 Background::~Background() {
+    takeSubmissions();
     myDrawables->clear();
+    for (std::map<std::string, TextureCache::Entry*>::iterator it = myImages.begin(); it != myImages.end(); ++it)
+        TextureCache::release(it->second);
+    for (unsigned int i = 0; i < myPendingImages.size(); i++)
+        delete myPendingImages[i];
     delete [] readPixelBuffer;
     delete [] pixelTextureBuffer;
     delete [] vertices;
@@ -15,6 +15,7 @@
 #include "Ellipse.h"
 #include "Image.h"
 #include "Line.h"
+#include "LineSet.h"
 #include "Polyline.h"
 #include "Rectangle.h"
 #include "RegularPolygon.h"
@@ -23,8 +24,12 @@
 #include "Text.h"
 #include "Triangle.h"
 #include "TriangleStrip.h"
+#include "SubmissionQueue.h" // Our own queue for drawing from many threads without waiting on each other
 #include "Util.h"           // Needed constants and has cmath for performing math operations
 
+#include <map>              // For the files retained by drawImage()
+#include <vector>
+
 namespace tsgl {
 
 /*! \class Background
@@ -35,6 +40,7 @@ class Background {
 protected:
     GLint myWidth, myHeight;
     GLint framebufferWidth, framebufferHeight;
+    GLint viewportX, viewportY, viewportWidth, viewportHeight;  // Part of the window drawn to, or all of it if viewportWidth is 0
     GLfloat myWorldZ;
 
     GLuint multisampledTexture, intermediateTexture;
@@ -42,6 +48,9 @@ protected:
     GLuint RBO;
 
     Array<Drawable*> * myDrawables;
+    SubmissionQueue<Drawable*> mySubmissions;               // Drawables drawn since the last frame, one lane per drawing thread
+    std::map<std::string, TextureCache::Entry*> myImages;   // Files drawn by drawImage(), kept decoded between frames
+    std::vector<Image*> myPendingImages;                    // Asynchronous drawImage() calls still being decoded
 
     Camera * myCamera;
 
@@ -55,18 +64,24 @@ protected:
     std::mutex readPixelMutex;
     uint8_t* readPixelBuffer;
 
-    std::mutex pixelBufferMutex;
+    ChangeMutex pixelBufferMutex;
     GLuint pixelTexture;
     uint8_t* pixelTextureBuffer;
     bool newPixelsDrawn;
 
     bool complete;
-    std::mutex attribMutex;
-    std::mutex drawableMutex;
+    ChangeMutex attribMutex;
+    ChangeMutex drawableMutex;
   
     GLfloat * vertices;
 
     virtual void selectShaders(unsigned int sType);
+
+    void applyViewport();
+
+    void submit(Drawable * d);
+
+    void takeSubmissions();
 public:
     Background(GLint width, GLint height, const ColorFloat &c = WHITE);
 
@@ -98,7 +113,7 @@ public:
 
     virtual void drawEllipse(float x, float y, float z, float xRadius, float yRadius, float yaw, float pitch, float roll, ColorFloat color[], bool outlined = false);
 
-    virtual void drawImage(float x, float y, float z, std::string filename, float width, float height, float yaw, float pitch, float roll, float alpha = 1.0f);
+    virtual void drawImage(float x, float y, float z, std::string filename, float width, float height, float yaw, float pitch, float roll, float alpha = 1.0f, bool async = false);
 
     virtual void drawLine(float x1, float y1, float z1, float x2, float y2, float z2, float yaw, float pitch, float roll, ColorFloat color);
 
@@ -164,6 +179,10 @@ public:
 
     virtual void setClearColor(ColorFloat c);
 
+    void setViewport(GLint x, GLint y, GLint width, GLint height);
+
+    void setChangeSignal(ChangeSignal * signal);
+
     virtual ~Background();
 };
 
@@ -136,7 +136,7 @@ Camera::Camera(float posX, float posY, float posZ, float upX, float upY, float u
 glm::mat4 Camera::getViewMatrix() {
     attribMutex.lock();
     glm::mat4 v = glm::lookAt(myPosition, myPosition + myFront, myUp);
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return v;
 }
 
@@ -359,7 +359,7 @@ void Camera::changePitchBy(float delta) {
 float Camera::getPitch() {
     attribMutex.lock();
     float p = myPitch;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return p;
 }
 
@@ -370,7 +370,7 @@ float Camera::getPitch() {
 float Camera::getYaw() {
     attribMutex.lock();
     float y = myYaw;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return y;
 }
 
@@ -381,7 +381,7 @@ float Camera::getYaw() {
 glm::vec3 Camera::getPosition() {
     attribMutex.lock();
     glm::vec3 p = myPosition;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return p;  
 }
 
@@ -392,7 +392,7 @@ glm::vec3 Camera::getPosition() {
 float Camera::getPositionX() {
     attribMutex.lock();
     float x = myPosition.x;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return x;  
 }
 
@@ -403,7 +403,7 @@ float Camera::getPositionX() {
 float Camera::getPositionY() {
     attribMutex.lock();
     float y = myPosition.y;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return y;  
 }
 
@@ -414,7 +414,7 @@ float Camera::getPositionY() {
 float Camera::getPositionZ() {
     attribMutex.lock();
     float z = myPosition.z;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return z;  
 }
 
@@ -425,7 +425,7 @@ float Camera::getPositionZ() {
 glm::vec3 Camera::getTarget() {
     attribMutex.lock();
     glm::vec3 t = myPosition + myFront;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return t;  
 }
 
@@ -436,7 +436,7 @@ glm::vec3 Camera::getTarget() {
 float Camera::getTargetX() {
     attribMutex.lock();
     glm::vec3 t = myPosition + myFront;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return t.x;  
 }
 
@@ -447,7 +447,7 @@ float Camera::getTargetX() {
 float Camera::getTargetY() {
     attribMutex.lock();
     glm::vec3 t = myPosition + myFront;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return t.y;  
 }
 
@@ -458,7 +458,7 @@ float Camera::getTargetY() {
 float Camera::getTargetZ() {
     attribMutex.lock();
     glm::vec3 t = myPosition + myFront;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return t.z;  
 }
 
@@ -9,6 +9,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <mutex>
+#include "ChangeSignal.h"   // For waking the Canvas when the Camera moves
 #include "Util.h"           // Needed constants and has cmath for performing math operations
 
 namespace tsgl {
@@ -28,7 +29,7 @@ protected:
     float myYaw;
     float myPitch;
 
-    std::mutex attribMutex;
+    ChangeMutex attribMutex;
 
     void updateCameraAngle();
 public:
@@ -99,6 +100,12 @@ public:
     float getTargetY();
 
     float getTargetZ();
+
+    /*!
+     * \brief Mutator for the ChangeSignal raised when the Camera moves.
+     *   \param signal The Canvas' ChangeSignal, or nullptr for none.
+     */
+    void setChangeSignal(ChangeSignal * signal) { attribMutex.setSignal(signal); }
 };
 
 }
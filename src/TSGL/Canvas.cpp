@@ -21,20 +21,25 @@ static const GLchar* shapeVertexShader =
   "#version 330 core\n"
   "layout (location = 0) in vec3 aPos;"
   "layout (location = 1) in vec4 aColor;"
+  "layout (location = 2) in float aSize;"
   "out vec4 color;"
   "uniform mat4 projection;"
   "uniform mat4 view;"
   "uniform mat4 model;"
+  "uniform vec4 tint = vec4(1.0);"
   "void main() {"
   "gl_Position = projection * view * model * vec4(aPos, 1.0);"
-	"color = aColor;"
+	"gl_PointSize = aSize;"
+	"color = aColor * tint;"
   "}";
 
 static const GLchar* shapeFragmentShader =
   "#version 330 core\n"
   "out vec4 FragColor;"
   "in vec4 color;"
+  "uniform bool roundPoints = false;"
   "void main() {"
+	"if (roundPoints && length(gl_PointCoord - vec2(0.5)) > 0.5) discard;"
 	"FragColor = color;"
   "}";
 
@@ -126,19 +131,114 @@ Canvas::Canvas(int x, int y, int width, int height, std::string title, ColorFloa
   * \details Frees up memory that was allocated to a Canvas instance.
   */
 Canvas::~Canvas() {
+    if (usesRenderService && started)
+      stop();       // Keep the RenderService from drawing us after we're gone
     // Free our pointer memory
     delete drawTimer;
     delete camera;
     delete [] screenBuffer;
     if (defaultBackground) {
       delete myBackground;
+    } else {
+      myBackground->setChangeSignal(nullptr);
     }
+    for (unsigned i = 0; i < viewports.size(); i++)
+      delete viewports[i];
+    // Keep the Drawables that outlive us from raising our ChangeSignal
+    objectMutex.lock();
+    takePendingObjects();
+    for (unsigned i = 0; i < objectBuffer.size(); i++)
+      objectBuffer[i]->setChangeSignal(nullptr);
+    objectMutex.unlockUnchanged();
+    delete changeSignal;
     if (--openCanvases == 0) {
+        RenderService::shutdown();  // Stop the shared rendering thread, if it was used
         glfwIsReady = false;
         glfwTerminate();  // Terminate GLFW
     }
 }
 
+// Called by the rendering thread after each frame in PACE_ADAPTIVE: runs at the fixed rate while frames are cheap
+// enough for it, and otherwise lowers the rate to leave some headroom, down to minimumFPS.
+void Canvas::adaptFrameRate(double cost) {
+    std::lock_guard<std::mutex> lock(syncMutex);    // setFramePacing() resets frameCost
+    frameCost = (frameCost == 0) ? cost : 0.9 * frameCost + 0.1 * cost;
+    if (framePacing == PACE_ADAPTIVE)   // Unless it was changed during this frame
+      drawTimer->setPeriod(std::min(1.0 / minimumFPS, std::max(framePeriod, 1.25 * frameCost)));
+}
+
+ /*!
+  * \brief Makes a set of changes that the Canvas shows all at once.
+  * \details Calls <code>changes</code> between beginUpdate() and endUpdate(), so the Canvas draws either
+  *   none of the changes it makes or all of them, and never a frame in between. Each of the changes
+  *   is made while the Canvas is not drawing, so the Drawables' locks are never waited on.
+  * \details Changes made by threads that <code>changes</code> starts, such as an OpenMP parallel region, are shown
+  *   with the rest only if those threads finish before it returns. They may call pauseDrawing() or beginUpdate()
+  *   themselves: as the batch's update is in progress, they join it without waiting for the Canvas to draw.
+  * \details The update is ended even if <code>changes</code> throws.
+  *   \param changes The function that makes the changes, such as a lambda: <code>can.batch([&]() { ... });</code>
+  * \note Like an update, a batch keeps the Canvas from drawing until it returns, so keep it short.
+  * \see beginUpdate()
+  */
+void Canvas::batch(const voidFunction& changes) {
+    beginUpdate();
+    try {
+      changes();
+    } catch (...) {
+      endUpdate();
+      throw;
+    }
+    endUpdate();
+}
+
+ /*!
+  * \brief Starts an update that the Canvas should not draw until it is complete.
+  * \details This function waits until the Canvas finishes drawing its current frame, if it is drawing one,
+  *   then keeps it from drawing another until a matching call to endUpdate(). Between the two calls,
+  *   any number of Drawables can be changed and the Canvas will show either all of the changes or none of them.
+  * \details Any number of threads, whether started with OpenMP or std::thread, may be in an update at once.
+  *   The Canvas draws its next frame as soon as the last of them calls endUpdate().
+  * \details Updates may be nested within a thread. While any update is in progress, a thread that starts one
+  *   joins it at once, even if the Canvas is waiting to draw, since the threads already in an update
+  *   may be waiting on it (such as at an OpenMP barrier). Once every update has ended and the Canvas is waiting
+  *   to draw, new updates wait for it to draw its frame, so that a steady stream of updates cannot keep it from drawing.
+  * \note Keep updates short: the Canvas cannot draw while any are in progress.
+  * \warning <b>Every call to beginUpdate() must be matched by a call to endUpdate() from the same thread.</b>
+  * \see endUpdate(), batch()
+  */
+void Canvas::beginUpdate() {
+    std::unique_lock<std::mutex> lock(syncMutex);
+    int& depth = updateDepths[std::this_thread::get_id()];
+    if (depth == 0)     // Updates already in progress may depend on this one, so it joins them without waiting
+      syncCondition.wait(lock, [this]() { return updatesInProgress > 0 || (!frameWaiting && !frameInProgress); });
+    ++depth;
+    ++updatesInProgress;
+}
+
+// Called by the rendering thread before drawing: waits for every update to end, then blocks new ones.
+void Canvas::beginFrame() {
+    std::unique_lock<std::mutex> lock(syncMutex);
+    frameWaiting = true;
+    syncCondition.wait(lock, [this]() { return updatesInProgress == 0; });
+    frameWaiting = false;
+    frameInProgress = true;
+    ++startedFrames;
+}
+
+// Called by a rendering thread that draws other Canvases too: begins a frame like beginFrame() if no update is in
+// progress, and otherwise returns false at once, keeping new updates from starting so the next try succeeds.
+bool Canvas::tryBeginFrame() {
+    std::lock_guard<std::mutex> lock(syncMutex);
+    if (updatesInProgress > 0) {
+      frameWaiting = true;
+      return false;
+    }
+    frameWaiting = false;
+    frameInProgress = true;
+    ++startedFrames;
+    return true;
+}
+
  /*!
   * \brief Binds a key or button to a function.
   * \details This function binds a key or mouse button to a function pointer.
@@ -166,6 +266,7 @@ void Canvas::bindToScroll(std::function<void(double, double)> function) {
 void Canvas::buttonCallback(GLFWwindow* window, int button, int action, int mods) {
     if (action == GLFW_REPEAT) return;
     Canvas* can = reinterpret_cast<Canvas*>(glfwGetWindowUserPointer(window));
+    can->changeSignal->notify();
     int index = button + action * (GLFW_KEY_LAST + 1);
     if (&(can->boundKeys[index]) != nullptr) if (can->boundKeys[index]) can->boundKeys[index]();
 }
@@ -189,6 +290,7 @@ void Canvas::clearBackground() {
 void Canvas::close() {
     glfwSetWindowShouldClose(window, GL_TRUE);
     toClose = true;
+    changeSignal->wake();
     TsglDebug("Window closed successfully.");
 }
 
@@ -198,13 +300,82 @@ void Canvas::close() {
 
 /**
  * \brief Adds a Drawable to the Canvas.
- * \details Adds the parameter drawable to objectBuffer.
+ * \details Adds the parameter drawable to objectBuffer, from the start of the next frame.
+ * \details Each thread adds to a queue of its own, so threads adding Drawables at the same time never wait on each other.
  *    \param shapePtr Pointer to the Drawable to add to this Canvas.
  */
 void Canvas::add(Drawable * shapePtr) {
-  objectMutex.lock();
-  objectBuffer.push_back(shapePtr);
-  objectMutex.unlock();
+  shapePtr->setChangeSignal(changeSignal);
+  pendingObjects.push(shapePtr);
+  objectMutex.raise();
+}
+
+// Called with objectMutex locked, to bring objectBuffer up to date with every add()
+void Canvas::takePendingObjects() {
+  std::vector<Drawable*> * objects = &objectBuffer;
+  pendingObjects.drain([objects](Drawable * d) { objects->push_back(d); });
+}
+
+/**
+ * \brief Adds a Viewport to the Canvas.
+ * \details Creates a Viewport with its own Camera, Background and Drawables, which is drawn into the given
+ *    rectangle of the window after the Canvas' own scene and any Viewports added before it.
+ *    \param x The x coordinate in pixels of the left of the Viewport, from the left of the window.
+ *    \param y The y coordinate in pixels of the top of the Viewport, from the top of the window.
+ *    \param width The width of the Viewport in pixels.
+ *    \param height The height of the Viewport in pixels.
+ *    \param color The clear color of the Viewport's Background (optional, WHITE by default).
+ * \return A pointer to the new Viewport, which the Canvas deletes when it is deleted.
+ */
+Viewport * Canvas::addViewport(GLint x, GLint y, GLint width, GLint height, ColorFloat color) {
+  Viewport * v = new Viewport(x, y, width, height, nullptr, color, changeSignal);
+  viewportMutex.lock();
+  viewports.push_back(v);
+  viewportMutex.unlock();
+  return v;
+}
+
+/**
+ * \brief Adds a Viewport with a given Background to the Canvas.
+ * \details As addViewport(GLint, GLint, GLint, GLint, ColorFloat), but the Viewport draws <code>background</code>, which
+ *    should be the same size as the Viewport. If it is a CartesianBackground, the Viewport's Camera looks at its Cartesian
+ *    bounds, and the Viewport's Drawables are placed in its Cartesian coordinates.
+ *    \param x The x coordinate in pixels of the left of the Viewport, from the left of the window.
+ *    \param y The y coordinate in pixels of the top of the Viewport, from the top of the window.
+ *    \param width The width of the Viewport in pixels.
+ *    \param height The height of the Viewport in pixels.
+ *    \param background The Background to draw behind the Viewport's Drawables. It is not deleted with the Viewport.
+ * \return A pointer to the new Viewport, which the Canvas deletes when it is deleted.
+ */
+Viewport * Canvas::addViewport(GLint x, GLint y, GLint width, GLint height, Background * background) {
+  Viewport * v = new Viewport(x, y, width, height, background, background->getClearColor(), changeSignal);
+  viewportMutex.lock();
+  viewports.push_back(v);
+  viewportMutex.unlock();
+  return v;
+}
+
+/**
+ * \brief Divides the Canvas' window into a grid of Viewports.
+ * \details Adds <code>rows</code> times <code>columns</code> Viewports of equal size that together cover the window.
+ *    \param rows The number of rows of Viewports.
+ *    \param columns The number of columns of Viewports.
+ *    \param color The clear color of the Viewports' Backgrounds (optional, WHITE by default).
+ * \return Pointers to the new Viewports, row by row from the top left.
+ */
+std::vector<Viewport*> Canvas::addViewportGrid(int rows, int columns, ColorFloat color) {
+  std::vector<Viewport*> grid;
+  if (rows <= 0 || columns <= 0) {
+    TsglDebug("A Viewport grid must have at least one row and one column.");
+    return grid;
+  }
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < columns; c++) {
+      GLint x = winWidth * c / columns, y = winHeight * r / rows;
+      grid.push_back(addViewport(x, y, winWidth * (c + 1) / columns - x, winHeight * (r + 1) / rows - y, color));
+    }
+  }
+  return grid;
 }
 
 /**
@@ -216,8 +387,10 @@ void Canvas::add(Drawable * shapePtr) {
  */
 void Canvas::remove(Drawable * shapePtr) {
   objectMutex.lock();
+  takePendingObjects();
   objectBuffer.erase(std::remove(objectBuffer.begin(), objectBuffer.end(), shapePtr), objectBuffer.end());
   objectMutex.unlock();
+  shapePtr->setChangeSignal(nullptr);
 }
 
 /**
@@ -229,15 +402,20 @@ void Canvas::remove(Drawable * shapePtr) {
  * \warning Setting shouldFreeMemory to false will leak memory from any objects created in Canvas draw methods.
  */
 void Canvas::clearObjectBuffer(bool shouldFreeMemory) {
+  objectMutex.lock();
+  takePendingObjects();
   if( shouldFreeMemory ) {
     for(unsigned i = 0; i < objectBuffer.size(); i++) {
       delete objectBuffer[i]; //TODO fix this, causes to crash
     }
   }
   objectBuffer.clear();
+  objectMutex.unlock();
+  changeSignal->notify();
 }
 
-void Canvas::draw()
+// Called by the rendering thread before the first frame
+void Canvas::beginDrawing()
 {
     windowMutex.lock();
     glfwMakeContextCurrent(window);
@@ -246,100 +424,198 @@ void Canvas::draw()
     glfwMakeContextCurrent(NULL);
     windowMutex.unlock();
 
+    frameCounter = 0;
+    swapInterval = -1;
+    ChangeSignal::onRenderingThread = true;     // Reading what we draw doesn't change it
+}
+
+// Called by the rendering thread to draw and present one frame, once it is time to and beginFrame() or
+// tryBeginFrame() has begun it
+void Canvas::drawFrame(FramePacing pacing, bool pollEvents)
+{
+    // this if, and the capturescreen variable, are necessary for screenshots to be 100% correct.
     bool captureScreen = false;
+    if (toRecord > 0) {
+      captureScreen = true;
+      --toRecord;
+    }
+    double frameStart = drawTimer->getTime();
 
-    for (frameCounter = 0; !glfwWindowShouldClose(window); frameCounter++)
-    {
-        // this if, and the capturescreen variable, are necessary for screenshots to be 100% correct.
-        if (toRecord > 0) {
-          captureScreen = true;
-          --toRecord;
-        }
-        drawTimer->sleep(true);
+  #ifdef __APPLE__
+    windowMutex.lock();
+  #endif
+    glfwMakeContextCurrent(window);
+    if (swapInterval != (pacing == PACE_VSYNC)) {
+      swapInterval = (pacing == PACE_VSYNC);
+      glfwSwapInterval(swapInterval);
+    }
 
-        syncMutex.lock();
+    realFPS = round(1 / drawTimer->getTimeBetweenSleeps());
+    if (showFPS) std::cout << realFPS << "/" << FPS << std::endl;
+    std::cout.flush();
 
-      #ifdef __APPLE__
-        windowMutex.lock();
-      #endif
-        glfwMakeContextCurrent(window);
+    // delete textures of released Images and upload any that asked to be prepared
+    TextureCache::update();
 
-        realFPS = round(1 / drawTimer->getTimeBetweenSleeps());
-        if (showFPS) std::cout << realFPS << "/" << FPS << std::endl;
-        std::cout.flush();
+    // clear default framebuffer
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // clear default framebuffer
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // if background initialized draw it using its multisampled framebuffer
+    backgroundMutex.lock();
+    if (myBackground)
+      if (myBackground->isInitialized()) {
+        myBackground->draw();
+      }
+    backgroundMutex.unlock();
 
-        // if background initialized draw it using its multisampled framebuffer
-        backgroundMutex.lock();
-        if (myBackground)
-          if (myBackground->isInitialized()) {
-            myBackground->draw();
-          }
-        backgroundMutex.unlock();
-
-        // Scale to window size
-        glViewport(0, 0, framebufferWidth, framebufferHeight);
-        // winWidth = windowWidth;
-        // winHeight = windowHeight;
-
-        objectMutex.lock();
-        if (objectBuffer.size() > 0) {
-          // sort between opaques and transparents and then sort by center z. depth buffer takes care of the rest. not perfect, but good.
-          std::stable_sort(objectBuffer.begin(), objectBuffer.end(), [this](Drawable * a, Drawable * b)->bool {
-            if (a->getAlpha() == 1.0 && b->getAlpha() != 1.0)
-              return true;
-            else if (a->getAlpha() != 1.0 && b->getAlpha() == 1.0)
-              return false;
-            else
-              return (distanceBetween(a->getCenterX(), a->getCenterY(), a->getCenterZ(), camera->getPositionX(), camera->getPositionY(), camera->getPositionZ())
-                    > distanceBetween(b->getCenterX(), b->getCenterY(), b->getCenterZ(), camera->getPositionX(), camera->getPositionY(), camera->getPositionZ()));
-          });
-          for (unsigned int i = 0; i < objectBuffer.size(); i++) {
-            Drawable* d = objectBuffer[i];
-            if(d->isProcessed()) {
-              selectShaders(d->getShaderType());
-              if (d->getShaderType() == SHAPE_SHADER_TYPE) {
-                d->draw(shapeShader);
-              } else if (d->getShaderType() == TEXTURE_SHADER_TYPE) {
-                d->draw(textureShader);
-              } else if (d->getShaderType() == TEXT_SHADER_TYPE) {
-                d->draw(textShader);
-              }
-            }
+    // Scale to window size
+    glViewport(0, 0, framebufferWidth, framebufferHeight);
+    // winWidth = windowWidth;
+    // winHeight = windowHeight;
+
+    objectMutex.lock();
+    takePendingObjects();
+    drawObjects(objectBuffer, camera);
+    objectMutex.unlock();
+
+    drawViewports();
+
+    if (captureScreen) {
+      // Update our screenBuffer copy with the default framebuffer
+      screenBufferMutex.lock();
+      glViewport(0,0,framebufferWidth,framebufferHeight);
+      glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+      glPixelStorei(GL_PACK_ALIGNMENT, 1);
+      glReadPixels(0, 0, framebufferWidth, framebufferHeight, GL_RGB, GL_UNSIGNED_BYTE, screenBuffer);
+      screenBufferMutex.unlock();
+      screenShot();
+      captureScreen = false;
+    }
+
+    // Every Drawable has been drawn, so updates may go ahead while we wait on the swap
+    endFrame();
+
+    // Update Screen
+    glfwSwapBuffers(window);
+    if (pacing == PACE_ADAPTIVE)
+      adaptFrameRate(drawTimer->getTime() - frameStart);
+    syncMutex.lock();
+    ++presentedFrames;
+    syncMutex.unlock();
+    syncCondition.notify_all();
+
+  #ifndef __APPLE__
+    if (pollEvents)
+      glfwPollEvents();                          // Handle any I/O
+  #endif
+    glfwGetCursorPos(window, &mouseX, &mouseY);
+    glfwMakeContextCurrent(NULL);                // We're drawing to window as soon as it's created
+  #ifdef __APPLE__
+    windowMutex.unlock();
+  #endif
+
+    if (toClose) glfwSetWindowShouldClose(window, GL_TRUE);
+    ++frameCounter;
+}
+
+// Called by the rendering thread once the window has closed
+void Canvas::endDrawing()
+{
+    // Wake anyone waiting for a frame that will never come
+    syncMutex.lock();
+    isFinished = true;
+    frameWaiting = false;   // Nor keep updates waiting for it
+    syncMutex.unlock();
+    syncCondition.notify_all();
+}
+
+// Called by the rendering thread to sort and draw Drawables, with the shaders set up for cam
+void Canvas::drawObjects(std::vector<Drawable*>& objects, Camera * cam)
+{
+    if (objects.size() > 0) {
+      // sort between opaques and transparents and then sort by center z. depth buffer takes care of the rest. not perfect, but good.
+      std::stable_sort(objects.begin(), objects.end(), [cam](Drawable * a, Drawable * b)->bool {
+        if (a->getAlpha() == 1.0 && b->getAlpha() != 1.0)
+          return true;
+        else if (a->getAlpha() != 1.0 && b->getAlpha() == 1.0)
+          return false;
+        else
+          return (distanceBetween(a->getCenterX(), a->getCenterY(), a->getCenterZ(), cam->getPositionX(), cam->getPositionY(), cam->getPositionZ())
+                > distanceBetween(b->getCenterX(), b->getCenterY(), b->getCenterZ(), cam->getPositionX(), cam->getPositionY(), cam->getPositionZ()));
+      });
+      for (unsigned int i = 0; i < objects.size(); i++) {
+        Drawable* d = objects[i];
+        if(d->isProcessed()) {
+          selectShaders(d->getShaderType());
+          if (d->getShaderType() == SHAPE_SHADER_TYPE) {
+            d->draw(shapeShader);
+          } else if (d->getShaderType() == TEXTURE_SHADER_TYPE) {
+            d->draw(textureShader);
+          } else if (d->getShaderType() == TEXT_SHADER_TYPE) {
+            d->draw(textShader);
           }
         }
-        objectMutex.unlock();
-
-        if (captureScreen) {
-          // Update our screenBuffer copy with the default framebuffer
-          screenBufferMutex.lock();
-          glViewport(0,0,framebufferWidth,framebufferHeight);
-          glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-          glPixelStorei(GL_PACK_ALIGNMENT, 1);
-          glReadPixels(0, 0, framebufferWidth, framebufferHeight, GL_RGB, GL_UNSIGNED_BYTE, screenBuffer);
-          screenBufferMutex.unlock();
-          screenShot();
-          captureScreen = false;
-        }
+      }
+    }
+}
 
-        // Update Screen
-        glfwSwapBuffers(window);
+// Called by the rendering thread to draw each Viewport's Background and Drawables into its part of the window
+void Canvas::drawViewports()
+{
+    viewportMutex.lock();
+    for (unsigned int i = 0; i < viewports.size(); i++) {
+      Viewport * v = viewports[i];
+      // Viewports are placed in window pixels from the top left, GL in framebuffer pixels from the bottom left
+      GLint x = v->myX * framebufferWidth / winWidth;
+      GLint y = (winHeight - v->myY - v->myHeight) * framebufferHeight / winHeight;
+      GLint w = v->myWidth * framebufferWidth / winWidth;
+      GLint h = v->myHeight * framebufferHeight / winHeight;
+
+      if (!v->myBackground->isInitialized()) {
+        v->myBackground->init(shapeShader, textShader, textureShader, v->myCamera, window);
+        glfwMakeContextCurrent(window);     // Background::init() releases the context
+      }
+      v->myBackground->setViewport(x, y, w, h);
+      v->myBackground->draw();
+
+      // Keep the Viewport's Drawables inside it, in front of whatever was drawn there before
+      glViewport(x, y, w, h);
+      glEnable(GL_SCISSOR_TEST);
+      glScissor(x, y, w, h);
+      glClear(GL_DEPTH_BUFFER_BIT);
+      drawingViewport = v;
+      v->objectMutex.lock();
+      v->takePendingObjects();
+      drawObjects(v->objectBuffer, v->myCamera);
+      v->objectMutex.unlock();
+      drawingViewport = nullptr;
+      glDisable(GL_SCISSOR_TEST);
+    }
+    glViewport(0, 0, framebufferWidth, framebufferHeight);
+    viewportMutex.unlock();
+}
 
-      #ifndef __APPLE__
-        glfwPollEvents();                            // Handle any I/O
-      #endif
-        glfwGetCursorPos(window, &mouseX, &mouseY);
-        glfwMakeContextCurrent(NULL);                // We're drawing to window as soon as it's created
-      #ifdef __APPLE__
-        windowMutex.unlock();
-      #endif
+void Canvas::draw()
+{
+    beginDrawing();
 
+    while (!glfwWindowShouldClose(window))
+    {
+        syncMutex.lock();
+        FramePacing pacing = framePacing;
+        double idlePeriod = 1.0 / minimumFPS;
         syncMutex.unlock();
-
-        if (toClose) glfwSetWindowShouldClose(window, GL_TRUE);
+        if (pacing == PACE_ON_CHANGE)
+          waitForChange(idlePeriod);
+        if (pacing == PACE_FIXED || pacing == PACE_ADAPTIVE || pacing == PACE_ON_CHANGE)
+          drawTimer->sleep(true);
+        else
+          drawTimer->tick();
+        beginFrame();
+        drawFrame(pacing, true);
     }
+
+    endDrawing();
 }
 
 //  /*!
@@ -358,6 +634,34 @@ void Canvas::draw()
 //     drawText(ws, x, y, size, color, fontFileName, rotation);
 // }
 
+ /*!
+  * \brief Ends an update started with beginUpdate().
+  * \details Once every thread's updates have ended, the Canvas is woken to draw its next frame.
+  * \see beginUpdate()
+  */
+void Canvas::endUpdate() {
+    std::unique_lock<std::mutex> lock(syncMutex);
+    std::map<std::thread::id, int>::iterator it = updateDepths.find(std::this_thread::get_id());
+    if (it == updateDepths.end()) {
+      TsglDebug("endUpdate() called without a matching beginUpdate().");
+      return;
+    }
+    if (--it->second == 0)
+      updateDepths.erase(it);
+    if (--updatesInProgress == 0) {
+      lock.unlock();
+      syncCondition.notify_all();
+    }
+}
+
+// Called by the rendering thread once every Drawable has been drawn: lets updates start again.
+void Canvas::endFrame() {
+    syncMutex.lock();
+    frameInProgress = false;
+    syncMutex.unlock();
+    syncCondition.notify_all();
+}
+
 void Canvas::errorCallback(int error, const char* string) {
     fprintf(stderr, "%i: %s\n", error, string);
 }
@@ -405,6 +709,28 @@ int Canvas::getFrameNumber() {
     return frameCounter;
 }
 
+ /*!
+  * \brief Accessor for how the Canvas schedules its frames.
+  * \return The Canvas' FramePacing.
+  * \see setFramePacing()
+  */
+FramePacing Canvas::getFramePacing() {
+    std::lock_guard<std::mutex> lock(syncMutex);
+    return framePacing;
+}
+
+ /*!
+  * \brief Accessor for the number of frames shown.
+  * \details Unlike getFrameNumber(), this counts frames once they have been swapped to the screen,
+  *   and never decreases.
+  * \return The number of frames the Canvas has presented so far.
+  * \see waitForFrame()
+  */
+unsigned long Canvas::getPresentedFrameCount() {
+    std::lock_guard<std::mutex> lock(syncMutex);
+    return presentedFrames;
+}
+
  /*!
   * \brief Accessor for the current FPS.
   * \return The average number of frames being rendered per second.
@@ -502,11 +828,16 @@ int Canvas::getWindowY() {
 
 void Canvas::glDestroy() {
     // Free up our resources
-    delete textShader;
-    delete shapeShader;
-    delete textureShader;
+    if (!usesRenderService) {   // Otherwise the shaders are shared, and the RenderService deletes them
+      delete textShader;
+      delete shapeShader;
+      delete textureShader;
+    }
     glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
     glDeleteVertexArrays(1, &VAO);
+    TextureCache::contextDestroyed(window);
+    GeometryCache::contextDestroyed(window);
 }
 
  /*!
@@ -530,8 +861,8 @@ void Canvas::handleIO() {
         windowClosed = true;
         while (!isFinished)
           sleepFor(0.1f);
+        glDestroy();                // Before the window goes, so no new window can reuse its address first
         glfwDestroyWindow(window);  //We have to do this on the main thread for OS X
-        glDestroy();
     }
   #endif
 }
@@ -551,8 +882,9 @@ void Canvas::init(int xx, int yy, int ww, int hh, std::string title, ColorFloat
     toClose = false;
     windowClosed = false;
     frameCounter = 0;
-    syncMutexLocked = 0;
-	  syncMutexOwner = -1;
+    updatesInProgress = 0;
+    frameWaiting = frameInProgress = false;
+    startedFrames = presentedFrames = 0;
 
     started = false;                  // We haven't started the window yet
     monitorX = xx;
@@ -560,14 +892,25 @@ void Canvas::init(int xx, int yy, int ww, int hh, std::string title, ColorFloat
     showFPS = false;                  // Set debugging FPS to false
     isFinished = false;               // We're not done rendering
     toRecord = 0;
+    swapInterval = -1;
+    usesRenderService = RenderService::isEnabled();
+    drawingViewport = nullptr;
 
     window = nullptr;
 
     defaultBackground = true;
     myBackground = nullptr;
 
-    drawTimer = new Timer((timerLength > 0.0f) ? timerLength : FRAME);
+    framePeriod = (timerLength > 0.0f) ? timerLength : FRAME;
+    framePacing = PACE_FIXED;
+    minimumFPS = 0.5f / framePeriod;
+    frameCost = 0;
+    drawTimer = new Timer(framePeriod);
+    changeSignal = new ChangeSignal();
+    objectMutex.setSignal(changeSignal);
+    viewportMutex.setSignal(changeSignal);
     camera = new Camera(glm::vec3(0.0f, 0.0f, (winHeight / 2) / tan(glm::pi<float>()/6)),glm::vec3(0.0f,1.0f,0.0f),glm::vec3(0.0f,0.0f,0.0f));
+    camera->setChangeSignal(changeSignal);
 
     for (int i = 0; i <= GLFW_KEY_LAST * 2 + 1; i++)
         boundKeys[i++] = nullptr;
@@ -639,14 +982,24 @@ void Canvas::initGlew() {
     // Create our Vertex Buffer Object
     glGenBuffers(1, &VBO);
 
+    // Create our Element Buffer Object, for Shapes drawn from indexed vertices
+    glGenBuffers(1, &EBO);
+
     glBindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
 
-    textShader = new Shader(textVertexShader, textFragmentShader);
+    // Canvases drawn by the RenderService share one context's shaders, which the first of them compiles
+    if (!usesRenderService || !RenderService::getShaders(textShader, shapeShader, textureShader)) {
+      textShader = new Shader(textVertexShader, textFragmentShader);
 
-    shapeShader = new Shader(shapeVertexShader, shapeFragmentShader);
+      shapeShader = new Shader(shapeVertexShader, shapeFragmentShader);
 
-    textureShader = new Shader(textureVertexShader, textureFragmentShader);
+      textureShader = new Shader(textureVertexShader, textureFragmentShader);
+
+      if (usesRenderService)
+        RenderService::setShaders(textShader, shapeShader, textureShader);
+    }
 
     // char buf[PATH_MAX]; /* PATH_MAX incudes the \0 so +1 is not required */
     // char *res = realpath(".", buf);
@@ -675,6 +1028,7 @@ void Canvas::initBackground(Background * background, ColorFloat bgcolor) {
       background->setClearColor(bgcolor);
     }
     myBackground->init(shapeShader, textShader, textureShader, camera, window);
+    myBackground->setChangeSignal(changeSignal);
     backgroundMutex.unlock();
 }
 
@@ -699,12 +1053,14 @@ void Canvas::initWindow() {
     glfwWindowHint(GLFW_SAMPLES,4);
 
     glfwMutex.lock();                                  // GLFW crashes if you try to make more than one window at once
-    window = glfwCreateWindow(winWidth, winHeight, winTitle.c_str(), NULL, NULL);  // Windowed
+    GLFWwindow * share = usesRenderService ? RenderService::getSharedContext() : NULL;
+    window = glfwCreateWindow(winWidth, winHeight, winTitle.c_str(), NULL, share);  // Windowed
  //   window = glfwCreateWindow(monInfo->width, monInfo->height, title_.c_str(), glfwGetPrimaryMonitor(), NULL);  // Fullscreen
     if (!window) {
         fprintf(stderr, "GLFW window creation failed. Was the library correctly initialized?\n");
         exit(100);
     }
+    TextureCache::contextCreated(window);
     glfwMutex.unlock();
 
     if (!monInfo) {
@@ -724,6 +1080,7 @@ void Canvas::initWindow() {
     glfwSetMouseButtonCallback(window, buttonCallback);
     glfwSetKeyCallback(window, keyCallback);
     glfwSetScrollCallback(window, scrollCallback);
+    glfwSetWindowRefreshCallback(window, refreshCallback);
 
     // Scale to window size
     GLint windowWidth, windowHeight;
@@ -760,26 +1117,11 @@ void Canvas::keyCallback(GLFWwindow* window, int key, int scancode, int action,
 
  /*!
   * \brief Pauses the rendering thread of the Canvas
-  * \details This function forces the calling thread to wait until the Canvas finishes its draw cycle,
-  *   them prevents the Canvas from rendering further updates until resumeDrawing is called.
-  * \note This method may be called from any number of threads, so long as a matching number of calls
-  *   to resumeDrawing() are made.
-  * \warning <b>This function makes use of a mutex lock. Do not call this without later calling
-  *   resumeDrawing().</b>
-  * \see resumeDrawing()
+  * \details This function is the same as beginUpdate().
+  * \see beginUpdate(), resumeDrawing()
   */
 void Canvas::pauseDrawing() {
-  #pragma omp critical (pauseResume)
-  {
-  if (syncMutexLocked == 0 && syncMutexOwner == -1) {
-    syncMutex.lock();
-    syncMutexOwner = omp_get_thread_num();
-  }
-  #pragma omp critical (syncMutLock)
-  {
-    ++syncMutexLocked;
-  }
-  }
+    beginUpdate();
 }
 
  /*!
@@ -808,30 +1150,11 @@ void Canvas::reset() {
 
  /*!
   * \brief Resumes the rendering thread of the Canvas
-  * \details This function should be called after pauseDrawing to let the Canvas' rendering thread
-  *   know that it may resume rendering.
-  * \note This method may be called from any number of threads, so long as a matching number of calls
-  *   to pauseDrawing() are made.
-  * \warning <b>This function makes use of a mutex lock. Do not call this without having
-  *   first called pauseDrawing().</b>
-  * \see pauseDrawing()
+  * \details This function is the same as endUpdate().
+  * \see endUpdate(), pauseDrawing()
   */
 void Canvas::resumeDrawing() {
-  #pragma omp critical (syncMutLock)
-  {
-    --syncMutexLocked;
-  }
-  #pragma omp critical (pauseResume)
-  {
-    if (syncMutexOwner == omp_get_thread_num()) {
-      while (syncMutexLocked > 0)
-        sleepFor(FRAME/2);
-      syncMutex.unlock();
-      syncMutexOwner = -1;
-    }
-  }
-  while (syncMutexOwner != -1)
-    sleepFor(FRAME/2);
+    endUpdate();
 }
 
  /*!
@@ -968,8 +1291,14 @@ void Canvas::screenShot() {
     screenBufferMutex.unlock();
 }
 
+void Canvas::refreshCallback(GLFWwindow* window) {
+    Canvas* can = reinterpret_cast<Canvas*>(glfwGetWindowUserPointer(window));
+    can->changeSignal->notify();
+}
+
 void Canvas::scrollCallback(GLFWwindow* window, double xpos, double ypos) {
     Canvas* can = reinterpret_cast<Canvas*>(glfwGetWindowUserPointer(window));
+    can->changeSignal->notify();
     if (can->scrollFunction) can->scrollFunction(xpos, ypos);
 }
 
@@ -983,7 +1312,10 @@ void Canvas::setBackground(Background * background, bool previouslySet) {
   backgroundMutex.lock();
   if (myBackground != background) {
     defaultBackground = false;
+    if (myBackground)
+      myBackground->setChangeSignal(nullptr);
     myBackground = background;
+    background->setChangeSignal(changeSignal);
     if (!previouslySet) {
       windowMutex.lock();
       background->init(shapeShader, textShader, textureShader, camera, window);
@@ -1011,6 +1343,35 @@ void Canvas::setBackgroundColor(ColorFloat color) {
     windowMutex.unlock();
 }
 
+ /*!
+  * \brief Changes how the Canvas schedules its frames.
+  * \details By default, a Canvas draws at a fixed rate (PACE_FIXED), given by the timer length it was
+  *   constructed with. Its rendering thread sleeps against an absolute deadline until each frame is due, then spins for the last
+  *   fraction of a millisecond, so frames start within microseconds of when they should.
+  * \details PACE_VSYNC instead draws once per refresh of the monitor, and PACE_UNCAPPED draws as often as it can.
+  * \details PACE_ADAPTIVE draws at the fixed rate while frames take less time than that allows, and otherwise
+  *   slows to a little below what they can sustain, down to <code>minFPS</code>. Threads calling sleep() follow
+  *   the lowered rate.
+  * \details PACE_ON_CHANGE draws at up to the fixed rate, but only once something drawn has changed: a Drawable
+  *   on the Canvas, the Background or the Camera is changed from another thread, a Drawable is added or removed,
+  *   an asynchronously loaded image finishes decoding, a key, button or scroll event arrives, or a thread calls
+  *   waitForFrame(). Otherwise the rendering thread
+  *   sleeps, waking only <code>minFPS</code> times a second to check for input, so an unchanging Canvas takes
+  *   almost no CPU time.
+  *   \param pacing The new FramePacing.
+  *   \param minFPS The lowest rate PACE_ADAPTIVE may drop to, or the rate PACE_ON_CHANGE checks for input at,
+  *     in frames per second (optional). 0, the default, is half the fixed rate.
+  * \note Canvas::sleep() continues to follow the Canvas' fixed rate in PACE_VSYNC and PACE_UNCAPPED.
+  */
+void Canvas::setFramePacing(FramePacing pacing, float minFPS) {
+    std::lock_guard<std::mutex> lock(syncMutex);
+    framePacing = pacing;
+    minimumFPS = (minFPS > 0) ? std::min(minFPS, (float) (1 / framePeriod)) : 0.5f / framePeriod;
+    frameCost = 0;
+    if (pacing != PACE_ADAPTIVE)
+      drawTimer->setPeriod(framePeriod);
+}
+
  /*!
   * \brief Mutator for showing the FPS.
   *   \param b Whether to print the FPS to stdout every draw cycle (for debugging purposes).
@@ -1055,6 +1416,10 @@ void Canvas::sleepFor(float seconds) {
 int Canvas::start() {
     if (started) return -1;
     started = true;
+    if (usesRenderService) {
+      RenderService::add(this);  // The RenderService's thread draws us instead of one of our own
+      return 0;
+    }
   #ifdef __APPLE__
     pthread_create(&renderThread,NULL,startDrawing,(void*)this);
   #else
@@ -1067,15 +1432,13 @@ int Canvas::start() {
 void* Canvas::startDrawing(void* cPtr) {
     Canvas* c = (Canvas*)cPtr;
     c->draw();
-    c->isFinished = true;
     pthread_exit(NULL);
 }
 #else
 void Canvas::startDrawing(Canvas *c) {
     c->draw();
-    c->isFinished = true;
-    glfwDestroyWindow(c->window);
     c->glDestroy();
+    glfwDestroyWindow(c->window);
 }
 #endif
 
@@ -1125,7 +1488,10 @@ void Canvas::selectShaders(unsigned int sType) {
         glVertexAttribPointer(texAttrib, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
         program->use();
         GLint aspectLoc = glGetUniformLocation(textShader->ID, "aspect");
-        glUniformMatrix4fv(aspectLoc, 1, GL_FALSE, glm::value_ptr(glm::mat4(1.0f)));
+        glm::mat4 aspect = glm::mat4(1.0f);
+        if (drawingViewport)  // Undo the stretch of a Viewport whose world isn't shaped like it
+          aspect = glm::scale(aspect, glm::vec3(drawingViewport->myAspect / ((float) drawingViewport->myWidth / drawingViewport->myHeight), 1.0f, 1.0f));
+        glUniformMatrix4fv(aspectLoc, 1, GL_FALSE, glm::value_ptr(aspect));
     } else if (sType == SHAPE_SHADER_TYPE)  {
         program = shapeShader;
         // position attribute
@@ -1154,13 +1520,19 @@ void Canvas::selectShaders(unsigned int sType) {
     uniView = glGetUniformLocation(program->ID, "view");
     uniProj = glGetUniformLocation(program->ID, "projection");
 
-    glm::mat4 projection = glm::perspective(glm::radians(60.0f), (float)winWidth/(float)winHeight, 0.1f, 5000.0f);
-    glm::mat4 view = camera->getViewMatrix();
+    // Drawables in a Viewport are seen through its Camera, at its aspect ratio
+    float aspect = drawingViewport ? drawingViewport->myAspect : (float)winWidth/(float)winHeight;
+    Camera * cam = drawingViewport ? drawingViewport->myCamera : camera;
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), aspect, 0.1f, 5000.0f);
+    glm::mat4 view = cam->getViewMatrix();
     glm::mat4 model = glm::mat4(1.0f);
 
     glUniformMatrix4fv(uniProj, 1, GL_FALSE, glm::value_ptr(projection));
     glUniformMatrix4fv(uniView, 1, GL_FALSE, &view[0][0]);
     glUniformMatrix4fv(uniModel, 1, GL_FALSE, glm::value_ptr(model));
+    program->projection = projection;
+    program->view = view;
+    program->viewportHeight = drawingViewport ? drawingViewport->myHeight : winHeight;
 }
 
  /*!
@@ -1172,6 +1544,11 @@ void Canvas::selectShaders(unsigned int sType) {
   */
 int Canvas::wait() {
   if (!started) return -1;  // If we haven't even started yet, return error code -1
+  if (usesRenderService) {
+    std::unique_lock<std::mutex> lock(syncMutex);
+    syncCondition.wait(lock, [this]() { return isFinished; });
+    return 0;
+  }
   #ifdef __APPLE__
     while(!isFinished)
       sleepFor(0.1f);
@@ -1182,4 +1559,69 @@ int Canvas::wait() {
 
   return 0;
 }
+ /*!
+  * \brief Waits for the Canvas to present a given frame.
+  * \details This function blocks the calling thread until getPresentedFrameCount() reaches <code>frame</code>,
+  *   the timeout expires, or the Canvas closes.
+  *   \param frame The number of presented frames to wait for.
+  *   \param timeout The most seconds to wait (optional). A negative timeout, the default, waits indefinitely.
+  * \return Whether the frame was presented.
+  * \warning <b>Do not call this between beginUpdate() and endUpdate(), as the Canvas cannot draw
+  *   until the update ends.</b>
+  * \note Called from a rendering thread, e.g. from a key or mouse handler, this returns false at once,
+  *   since that thread cannot present a frame while it waits for one.
+  * \see waitForNextFrame()
+  */
+bool Canvas::waitForFrame(unsigned long frame, float timeout) {
+    if (ChangeSignal::onRenderingThread) {
+      TsglErr("Cannot wait for a frame on a rendering thread.");
+      return false;
+    }
+  #ifdef __APPLE__
+    handleIO();
+  #endif
+    std::unique_lock<std::mutex> lock(syncMutex);
+    if (updateDepths.count(std::this_thread::get_id())) {
+      TsglErr("Cannot wait for a frame during an update.");
+      return false;
+    }
+    if (presentedFrames < frame)
+      changeSignal->notify();     // Draw the frame even if nothing has changed
+    std::function<bool()> ready = [this, frame]() { return presentedFrames >= frame || isFinished; };
+    if (timeout < 0)
+      syncCondition.wait(lock, ready);
+    else
+      syncCondition.wait_for(lock, std::chrono::nanoseconds((long long) (timeout * 1000000000)), ready);
+    return presentedFrames >= frame;
+}
+
+ /*!
+  * \brief Waits for the Canvas to present a frame showing every change made so far.
+  * \details This function blocks the calling thread until the Canvas has presented the first frame it
+  *   begins drawing after this call, the timeout expires, or the Canvas closes. Calling this once per step of a
+  *   simulation runs exactly one step per frame shown.
+  *   \param timeout The most seconds to wait (optional). A negative timeout, the default, waits indefinitely.
+  * \return Whether the frame was presented.
+  * \warning <b>Do not call this between beginUpdate() and endUpdate(), as the Canvas cannot draw
+  *   until the update ends.</b>
+  * \see waitForFrame()
+  */
+bool Canvas::waitForNextFrame(float timeout) {
+    syncMutex.lock();
+    unsigned long frame = startedFrames + 1;
+    syncMutex.unlock();
+    return waitForFrame(frame, timeout);
+}
+
+// Called by the rendering thread in PACE_ON_CHANGE: waits until something drawn changes, handling input every
+// <code>seconds</code> seconds in the meantime, since input can change what is drawn too.
+void Canvas::waitForChange(double seconds) {
+    while (!changeSignal->wait(seconds) && !toClose && !glfwWindowShouldClose(window)) {
+      #ifndef __APPLE__
+        glfwPollEvents();
+      #endif
+        glfwGetCursorPos(window, &mouseX, &mouseY);
+    }
+}
+
 }
@@ -14,32 +14,43 @@
 #include "Arrow.h"	    // Our own array for drawing arrows
 #include "Background.h"     // Our own class for drawing a background
 #include "CartesianBackground.h" // Our own class for drawing a cartesian background
+#include "ChangeSignal.h"   // Our own signal for waking the Canvas when something drawn changes
 #include "Color.h"          // Our own interface for converting color types
 #include "Cone.h"           // Our own class for drawing cones
 #include "Cube.h"           // Our own class for drawing cubes
 #include "Cuboid.h"         // Our own class for drawing cuboids
 #include "Cylinder.h"       // Our own class for drawing cylinders
 #include "TriangleStrip.h" // Our own class for drawing polygons with colored vertices
+#include "DynamicTexture.h" // Our own class for drawing pixels streamed from memory
 #include "Ellipse.h"        // Our own class for drawing ellipses
 #include "Ellipsoid.h"      // Our own class for drawing ellipsoids
+#include "GeometryCache.h"  // Our own cache of unit meshes shared between 3D shapes
 #include "Circle.h" 	    // Our own class for drawing circles
 #include "ConcavePolygon.h" // Our own class for concave polygons with colored vertices
 #include "ConvexPolygon.h"  // Our own class for convex polygons with colored vertices
 #include "Image.h"          // Our own class for drawing images / textured quads
 #include "Keynums.h"        // Our enums for key presses
 #include "Line.h"           // Our own class for drawing straight lines
+#include "LineSet.h"        // Our own class for drawing many line segments at once
+#include "Mesh.h"           // Our own class for drawing triangle meshes, such as ones loaded from files
+#include "ParticleSystem.h" // Our own class for drawing and animating many particles at once
 #include "Polyline.h"       // Our own class for drawing polylines
 #include "ProgressBar.h"    // Our own class for drawing progress bars
 #include "Pyramid.h"        // Our own class for drawing pyramids
 #include "Rectangle.h"      // Our own class for drawing rectangles
 #include "RegularPolygon.h" // Our own class for drawing regular polygons
+#include "RenderService.h"  // Our own thread for drawing many Canvases at once
 #include "Sphere.h"         // Our own class for drawing spheres
+#include "SpriteSheet.h"    // Our own class for drawing batches of sprites from one texture
 #include "Square.h"         // Our own class for drawing squares
 #include "Star.h"           // Our own class for drawing stars
+#include "StreamingPolyline.h" // Our own class for drawing polylines that grow one vertex at a time
 #include "Text.h"           // Our own class for drawing text
+#include "TextureCache.h"   // Our own cache of textures shared between Images
 #include "Timer.h"          // Our own timer for steady FPS
 #include "Triangle.h"       // Our own class for drawing triangles
 #include "Util.h"           // Needed constants and has cmath for performing math operations
+#include "Viewport.h"       // Our own class for drawing separate scenes into parts of the window
 
 #include "Camera.h"
 #include "Shader.h"
@@ -51,8 +62,10 @@
 #include <fstream>
 #include <sys/stat.h>
 
+#include <condition_variable> // For gating frames on updates in progress
 #include <functional>       // For callback upon key presses
 #include <iostream>         // DEBUGGING
+#include <map>              // For counting each thread's updates in progress
 #include <mutex>            // Needed for locking the Canvas for thread-safety
 #include <sstream>          // For string building
 #include <string>           // For window titles
@@ -60,9 +73,8 @@
 #include <omp.h>
 #ifdef __APPLE__
   #include <pthread.h>
-#else
-  #include <thread>           // For spawning rendering in a different thread
 #endif
+#include <thread>           // For spawning rendering in a different thread
 
 #include "gl_includes.h"
 
@@ -93,14 +105,19 @@ protected:
 
     // float           aspect;                                             // Aspect ratio used for setting up the window
     bool        atiCard;                                                // Whether the vendor of the graphics card is ATI
-    std::mutex      backgroundMutex;                                    // Mutex for myBackground
+    ChangeMutex     backgroundMutex;                                    // Mutex for myBackground
     voidFunction    boundKeys    [(GLFW_KEY_LAST+1)*2];                 // Array of function objects for key binding
     Camera*         camera;
+    ChangeSignal *  changeSignal;                                       // Raised when anything drawn changes
     bool            defaultBackground;                                  // Boolean indicating whether myBackground has been set by an external source
     Timer*          drawTimer;                                          // Timer to regulate drawing frequency
     GLint           framebufferWidth;
     GLint           framebufferHeight;
     int             frameCounter;                                       // Counter for the number of frames that have elapsed in the current session (for animations)
+    double          frameCost;                                          // Smoothed seconds the rendering thread spends on each frame
+    double          framePeriod;                                        // Seconds between frames at the Canvas' fixed rate
+    FramePacing     framePacing;                                        // How the rendering thread schedules frames
+    float           minimumFPS;                                         // Lowest rate PACE_ADAPTIVE may drop to
     bool            isFinished;                                         // If the rendering is done, which will signal the window to close
     bool            keyDown;
     std::string     capturePrefix = "Image";                                          // If a key is being pressed. Prevents an action from happening twice
@@ -108,7 +125,8 @@ protected:
     double          mouseX, mouseY;                                     // Location of the mouse once HandleIO() has been called
     Background *    myBackground;                                       // Pointer to the Background drawn each frame
     std::vector<Drawable*> objectBuffer;                                // Holds a list of pointers to objects drawn each frame
-    std::mutex	    objectMutex;
+    ChangeMutex     objectMutex;
+    SubmissionQueue<Drawable*> pendingObjects;                          // Drawables added since objectBuffer was last updated
     int             realFPS;                                            // Actual FPS of drawing
   #ifdef __APPLE__
     pthread_t     renderThread;                                         // Thread dedicated to rendering the Canvas
@@ -118,21 +136,32 @@ protected:
     uint8_t*        screenBuffer;                                       // Array that is a copy of the screen
     std::mutex      screenBufferMutex;                                  // mutex for the screenbuffer
     doubleFunction  scrollFunction;                                     // Single function object for scrolling
+    int             swapInterval;                                       // Swap interval last set on the window's context
     Shader *        textShader;                                         // Shader for Text class
     Shader *        shapeShader;                                        // Shader for Shape class
     Shader *        textureShader;                                      // Shader for Background and Image classes
     bool            showFPS;                                            // Flag to show DEBUGGING FPS
     bool            started;                                            // Whether our canvas is running and the frame counter is counting
-    std::mutex      syncMutex;                                          // Mutex for syncing the rendering thread with a computational thread
-    int             syncMutexLocked;                                    // Whether the syncMutex is currently locked
-	  int             syncMutexOwner;                                     // Thread ID of the owner of the syncMutex
+    std::mutex      syncMutex;                                          // Mutex for syncing the rendering thread with computational threads
+    std::condition_variable syncCondition;                              // Signaled when the last update ends or a frame finishes
+    int             updatesInProgress;                                  // Number of beginUpdate() calls not yet matched by endUpdate()
+    std::map<std::thread::id, int> updateDepths;                        // updatesInProgress, per thread
+    bool            frameWaiting;                                       // Whether the rendering thread is waiting for updates to end
+    bool            frameInProgress;                                    // Whether the rendering thread is drawing Drawables
+    unsigned long   startedFrames;                                      // Number of frames the rendering thread has begun drawing
+    unsigned long   presentedFrames;                                    // Number of frames the rendering thread has swapped to the screen
     bool            toClose;                                            // If the Canvas has been asked to close
     unsigned int    toRecord;                                           // To record the screen each frame
+    bool            usesRenderService;                                  // Whether the RenderService draws the Canvas instead of its own thread
+    std::vector<Viewport*> viewports;                                   // Scenes drawn into parts of the window after the Canvas' own
+    ChangeMutex     viewportMutex;                                      // Mutex for viewports
+    Viewport*       drawingViewport;                                    // Viewport being drawn by the rendering thread, if any
     GLint           uniModel,                                           // Model perspective of the camera
                     uniView,                                            // View perspective of the camera
                     uniProj;                                            // Projection of the camera
     GLuint          VAO,                                                // Address of GL's vertex array object
-                    VBO;                                                // Address of GL's vertex buffer object
+                    VBO,                                                // Address of GL's vertex buffer object
+                    EBO;                                                // Address of GL's element (index) buffer object
     GLFWwindow*     window;                                             // GLFW window that we will draw to
     bool            windowClosed;                                       // Whether we've closed the Canvas' window or not
     std::mutex      windowMutex;                                        // (OS X) Mutex for handling window contexts
@@ -148,6 +177,17 @@ protected:
     static void  buttonCallback(GLFWwindow* window, int key,
                    int action, int mods);                               // GLFW callback for mouse buttons
     void         draw();                                                // Draw loop for the Canvas
+    void         adaptFrameRate(double cost);                           // Adjusts the rate of PACE_ADAPTIVE to the cost of a frame
+    void         beginDrawing();                                        // Prepares the rendering thread to draw the Canvas
+    void         beginFrame();                                          // Waits for updates to end and keeps new ones from starting
+    bool         tryBeginFrame();                                       // beginFrame(), unless that would have to wait
+    void         drawFrame(FramePacing pacing, bool pollEvents);       // Draws and presents one frame, once it has begun
+    void         drawObjects(std::vector<Drawable*>& objects,
+                             Camera * cam);                             // Sorts and draws Drawables as seen through cam
+    void         drawViewports();                                       // Draws every Viewport over the Canvas' own scene
+    void         takePendingObjects();                                  // Moves pendingObjects into objectBuffer
+    void         endDrawing();                                          // Marks the Canvas finished once its window has closed
+    void         endFrame();                                            // Lets updates start again
     static void  errorCallback(int error, const char* string);          // Display where an error is coming from
     void         glDestroy();                                           // Destroys the GL and GLFW things that are specific for this canvas
     void         init(int xx,int yy,int ww,int hh,
@@ -162,16 +202,20 @@ protected:
     void         initWindow();                                          // Initalizes the window specific to the Canvas
     static void  keyCallback(GLFWwindow* window, int key,
                    int scancode, int action, int mods);                 // GLFW callback for keys
+    static void  refreshCallback(GLFWwindow* window);                   // GLFW callback for the window needing to be redrawn
     void         screenShot();                                          // Takes a screenshot
     static void  scrollCallback(GLFWwindow* window, double xpos,
                    double ypos);                                        // GLFW callback for scrolling
     static void  setDrawBuffer(int buffer);                             // Sets the buffer used for drawing
+    void         waitForChange(double seconds);                         // Waits for a change, handling input every so many seconds
   #ifdef __APPLE__
     static void* startDrawing(void* cPtr);
   #else
     static void  startDrawing(Canvas *c);                               // Static method that is called by the render thread
   #endif
     virtual void         selectShaders(unsigned int choice);            // Select appropriate shader for type of Drawable
+
+    friend class RenderService;                                         // Draws Canvases frame by frame from its own thread
 public:
 
     Canvas(double timerLength = 0.0f, Background * background = nullptr);
@@ -186,10 +230,22 @@ public:
 
     void add(Drawable * shapePtr);
 
+    Viewport * addViewport(GLint x, GLint y, GLint width, GLint height, ColorFloat color = WHITE);
+
+    Viewport * addViewport(GLint x, GLint y, GLint width, GLint height, Background * background);
+
+    std::vector<Viewport*> addViewportGrid(int rows, int columns, ColorFloat color = WHITE);
+
+    void batch(const voidFunction& changes);
+
+    void beginUpdate();
+
     void clearBackground();
 
     void close();
 
+    void endUpdate();
+
     void clearObjectBuffer(bool shouldFreeMemory = false);
 
     virtual Background * getBackground();
@@ -204,8 +260,12 @@ public:
 
     int getFrameNumber();
 
+    unsigned long getPresentedFrameCount();
+
     float getFPS();
 
+    FramePacing getFramePacing();
+
     virtual float getMouseX();
 
     virtual float getMouseY();
@@ -268,6 +328,8 @@ public:
 
     void setFont(std::string filename);
 
+    void setFramePacing(FramePacing pacing, float minFPS = 0);
+
     void setShowFPS(bool b);
 
     void sleep();
@@ -283,6 +345,10 @@ public:
     void takeScreenShot(const std::string& newCapturePrefix = "");
 
     int wait();
+
+    bool waitForFrame(unsigned long frame, float timeout = -1);
+
+    bool waitForNextFrame(float timeout = -1);
 };
 
 }
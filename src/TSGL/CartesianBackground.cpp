@@ -51,6 +51,7 @@ void CartesianBackground::draw() {
 
     if (toClear) {
         attribMutex.lock();
+        glClearColor(baseColor.R, baseColor.G, baseColor.B, baseColor.A);   // Other Backgrounds may share the context
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         toClear = false;
         attribMutex.unlock();
@@ -59,6 +60,7 @@ void CartesianBackground::draw() {
     glViewport(0,0,myWidth,myHeight);
 
     drawableMutex.lock();
+    takeSubmissions();
     for (unsigned int i = 0; i < myDrawables->size(); i++)
     {
         Drawable* d = (*myDrawables)[i];
@@ -119,7 +121,7 @@ void CartesianBackground::draw() {
     
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    glViewport(0,0,framebufferWidth,framebufferHeight);
+    applyViewport();
 
     glDisable(GL_DEPTH_TEST);
 
@@ -163,29 +165,33 @@ void CartesianBackground::draw() {
   *    \param spacingY The distance between marks on the y-axis.
   */
 void CartesianBackground::drawAxes(Decimal originX, Decimal originY, Decimal spacingX, Decimal spacingY) {
-    drawLine(myXMax, originY, 0, myXMin, originY, 0, 0,0,0, BLACK);  // Make the two axes
-    drawLine(originX, myYMax, 0, originX, myYMin, 0, 0,0,0, BLACK);
+    LineSet * axes = new LineSet(0,0,0, 0,0,0, BLACK);
+    axes->append(myXMax, originY, 0, myXMin, originY, 0);  // Make the two axes
+    axes->append(originX, myYMax, 0, originX, myYMin, 0);
 
     if (spacingX != 0.0) {
         if (spacingX < 0.0) spacingX = -spacingX;
 
         for (Decimal x_ = originX + spacingX; x_ < myXMax; x_ += spacingX) {
-            drawLine(x_, originY + 8 * pixelHeight, 0, x_, originY - 8 * pixelHeight, 0, 0,0,0, BLACK);
+            axes->append(x_, originY + 8 * pixelHeight, 0, x_, originY - 8 * pixelHeight, 0);
         }
         for (Decimal x_ = originX - spacingX; x_ > myXMin; x_ -= spacingX) {
-            drawLine(x_, originY + 8 * pixelHeight, 0, x_, originY - 8 * pixelHeight, 0, 0,0,0, BLACK);
+            axes->append(x_, originY + 8 * pixelHeight, 0, x_, originY - 8 * pixelHeight, 0);
         }
     }
     if (spacingY != 0.0) {
         if (spacingY < 0.0) spacingY = -spacingY;
 
         for (Decimal y_ = originY + spacingY; y_ < myYMax; y_ += spacingY) {
-            drawLine(originX + 8 * pixelWidth, y_, 0, originX - 8 * pixelWidth, y_, 0, 0,0,0, BLACK);
+            axes->append(originX + 8 * pixelWidth, y_, 0, originX - 8 * pixelWidth, y_, 0);
         }
         for (Decimal y_ = originY - spacingY; y_ > myYMin; y_ -= spacingY) {
-            drawLine(originX + 8 * pixelWidth, y_, 0, originX - 8 * pixelWidth, y_, 0, 0,0,0, BLACK);
+            axes->append(originX + 8 * pixelWidth, y_, 0, originX - 8 * pixelWidth, y_, 0);
         }
     }
+
+    // One LineSet holds every tick, instead of one Line per tick
+    submit(axes);
 }
 
  /*!
@@ -195,18 +201,15 @@ void CartesianBackground::drawAxes(Decimal originX, Decimal originY, Decimal spa
   *   \param color The color of the vertices of the plotted function (set to BLACK by default).
   */
 void CartesianBackground::drawFunction(const Function &function, ColorFloat color) {
-    int index = 0;
     int values = (int) ceil((myXMax - myXMin) / pixelWidth);
-    float vertices[values*3];
-    Decimal y;
-    for (Decimal x = myXMin; x < myXMax; x += pixelWidth) {
-        y = function.valueAt(x);
-        vertices[index] = x;
-        vertices[index+1] = y;
-        vertices[index+2] = 0; 
-        index += 3;
+    std::vector<float> vertices((size_t) values * 3);
+    for (int i = 0; i < values; i++) {
+        Decimal x = myXMin + i * pixelWidth;
+        vertices[i*3] = x;
+        vertices[i*3 + 1] = function.valueAt(x);
+        vertices[i*3 + 2] = 0;
     }
-    drawPolyline(0,0,0,values,vertices,0,0,0,color);
+    drawPolyline(0,0,0,values,vertices.data(),0,0,0,color);
 }
 
  /*!
@@ -232,18 +235,15 @@ void CartesianBackground::drawFunction(functionPointer &function, ColorFloat col
   * \note <code>function</code> must receive exactly one Decimal x parameter, and return a Decimal y parameter.
   */
 void CartesianBackground::drawPartialFunction(functionPointer &function, Decimal min, Decimal max, ColorFloat color) {
-    int index = 0;
     int values = (int) ceil((max - min) / pixelWidth);
-    float vertices[values*3];
-    Decimal y;
-    for (Decimal x = min; x < max; x += pixelWidth) {
-        y = (function)(x);
-        vertices[index] = x;
-        vertices[index+1] = y;
-        vertices[index+2] = 0; 
-        index += 3;
+    std::vector<float> vertices((size_t) values * 3);
+    for (int i = 0; i < values; i++) {
+        Decimal x = min + i * pixelWidth;
+        vertices[i*3] = x;
+        vertices[i*3 + 1] = (function)(x);
+        vertices[i*3 + 2] = 0;
     }
-    drawPolyline(0,0,0,values,vertices,0,0,0,color);
+    drawPolyline(0,0,0,values,vertices.data(),0,0,0,color);
 }
 
  /*!
@@ -273,7 +273,7 @@ ColorInt CartesianBackground::getPixel(float x, float y) {
     attribMutex.lock();
     float screenX = (x - myXMin - myCartWidth/2) * myWidth / myCartWidth;
     float screenY = (y - myYMin - myCartHeight/2) * myHeight / myCartHeight;
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return Background::getPixel(screenX, screenY);
 }
 
@@ -327,6 +327,9 @@ void CartesianBackground::selectShaders(unsigned int sType) {
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "view"), 1, GL_FALSE, &view[0][0]);
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    program->projection = projection;
+    program->view = view;
+    program->viewportHeight = myHeight;
 }
 
  /*!
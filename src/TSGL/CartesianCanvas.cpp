@@ -113,6 +113,10 @@ void CartesianCanvas::recomputeDimensions(Decimal xMin, Decimal yMin, Decimal xM
  *  \param sType Unsigned int with a corresponding value for each type of Shader.
  */
 void CartesianCanvas::selectShaders(unsigned int sType) {
+    if (drawingViewport) {  // Viewports have their own coordinates
+        Canvas::selectShaders(sType);
+        return;
+    }
     Shader * program = 0;
     if (sType == TEXT_SHADER_TYPE) {
         program = textShader;
@@ -159,6 +163,9 @@ void CartesianCanvas::selectShaders(unsigned int sType) {
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "view"), 1, GL_FALSE, &view[0][0]);
     glUniformMatrix4fv(glGetUniformLocation(program->ID, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    program->projection = projection;
+    program->view = view;
+    program->viewportHeight = winHeight;
 }
 
  /*!
@@ -0,0 +1,91 @@
+#include "ChangeSignal.h"
+
+#include <chrono>
+
+namespace tsgl {
+
+thread_local bool ChangeSignal::onRenderingThread = false;
+std::mutex ChangeSignal::signalsMutex;
+std::set<ChangeSignal*> ChangeSignal::signals;
+ChangeMutex::Waiters ChangeMutex::waiters[ChangeMutex::WAITER_SLOTS];
+
+/*!
+ * \brief Constructs a new, raised ChangeSignal.
+ * \details The ChangeSignal starts raised, so that whatever waits on it draws its first frame.
+ * \return A new ChangeSignal.
+ */
+ChangeSignal::ChangeSignal() : changed(true) {
+    std::lock_guard<std::mutex> lock(signalsMutex);
+    signals.insert(this);
+}
+
+/*!
+ * \brief Destroys the ChangeSignal.
+ */
+ChangeSignal::~ChangeSignal() {
+    std::lock_guard<std::mutex> lock(signalsMutex);
+    signals.erase(this);
+}
+
+/*!
+ * \brief Wakes the thread waiting on the ChangeSignal, if there is one, without raising it.
+ * \details This is for waking the thread for something other than a change, such as the Canvas closing.
+ */
+void ChangeSignal::wake() {
+    // Lock so that a thread between checking the flag and waiting cannot miss the notification
+    myMutex.lock();
+    myMutex.unlock();
+    myCondition.notify_all();
+}
+
+/*!
+ * \brief Waits for the ChangeSignal to be raised, then lowers it.
+ * \details This function returns as soon as the ChangeSignal is raised or wake() is called,
+ *   or after <code>seconds</code> seconds, whichever comes first.
+ *   \param seconds The most seconds to wait.
+ * \return Whether the ChangeSignal was raised.
+ */
+bool ChangeSignal::wait(double seconds) {
+    if (changed.exchange(false))
+        return true;
+    std::unique_lock<std::mutex> lock(myMutex);
+    if (!changed.load())
+        myCondition.wait_for(lock, std::chrono::nanoseconds((long long) (seconds * 1000000000)));
+    return changed.exchange(false);
+}
+
+/*!
+ * \brief Raises every ChangeSignal, waking every Canvas that is waiting for a change.
+ * \details For changes that may show up in any Canvas, such as an asynchronously loaded image becoming ready.
+ */
+void ChangeSignal::notifyAll() {
+    std::lock_guard<std::mutex> lock(signalsMutex);
+    for (std::set<ChangeSignal*>::iterator it = signals.begin(); it != signals.end(); ++it)
+        (*it)->notify();
+}
+
+// Called by lock() when the ChangeMutex is held: spins briefly, then waits to be woken by wakeWaiters()
+void ChangeMutex::lockContended() {
+    for (int i = 0; i < 64; i++) {
+        unsigned expected = UNLOCKED;
+        if (myState.load(std::memory_order_relaxed) == UNLOCKED
+          && myState.compare_exchange_weak(expected, LOCKED, std::memory_order_acquire))
+            return;
+    }
+    Waiters& w = myWaiters();
+    std::unique_lock<std::mutex> lock(w.mutex);
+    // Taking the ChangeMutex as CONTENDED makes its next unlock wake any other waiters too
+    while (myState.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED)
+        w.condition.wait(lock);
+}
+
+// Called by unlockUnchanged() when threads may be waiting: wakes every thread waiting on the same Waiters
+void ChangeMutex::wakeWaiters() {
+    Waiters& w = myWaiters();
+    // Lock so that a thread between marking the ChangeMutex CONTENDED and waiting cannot miss the notification
+    w.mutex.lock();
+    w.mutex.unlock();
+    w.condition.notify_all();
+}
+
+}
@@ -0,0 +1,125 @@
+/*
+ * ChangeSignal.h provides classes for waking a Canvas when anything it draws changes.
+ */
+
+#ifndef CHANGESIGNAL_H_
+#define CHANGESIGNAL_H_
+
+#include <atomic>               // For checking for changes without locking
+#include <condition_variable>   // For waiting for changes, and for ChangeMutexes that are locked
+#include <cstdint>              // For picking a ChangeMutex's waiters by its address
+#include <mutex>
+#include <set>                  // For raising every ChangeSignal at once
+
+namespace tsgl {
+
+/*! \class ChangeSignal
+ *  \brief A flag that is raised when something a Canvas draws changes.
+ *  \details Each Canvas has a ChangeSignal, which the Drawables, Background and Camera it draws raise
+ *   through their ChangeMutexes. A Canvas that only draws when something changes waits on it between frames.
+ *  \details Raising a ChangeSignal that is already raised takes a single atomic read.
+ *  \details Changes that aren't made through any one Canvas, such as an image finishing decoding on a worker
+ *   thread, raise every ChangeSignal at once with notifyAll().
+ */
+class ChangeSignal {
+ private:
+    std::atomic<bool> changed;
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+
+    static std::mutex signalsMutex;
+    static std::set<ChangeSignal*> signals;        // Every ChangeSignal in existence, for notifyAll()
+ public:
+    static thread_local bool onRenderingThread;    ///< Whether the calling thread draws a Canvas
+
+    ChangeSignal();
+
+    ~ChangeSignal();
+
+    /*! \brief Raises the ChangeSignal, waking the thread waiting on it if there is one. */
+    void notify() {
+        if (!changed.load(std::memory_order_relaxed) && !changed.exchange(true))
+            wake();
+    }
+
+    void wake();
+
+    bool wait(double seconds);
+
+    static void notifyAll();
+};
+
+/*! \class ChangeMutex
+ *  \brief A mutex that raises a ChangeSignal when it is unlocked.
+ *  \details Drawables, Backgrounds and Cameras guard their attributes with a ChangeMutex, so that changing
+ *   them from any thread wakes the Canvas that draws them. Unlocks from a Canvas' rendering thread, which
+ *   only reads the attributes, do not raise the signal, and neither do accessors, which end with unlockUnchanged().
+ *  \details Until it is given a ChangeSignal, a ChangeMutex is an ordinary mutex. The ChangeSignal belongs to
+ *   the Canvas, which takes it back from everything it draws when they are removed or the Canvas is deleted.
+ *  \details A ChangeMutex is a single word rather than a std::mutex, as every Drawable has one. Locking and unlocking
+ *   it when no other thread holds it takes one atomic operation each. Threads that find it locked wait on one of a
+ *   small, shared set of condition variables, picked by the ChangeMutex's address.
+ */
+class ChangeMutex {
+ private:
+    static const unsigned UNLOCKED = 0, LOCKED = 1, CONTENDED = 2;   // CONTENDED: locked, and threads may be waiting
+    static const unsigned WAITER_SLOTS = 64;
+
+    struct Waiters {
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    static Waiters waiters[WAITER_SLOTS];
+
+    std::atomic<unsigned> myState;
+    std::atomic<ChangeSignal*> mySignal;       // Atomic for raise(), which doesn't lock
+
+    void lockContended();
+
+    void wakeWaiters();
+
+    // Finds the condition variable that threads waiting for this ChangeMutex share with a few others
+    Waiters& myWaiters() { return waiters[(reinterpret_cast<uintptr_t>(this) / sizeof(void*)) % WAITER_SLOTS]; }
+ public:
+    ChangeMutex() : myState(UNLOCKED), mySignal(nullptr) {}
+
+    /*! \brief Locks the ChangeMutex, waiting until it is free. */
+    void lock() {
+        unsigned expected = UNLOCKED;
+        if (!myState.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire))
+            lockContended();
+    }
+
+    /*! \brief Unlocks the ChangeMutex, raising its ChangeSignal unless called from a rendering thread. */
+    void unlock() {
+        ChangeSignal * signal = mySignal.load(std::memory_order_relaxed);    // Only changed while locked
+        if (signal && !ChangeSignal::onRenderingThread)
+            signal->notify();
+        unlockUnchanged();
+    }
+
+    /*! \brief Unlocks the ChangeMutex without raising its ChangeSignal, after only reading what it guards. */
+    void unlockUnchanged() {
+        if (myState.exchange(UNLOCKED, std::memory_order_release) == CONTENDED)
+            wakeWaiters();
+    }
+
+    /*! \brief Raises the ChangeSignal without locking, unless called from a rendering thread. */
+    void raise() {
+        ChangeSignal * signal = mySignal.load(std::memory_order_acquire);
+        if (signal && !ChangeSignal::onRenderingThread)
+            signal->notify();
+    }
+
+    /*! \brief Sets the ChangeSignal to raise, or none if <code>signal</code> is null. */
+    void setSignal(ChangeSignal * signal) {
+        lock();
+        mySignal.store(signal, std::memory_order_release);
+        unlockUnchanged();
+    }
+};
+
+}
+
+#endif /* CHANGESIGNAL_H_ */
@@ -75,7 +75,9 @@ void Circle::setRadius(GLfloat radius) {
     }
     attribMutex.lock();
     myRadius = radius;
+    beginTransform();
     myXScale = myYScale = radius;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -90,8 +92,10 @@ void Circle::changeRadiusBy(GLfloat delta) {
     }
     attribMutex.lock();
     myRadius += delta;
+    beginTransform();
     myXScale += delta;
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -102,18 +106,12 @@ void Circle::changeRadiusBy(GLfloat delta) {
 void Circle::setColor(ColorFloat c[]) {
     attribMutex.lock();
     myAlpha = 0.0f;
-    vertices[3] = c[0].R;
-    vertices[4] = c[0].G;
-    vertices[5] = c[0].B;
-    vertices[6] = c[0].A;
+    setVertexColor(0, c[0]);
     myAlpha += c[0].A;
     int colorIndex;
     for (int i = 1; i < numberOfVertices; ++i) {
         colorIndex = (int) ((float) (i - 1) / verticesPerColor + 1);
-        vertices[i*7 + 3] = c[colorIndex].R;
-        vertices[i*7 + 4] = c[colorIndex].G;
-        vertices[i*7 + 5] = c[colorIndex].B;
-        vertices[i*7 + 6] = c[colorIndex].A;
+        setVertexColor(i, c[colorIndex]);
         myAlpha += c[colorIndex].A;
     }
     myAlpha /= numberOfVertices;
@@ -129,9 +127,9 @@ void Circle::setColor(ColorFloat c[]) {
 void Circle::getColors(std::vector<ColorFloat> &colorVec) { 
     attribMutex.lock();
     for (int i = 0; i < numberOfVertices; i+=verticesPerColor) {
-        colorVec.push_back(ColorFloat(vertices[i*7+3],vertices[i*7+4],vertices[i*7+5],vertices[i*7+6]));
+        colorVec.push_back(getVertexColor(i));
     }
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
 }
 
 }
\ No newline at end of file
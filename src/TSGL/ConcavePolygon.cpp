@@ -16,11 +16,11 @@ namespace tsgl {
   */
 ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float yaw, float pitch, float roll) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
     attribMutex.lock();
-    geometryType = GL_TRIANGLE_FAN;
+    geometryType = GL_TRIANGLES;
     outlineGeometryType = GL_LINE_LOOP;
     numberOfVertices = numberOfOutlineVertices = numVertices;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     myXScale = myYScale = myZScale = 1;
     attribMutex.unlock();   
 }
@@ -42,18 +42,19 @@ ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int
   */
 ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
     attribMutex.lock();
-    geometryType = GL_TRIANGLE_FAN;
+    geometryType = GL_TRIANGLES;
     numberOfVertices = numVertices;
-    vertices = new GLfloat[numberOfVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
     myXScale = myYScale = myZScale = 1;
     outlineGeometryType = GL_LINE_LOOP;
     numberOfOutlineVertices = numVertices;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     attribMutex.unlock(); 
-    for (int i = 0; i < numVertices; i++) {
-        addVertex(x[i] - centerX, y[i] - centerY, 0, color);
-        addOutlineVertex(x[i] - centerX, y[i] - centerY, 0, GRAY);
-    }
+    addVertices(x, y, nullptr, centerX, centerY, 0, color);
+    addOutlineVertices(x, y, nullptr, centerX, centerY, 0, GRAY);
+    attribMutex.lock();
+    triangulate();
+    attribMutex.unlock();
 }
 
  /*!
@@ -70,76 +71,138 @@ ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int
   *   \param roll The ConcavePolygon's roll in 3D space.
   *   \param color An array of ColorFloats, the ConcavePolygon's fill color.
   * \return A new ConcavePolygon with a buffer for storing the specified number of vertices.
-  * \warning Can sometimes incorrectly render; if this occurs, try shifting your last vertex to be your first vertex, or otherwise adjusting vertex order.
   */
 ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color[]) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
     attribMutex.lock();
-    geometryType = GL_TRIANGLE_FAN;
+    geometryType = GL_TRIANGLES;
     numberOfVertices = numVertices;
-    vertices = new GLfloat[numberOfVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
     myXScale = myYScale = myZScale = 1;
     outlineGeometryType = GL_LINE_LOOP;
     numberOfOutlineVertices = numVertices;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     attribMutex.unlock(); 
-    for (int i = 0; i < numVertices; i++) {
-        addVertex(x[i] - centerX, y[i] - centerY, 0, color[i]);
-        addOutlineVertex(x[i] - centerX, y[i] - centerY, 0, GRAY);
-    }
+    addVertices(x, y, nullptr, centerX, centerY, 0, WHITE, color);
+    addOutlineVertices(x, y, nullptr, centerX, centerY, 0, GRAY);
+    attribMutex.lock();
+    triangulate();
+    attribMutex.unlock();
 }
 
 /*!
- * \brief Draw the ConcavePolygon.
- * \details This function actually draws the ConcavePolygon to the Canvas.
- * \note This function overrides Drawable::draw()
- * \note This function does nothing if the vertex buffer is not yet full.
- * \note A message indicating that the ConcavePolygon cannot be drawn yet will be given
- *   if the above condition is met (vertex buffer = not full).
+ * \brief Adds another vertex to a ConcavePolygon.
+ * \details Calls Shape::addVertex(), then triangulates the polygon once its last vertex has been added.
+ *      \param x The x position of the vertex.
+ *      \param y The y position of the vertex.
+ *      \param z The z position of the vertex.
+ *      \param color The reference variable of the color of the vertex.
  */
-void ConcavePolygon::draw(Shader * shader) {
-    if (!init) {
-        TsglDebug("Vertex buffer is not full.");
+void ConcavePolygon::addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color) {
+    if (init) {
+        TsglDebug("Cannot add anymore vertices.");
         return;
     }
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(myXScale, myYScale, myZScale));
-
-    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-    if (isFilled) {
-        /* extra stencil buffer stuff, because it's concave */
-        glClearStencil(0);
-        glClear(GL_STENCIL_BUFFER);
-        glEnable(GL_STENCIL_TEST);
-        glDisable(GL_CULL_FACE);
-        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-        glStencilFunc(GL_NEVER, 0, 1);
-        glStencilOp(GL_INVERT, GL_INVERT, GL_INVERT);
-        /* end */
-
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * 7, vertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(geometryType, 0, numberOfVertices);
+    Shape::addVertex(x, y, z, color);
+    if (init) {
+        attribMutex.lock();
+        triangulate();
+        attribMutex.unlock();
+    }
+}
 
-        /* extra stencil buffer stuff, because it's concave */
-        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-        glStencilFunc(GL_EQUAL, 1, 1);
-        glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+ /*!
+  * \brief Moves, and optionally recolors, a range of the ConcavePolygon's vertices in place.
+  * \details Every vertex is written in one pass under a single lock, and the polygon is triangulated again afterwards.
+  *   \param first The index of the first vertex to change.
+  *   \param count The number of vertices to change.
+  *   \param x The new x coordinates of the vertices, in the same coordinates as given to the constructor.
+  *   \param y The new y coordinates of the vertices.
+  *   \param z The new z coordinates of the vertices (optional). By default they stay in the ConcavePolygon's plane.
+  *   \param colors The new colors of the vertices (optional). By default they are left alone.
+  */
+void ConcavePolygon::updateVertices(int first, int count, const GLfloat x[], const GLfloat y[], const GLfloat z[], const ColorFloat colors[]) {
+    attribMutex.lock();
+    if (writeVertices(first, count, x, y, z, colors))
+        triangulate();
+    attribMutex.unlock();
+}
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * 7, vertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(geometryType, 0, numberOfVertices);
+/*!
+ * \brief Splits the ConcavePolygon into triangles by ear clipping.
+ * \details The vertices are projected onto the plane they mostly lie in. A vertex whose two neighbors form a
+ *   triangle turning the same way as the polygon, with no other remaining vertex inside it, is an "ear": it is cut
+ *   off as a triangle and removed, until only one triangle remains. Runs in O(n^2) time for n vertices.
+ * \details If no ear can be found, as happens for self-intersecting polygons, the next vertex is cut off anyway,
+ *   so that the polygon is always completely triangulated.
+ * \note attribMutex must be held. Subclasses that move vertices after construction must call this afterwards.
+ */
+void ConcavePolygon::triangulate() {
+    int n = numberOfVertices;
+    int stride = floatsPerVertex(myFormat);
+    myTriangles.clear();
+    if (n < 3) return;
 
-        glDisable(GL_STENCIL_TEST);
+    // Newell's method gives the polygon's normal; drop its largest axis to get 2D coordinates
+    float nx = 0, ny = 0, nz = 0;
+    for (int i = 0; i < n; i++) {
+        const GLfloat * a = vertices + i * stride;
+        const GLfloat * b = vertices + ((i + 1) % n) * stride;
+        nx += (a[1] - b[1]) * (a[2] + b[2]);
+        ny += (a[2] - b[2]) * (a[0] + b[0]);
+        nz += (a[0] - b[0]) * (a[1] + b[1]);
     }
+    int u = 0, v = 1;
+    float normal = nz;
+    if (fabs(nx) > fabs(ny) && fabs(nx) > fabs(nz)) {
+        u = 1; v = 2; normal = nx;
+    } else if (fabs(ny) > fabs(nz)) {
+        u = 2; v = 0; normal = ny;
+    }
+    std::vector<float> px(n), py(n);
+    for (int i = 0; i < n; i++) {
+        px[i] = vertices[i * stride + u];
+        py[i] = vertices[i * stride + v];
+    }
+    float winding = (normal < 0) ? -1.0f : 1.0f;
 
-    if (isOutlined) {
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfOutlineVertices * 7, outlineVertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(outlineGeometryType, 0, numberOfOutlineVertices);
+    std::vector<int> remaining(n);
+    for (int i = 0; i < n; i++)
+        remaining[i] = i;
+    myTriangles.reserve((n - 2) * 3);
+    int i = 0, misses = 0;
+    while (remaining.size() > 3) {
+        int count = remaining.size();
+        int prev = remaining[(i + count - 1) % count], cur = remaining[i % count], next = remaining[(i + 1) % count];
+        float turn = ((px[cur] - px[prev]) * (py[next] - py[prev]) - (py[cur] - py[prev]) * (px[next] - px[prev])) * winding;
+        bool isEar = turn > 0;
+        for (int j = 0; isEar && j < count; j++) {
+            int p = remaining[j];
+            if (p == prev || p == cur || p == next)
+                continue;
+            float d1 = ((px[cur] - px[prev]) * (py[p] - py[prev]) - (py[cur] - py[prev]) * (px[p] - px[prev])) * winding;
+            float d2 = ((px[next] - px[cur]) * (py[p] - py[cur]) - (py[next] - py[cur]) * (px[p] - px[cur])) * winding;
+            float d3 = ((px[prev] - px[next]) * (py[p] - py[next]) - (py[prev] - py[next]) * (px[p] - px[next])) * winding;
+            if (d1 >= 0 && d2 >= 0 && d3 >= 0)
+                isEar = false;
+        }
+        if (isEar || misses >= count) {
+            myTriangles.push_back(prev);
+            myTriangles.push_back(cur);
+            myTriangles.push_back(next);
+            remaining.erase(remaining.begin() + (i % count));
+            misses = 0;
+        } else {
+            i++;
+            misses++;
+        }
+        i %= remaining.size();
     }
+    myTriangles.push_back(remaining[0]);
+    myTriangles.push_back(remaining[1]);
+    myTriangles.push_back(remaining[2]);
+
+    indices = myTriangles.data();
+    numberOfIndices = myTriangles.size();
 }
+
 }
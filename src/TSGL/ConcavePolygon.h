@@ -8,29 +8,38 @@
 #include "Shape.h"       // For extending our Shape object
 #include "TsglAssert.h"  // For unit testing purposes
 #include <queue>         // std::queue
+#include <vector>        // For the cached triangulation
 #include <iostream>      // DEBUGGING
 
 namespace tsgl {
 
 /*! \class ConcavePolygon
  *  \brief Draw an arbitrary Concave polygon with colored vertices.
- *  \details ConcavePolygon is a class for holding vertex data for a triangle strip with colored vertices.
- *  \details Vertices are drawn in triangle strip format, where the first three vertices make up the first triangle,
- *   the next vertex plus the previous two make up the second triangle, and so on.
- *  \details This method is optimized for long lists and offers a marked improvement over drawing individual Triangle instances.
+ *  \details ConcavePolygon is a class for holding vertex data for a simple polygon with colored vertices.
+ *  \details Vertices are given in order around the polygon's boundary, either clockwise or counterclockwise.
+ *   Once all of them have been added, the polygon is split into triangles by ear clipping, and the triangles are
+ *   drawn as indices into the vertices like any other Shape. The triangulation is only redone when the vertices move.
+ *  \note A self-intersecting polygon has no well-defined interior; it is still filled, but not necessarily by the
+ *   even-odd rule.
  *  \note The addVertex() method must be called the same number of times as specified in the constructor.
  *  \note Calling addVertex() after all vertices have been added will do nothing.
  *  \note Calling draw() before all vertices have been added will do nothing.
  */
 class ConcavePolygon : public Shape {
  protected:
+    std::vector<GLuint> myTriangles;     // Cached triangulation of the vertices, three indices per triangle
+
     ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float yaw, float pitch, float roll); 
+
+    virtual void addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color = WHITE);
+
+    void triangulate();
  public:
     ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color);
 
     ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color[]);
 
-    virtual void draw(Shader * shader);
+    virtual void updateVertices(int first, int count, const GLfloat x[], const GLfloat y[], const GLfloat z[] = nullptr, const ColorFloat colors[] = nullptr);
 };
 
 }
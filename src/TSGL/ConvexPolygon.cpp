@@ -19,8 +19,8 @@ ConvexPolygon::ConvexPolygon(float centerX, float centerY, float centerZ,  int n
     geometryType = GL_TRIANGLE_FAN;
     outlineGeometryType = GL_LINE_LOOP;
     numberOfVertices = numberOfOutlineVertices = numVertices;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     myXScale = myYScale = myZScale = 1;
     attribMutex.unlock();    
 }
@@ -45,14 +45,12 @@ ConvexPolygon::ConvexPolygon(float centerX, float centerY, float centerZ,  int n
     geometryType = GL_TRIANGLE_FAN;
     outlineGeometryType = GL_LINE_LOOP;
     numberOfVertices = numberOfOutlineVertices = numVertices;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     myXScale = myYScale = myZScale = 1;
     attribMutex.unlock();    
-    for (int i = 0; i < numVertices; i++) {
-        addVertex(x[i] - centerX, y[i] - centerY, 0, color);
-        addOutlineVertex(x[i] - centerX, y[i] - centerY, 0, GRAY);
-    }
+    addVertices(x, y, nullptr, centerX, centerY, 0, color);
+    addOutlineVertices(x, y, nullptr, centerX, centerY, 0, GRAY);
 }
 
  /*!
@@ -75,14 +73,28 @@ ConvexPolygon::ConvexPolygon(float centerX, float centerY, float centerZ,  int n
     geometryType = GL_TRIANGLE_FAN;
     outlineGeometryType = GL_LINE_LOOP;
     numberOfVertices = numberOfOutlineVertices = numVertices;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     myXScale = myYScale = myZScale = 1;
     attribMutex.unlock();    
-    for (int i = 0; i < numVertices; i++) {
-        addVertex(x[i] - centerX, y[i] - centerY, 0, color[i]);
-        addOutlineVertex(x[i] - centerX, y[i] - centerY, 0, GRAY);
-    }
+    addVertices(x, y, nullptr, centerX, centerY, 0, WHITE, color);
+    addOutlineVertices(x, y, nullptr, centerX, centerY, 0, GRAY);
+}
+
+ /*!
+  * \brief Moves, and optionally recolors, a range of the ConvexPolygon's vertices in place.
+  * \details Every vertex is written in one pass under a single lock.
+  *   \param first The index of the first vertex to change.
+  *   \param count The number of vertices to change.
+  *   \param x The new x coordinates of the vertices, in the same coordinates as given to the constructor.
+  *   \param y The new y coordinates of the vertices.
+  *   \param z The new z coordinates of the vertices (optional). By default they stay in the ConvexPolygon's plane.
+  *   \param colors The new colors of the vertices (optional). By default they are left alone.
+  */
+void ConvexPolygon::updateVertices(int first, int count, const GLfloat x[], const GLfloat y[], const GLfloat z[], const ColorFloat colors[]) {
+    attribMutex.lock();
+    writeVertices(first, count, x, y, z, colors);
+    attribMutex.unlock();
 }
 
 }
@@ -27,6 +27,8 @@ class ConvexPolygon : public Shape {
     ConvexPolygon(float centerX, float centerY, float centerZ, int numVertices, GLfloat x[], GLfloat y[], float yaw, float pitch, float roll, ColorFloat color);
 
     ConvexPolygon(float centerX, float centerY, float centerZ, int numVertices, GLfloat x[], GLfloat y[], float yaw, float pitch, float roll, ColorFloat color[]);
+
+    virtual void updateVertices(int first, int count, const GLfloat x[], const GLfloat y[], const GLfloat z[] = nullptr, const ColorFloat colors[] = nullptr);
 };
 
 }
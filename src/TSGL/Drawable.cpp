@@ -1,5 +1,7 @@
 #include "Drawable.h"
 
+#include <thread>       // For yielding to a writer that is changing the transform
+
 namespace tsgl {
 
 /*!
@@ -35,12 +37,12 @@ Drawable::Drawable(float x, float y, float z, float yaw, float pitch, float roll
  *          only if the old rotation point was at the Drawable's old center.
  */
 void Drawable::changeXBy(float deltaX) {
-    attribMutex.lock();
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointX += deltaX;
     }
     myCenterX += deltaX;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -50,12 +52,12 @@ void Drawable::changeXBy(float deltaX) {
  *          only if the old rotation point was at the Drawable's old center.
  */
 void Drawable::changeYBy(float deltaY) {
-    attribMutex.lock();
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointY += deltaY;
     }
     myCenterY += deltaY;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -65,12 +67,12 @@ void Drawable::changeYBy(float deltaY) {
  *          only if the old rotation point was at the Drawable's old center.
  */
 void Drawable::changeZBy(float deltaZ) {
-    attribMutex.lock();
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointZ += deltaZ;
     }
     myCenterZ += deltaZ;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -82,7 +84,7 @@ void Drawable::changeZBy(float deltaZ) {
  *          only if the old rotation point was at the Drawable's old center.
  */
 void Drawable::changeCenterBy(float deltaX, float deltaY, float deltaZ) {
-    attribMutex.lock();
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointX += deltaX;
         myRotationPointY += deltaY;
@@ -91,7 +93,7 @@ void Drawable::changeCenterBy(float deltaX, float deltaY, float deltaZ) {
     myCenterX += deltaX;
     myCenterY += deltaY;
     myCenterZ += deltaZ;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -101,12 +103,12 @@ void Drawable::changeCenterBy(float deltaX, float deltaY, float deltaZ) {
  *           if the old rotation point was at the Drawable's old center.
  */
 void Drawable::setCenterX(float x) {
-    attribMutex.lock();
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointX = x;
     }
     myCenterX = x;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -116,12 +118,12 @@ void Drawable::setCenterX(float x) {
  *           if the old rotation point was at the Drawable's old center.
  */
 void Drawable::setCenterY(float y) {
-    attribMutex.lock();
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointY = y;
     }
     myCenterY = y;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -131,12 +133,12 @@ void Drawable::setCenterY(float y) {
  *           if the old rotation point was at the Drawable's old center.
  */
 void Drawable::setCenterZ(float z) {
-    attribMutex.lock();
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointZ = z;
     }
     myCenterZ = z;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -148,7 +150,7 @@ void Drawable::setCenterZ(float z) {
  *           if the old rotation point was at the Drawable's old center.
  */
 void Drawable::setCenter(float x, float y, float z) {
-    attribMutex.lock();
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointX = x;
         myRotationPointY = y;
@@ -157,7 +159,7 @@ void Drawable::setCenter(float x, float y, float z) {
     myCenterX = x;
     myCenterY = y;
     myCenterZ = z;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -165,9 +167,9 @@ void Drawable::setCenter(float x, float y, float z) {
  * \param yaw The new yaw value for Drawable.
  */
 void Drawable::setYaw(float yaw) {
-    attribMutex.lock();
+    beginTransform();
     myCurrentYaw = yaw;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -175,9 +177,9 @@ void Drawable::setYaw(float yaw) {
  * \param pitch The new pitch value for Drawable.
  */
 void Drawable::setPitch(float pitch) {
-    attribMutex.lock();
+    beginTransform();
     myCurrentPitch = pitch;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -185,9 +187,9 @@ void Drawable::setPitch(float pitch) {
  * \param roll The new roll value for Drawable.
  */
 void Drawable::setRoll(float roll) {
-    attribMutex.lock();
+    beginTransform();
     myCurrentRoll = roll;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /*!
@@ -197,11 +199,11 @@ void Drawable::setRoll(float roll) {
  * \param roll The new roll value for Drawable.
  */
 void Drawable::setYawPitchRoll(float yaw, float pitch, float roll) {
-    attribMutex.lock();
+    beginTransform();
     myCurrentYaw = yaw;
     myCurrentPitch = pitch;
     myCurrentRoll = roll;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -209,9 +211,9 @@ void Drawable::setYawPitchRoll(float yaw, float pitch, float roll) {
  * \param deltaYaw The change in yaw value for Drawable.
  */
 void Drawable::changeYawBy(float deltaYaw) {
-    attribMutex.lock();
+    beginTransform();
     myCurrentYaw += deltaYaw;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -219,9 +221,9 @@ void Drawable::changeYawBy(float deltaYaw) {
  * \param deltaPitch The change in pitch value for Drawable.
  */
 void Drawable::changePitchBy(float deltaPitch) {
-    attribMutex.lock();
+    beginTransform();
     myCurrentPitch += deltaPitch;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -229,9 +231,9 @@ void Drawable::changePitchBy(float deltaPitch) {
  * \param deltaRoll The change in roll value for Drawable.
  */
 void Drawable::changeRollBy(float deltaRoll) {
-    attribMutex.lock();
+    beginTransform();
     myCurrentRoll += deltaRoll;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -241,11 +243,11 @@ void Drawable::changeRollBy(float deltaRoll) {
  * \param deltaRoll The change in roll value for Drawable.
  */
 void Drawable::changeYawPitchRollBy(float deltaYaw, float deltaPitch, float deltaRoll) {
-    attribMutex.lock();
+    beginTransform();
     myCurrentYaw += deltaYaw;
     myCurrentPitch += deltaPitch;
     myCurrentRoll += deltaRoll;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /*!
@@ -254,9 +256,9 @@ void Drawable::changeYawPitchRollBy(float deltaYaw, float deltaPitch, float delt
  * \param z myRotationPointX's new float value.
  */
 void Drawable::setRotationPointX(float x) {
-    attribMutex.lock();
+    beginTransform();
     myRotationPointX = x;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /*!
@@ -265,9 +267,9 @@ void Drawable::setRotationPointX(float x) {
  * \param y myRotationPointY's new float value.
  */
 void Drawable::setRotationPointY(float y) {
-    attribMutex.lock();
+    beginTransform();
     myRotationPointY = y;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /*!
@@ -276,9 +278,9 @@ void Drawable::setRotationPointY(float y) {
  * \param z myRotationPointZ's new float value.
  */
 void Drawable::setRotationPointZ(float z) {
-    attribMutex.lock();
+    beginTransform();
     myRotationPointZ = z;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /**
@@ -288,11 +290,11 @@ void Drawable::setRotationPointZ(float z) {
  * \param z The z coordinate of the new rotation point.
  */
 void Drawable::setRotationPoint(float x, float y, float z) {
-    attribMutex.lock();
+    beginTransform();
     myRotationPointX = x;
     myRotationPointY = y;
     myRotationPointZ = z;
-    attribMutex.unlock();
+    endTransform();
 }
 
 /*!
@@ -302,22 +304,16 @@ void Drawable::setRotationPoint(float x, float y, float z) {
  * \note and http://planning.cs.uiuc.edu/node102.html for more more understanding.
  */
 float Drawable::getCenterX() {
-    attribMutex.lock();
-    float cx;
-    if (centerMatchesRotationPoint()) {
-        cx = myCenterX;
-        attribMutex.unlock();
-        return cx;
-    }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    cx = cosYaw * cosPitch * (myCenterX - myRotationPointX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myCenterY - myRotationPointY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myCenterZ - myRotationPointZ) + myRotationPointX;
-    attribMutex.unlock();
-    return cx;
+    Transform t = getTransform();
+    if (t.centerX == t.rotationX && t.centerY == t.rotationY && t.centerZ == t.rotationZ)
+        return t.centerX;
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    return cosYaw * cosPitch * (t.centerX - t.rotationX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (t.centerY - t.rotationY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (t.centerZ - t.rotationZ) + t.rotationX;
 }
 
 /*!
@@ -327,22 +323,16 @@ float Drawable::getCenterX() {
  * \note and http://planning.cs.uiuc.edu/node102.html for more more understanding.
  */
 float Drawable::getCenterY() {
-    attribMutex.lock();
-    float cy;
-    if (centerMatchesRotationPoint()) {
-        cy = myCenterY;
-        attribMutex.unlock();
-        return cy;
-    }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    cy = sinYaw * cosPitch * (myCenterX - myRotationPointX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myCenterY - myRotationPointY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myCenterZ - myRotationPointZ)  + myRotationPointY;
-    attribMutex.unlock();
-    return cy;
+    Transform t = getTransform();
+    if (t.centerX == t.rotationX && t.centerY == t.rotationY && t.centerZ == t.rotationZ)
+        return t.centerY;
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    return sinYaw * cosPitch * (t.centerX - t.rotationX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (t.centerY - t.rotationY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (t.centerZ - t.rotationZ)  + t.rotationY;
 }
 
 /*!
@@ -352,24 +342,144 @@ float Drawable::getCenterY() {
  * \note and http://planning.cs.uiuc.edu/node102.html for more more understanding.
  */
 float Drawable::getCenterZ() {
-    attribMutex.lock();
-    float cz;
-    if (centerMatchesRotationPoint()) {
-        cz = myCenterZ;
-        attribMutex.unlock();
-        return cz;
-    }
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    cz = -sinPitch * (myCenterX - myRotationPointX) + cosPitch * sinRoll * (myCenterY - myRotationPointY) + cosPitch * cosRoll * (myCenterZ - myRotationPointZ) + myRotationPointZ;
-    attribMutex.unlock();
-    return cz;
+    Transform t = getTransform();
+    if (t.centerX == t.rotationX && t.centerY == t.rotationY && t.centerZ == t.rotationZ)
+        return t.centerZ;
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    return -sinPitch * (t.centerX - t.rotationX) + cosPitch * sinRoll * (t.centerY - t.rotationY) + cosPitch * cosRoll * (t.centerZ - t.rotationZ) + t.rotationZ;
 }
 
 Drawable::~Drawable() {
     delete[] vertices;
 }
 
+/*!
+ * \brief Starts changing the Drawable's transform.
+ * \details Makes transformSeq odd, so that readers know to try again. A lone writer does this with one
+ *   compare-and-swap and never waits; writers on other threads wait for each other's endTransform().
+ * \note Every change to myCenter, myRotationPoint, myCurrentYaw, myCurrentPitch, myCurrentRoll or the scales
+ *   outside a constructor must come between beginTransform() and endTransform().
+ */
+void Drawable::beginTransform() {
+    unsigned seq = transformSeq.load(std::memory_order_relaxed);
+    while ((seq & 1) || !transformSeq.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        if (seq & 1) {
+            std::this_thread::yield();
+            seq = transformSeq.load(std::memory_order_relaxed);
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+/*!
+ * \brief Finishes changing the Drawable's transform, publishing it to readers and raising the ChangeSignal.
+ */
+void Drawable::endTransform() {
+    transformSeq.store(transformSeq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    attribMutex.raise();
+}
+
+/*!
+ * \brief Takes a consistent copy of the Drawable's transform without locking.
+ * \details Reads the transform, and reads it again if a writer was changing it in the meantime.
+ * \return The Drawable's center, rotation point, yaw, pitch, roll and scale, as of a single moment.
+ */
+Drawable::Transform Drawable::getTransform() const {
+    Transform t;
+    unsigned before, after;
+    do {
+        before = transformSeq.load(std::memory_order_acquire);
+        while (before & 1) {
+            std::this_thread::yield();
+            before = transformSeq.load(std::memory_order_acquire);
+        }
+        t.yaw = myCurrentYaw, t.pitch = myCurrentPitch, t.roll = myCurrentRoll;
+        t.xScale = myXScale, t.yScale = myYScale, t.zScale = myZScale;
+        t.rotationX = myRotationPointX, t.rotationY = myRotationPointY, t.rotationZ = myRotationPointZ;
+        t.centerX = myCenterX, t.centerY = myCenterY, t.centerZ = myCenterZ;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = transformSeq.load(std::memory_order_relaxed);
+    } while (before != after);
+    return t;
+}
+
+/*!
+ * \brief Builds the model matrix for a transform.
+ * \details Scales, moves the center to its offset from the rotation point, rotates by roll, pitch and yaw,
+ *   then moves to the rotation point.
+ *   \param t The transform, usually from getTransform().
+ * \return The matrix for the shader's <code>model</code> uniform.
+ */
+glm::mat4 Drawable::modelMatrix(const Transform& t) {
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, glm::vec3(t.rotationX, t.rotationY, t.rotationZ));
+    model = glm::rotate(model, glm::radians(t.yaw), glm::vec3(0.0f, 0.0f, 1.0f));
+    model = glm::rotate(model, glm::radians(t.pitch), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(t.roll), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::translate(model, glm::vec3(t.centerX - t.rotationX, t.centerY - t.rotationY, t.centerZ - t.rotationZ));
+    model = glm::scale(model, glm::vec3(t.xScale, t.yScale, t.zScale));
+    return model;
+}
+
+/*!
+ * \brief Points the shape shader's attributes at vertices of the given layout.
+ * \details Packed colors are read as normalized unsigned bytes. For VERTEX_UNIFORM vertices the color attribute
+ *   is disabled and given a constant value instead, so the shader reads the same color for every vertex.
+ *   \param shader The shape shader, which must be in use.
+ *   \param format The layout of the vertices about to be uploaded.
+ *   \param color The color of every vertex, if <code>format</code> is VERTEX_UNIFORM.
+ * \note Call restoreVertexFormat() once done drawing.
+ */
+void Drawable::useVertexFormat(Shader * shader, VertexFormat format, const ColorFloat &color) {
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+    glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, floatsPerVertex(format) * sizeof(float), (void*)0);
+    if (format == VERTEX_UNIFORM) {
+        glDisableVertexAttribArray(colAttrib);
+        glVertexAttrib4f(colAttrib, color.R, color.G, color.B, color.A);
+    } else {
+        glEnableVertexAttribArray(colAttrib);
+        glVertexAttribPointer(colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, PACKED_VERTEX_FLOATS * sizeof(float), (void*)(3 * sizeof(float)));
+    }
+}
+
+/*!
+ * \brief Points the shape shader's attributes back at the layout the other Drawables draw with.
+ *   \param shader The shape shader, which must be in use.
+ */
+void Drawable::restoreVertexFormat(Shader * shader) {
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+    glEnableVertexAttribArray(colAttrib);
+    glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
+    glVertexAttribPointer(colAttrib, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+}
+
+/*!
+ * \brief Packs a color into the 32-bit word that follows a vertex's position.
+ *   \param word The float slot that holds the packed color.
+ *   \param color The color to pack, rounded to 8 bits per channel.
+ */
+void Drawable::packColor(GLfloat * word, const ColorFloat &color) {
+    GLubyte * bytes = (GLubyte *) word;
+    const float channels[4] = { color.R, color.G, color.B, color.A };
+    for (int i = 0; i < 4; i++) {
+        float f = channels[i] < 0.0f ? 0.0f : (channels[i] > 1.0f ? 1.0f : channels[i]);
+        bytes[i] = (GLubyte) (f * 255.0f + 0.5f);
+    }
+}
+
+/*!
+ * \brief Unpacks a color written by packColor().
+ *   \param word The float slot that holds the packed color.
+ * \return The unpacked color.
+ */
+ColorFloat Drawable::unpackColor(const GLfloat * word) {
+    const GLubyte * bytes = (const GLubyte *) word;
+    return ColorFloat(bytes[0] / 255.0f, bytes[1] / 255.0f, bytes[2] / 255.0f, bytes[3] / 255.0f);
+}
+
 }
\ No newline at end of file
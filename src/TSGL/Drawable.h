@@ -5,15 +5,23 @@
 #ifndef DRAWABLE_H_
 #define DRAWABLE_H_
 
+#include "ChangeSignal.h" // For waking the Canvas when the Drawable changes
 #include "Color.h"      // Needed for color type
 #include "Shader.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <atomic>       // For the sequence number guarding the transform
 #include <mutex>        // Needed for locking the attribute mutex for thread-safety
 
 namespace tsgl {
 
+/*! \brief Layouts in which Drawables drawn with the shape shader store and upload their vertices. */
+enum VertexFormat {
+    VERTEX_PACKED,      ///< x, y, z and an RGBA color packed into one 32-bit word: 16 bytes per vertex
+    VERTEX_UNIFORM      ///< x, y, z only: 12 bytes per vertex, with one color for every vertex
+};
+
 /*! \class Drawable
  *  \brief A class for drawing objects onto a Canvas or CartesianCanvas.
  *  \warning <b><i>Though extending this class must be allowed due to the way the code is set up, attempting to do so
@@ -26,10 +34,22 @@ namespace tsgl {
  *  See https://www.opengl.org/sdk/docs/man2/xhtml/glBegin.xml for further information.
  *  \details Theoretically, you could potentially extend the Drawable class so that you can create another Drawable class that suits your needs.
  *  \details However, this is not recommended for normal use of the TSGL library.
+ *  \details A Drawable's center, rotation point, yaw, pitch, roll and scale are guarded by a sequence lock rather than
+ *  by <code>attribMutex</code>: changing them never waits on the rendering thread, and the rendering thread reads them
+ *  without locking, trying again in the rare case that they changed while it was reading.
  */
 class Drawable {
  protected:
-    std::mutex      attribMutex; ///< Protects the attributes of the Drawable from being accessed while simultaneously being changed
+    /*! \brief A consistent copy of a Drawable's transform, taken with getTransform(). */
+    struct Transform {
+        float yaw, pitch, roll;
+        float xScale, yScale, zScale;
+        float rotationX, rotationY, rotationZ;
+        float centerX, centerY, centerZ;
+    };
+
+    ChangeMutex     attribMutex; ///< Protects the attributes of the Drawable from being accessed while simultaneously being changed
+    std::atomic<unsigned> transformSeq{0}; ///< Odd while the transform below is being changed; see beginTransform()
     GLfloat* vertices;
     float myCurrentYaw, myCurrentPitch, myCurrentRoll;
     float myXScale, myYScale, myZScale;
@@ -46,6 +66,30 @@ class Drawable {
     bool centerMatchesRotationPoint() {
         return (myCenterX == myRotationPointX && myCenterY == myRotationPointY && myCenterZ == myRotationPointZ);
     }
+
+    void beginTransform();
+
+    void endTransform();
+
+    Transform getTransform() const;
+
+    static glm::mat4 modelMatrix(const Transform& t);
+
+    /*! \brief The model matrix for the Drawable's current transform, as every draw() uploads it. */
+    glm::mat4 getModelMatrix() const { return modelMatrix(getTransform()); }
+
+    static const int PACKED_VERTEX_FLOATS = 4;  ///< Floats taken up by one VERTEX_PACKED vertex
+
+    /*! \brief The number of floats one vertex takes up in the given layout. */
+    static int floatsPerVertex(VertexFormat format) { return (format == VERTEX_UNIFORM) ? 3 : PACKED_VERTEX_FLOATS; }
+
+    static void packColor(GLfloat * word, const ColorFloat &color);
+
+    static ColorFloat unpackColor(const GLfloat * word);
+
+    static void useVertexFormat(Shader * shader, VertexFormat format, const ColorFloat &color);
+
+    static void restoreVertexFormat(Shader * shader);
  public:
     Drawable(float x, float y, float z, float yaw, float pitch, float roll);
 
@@ -86,37 +130,37 @@ class Drawable {
     * \brief Accessor for the Yaw of the Drawable.
     * \details Returns the value of the myCurrentYaw private variable.
     */
-    virtual float getYaw() { return myCurrentYaw; }
+    virtual float getYaw() { return getTransform().yaw; }
 
     /*!
     * \brief Accessor for the Pitch of the Drawable.
     * \details Returns the value of the myCurrentPitch private variable.
     */
-    virtual float getPitch() { return myCurrentPitch; }
+    virtual float getPitch() { return getTransform().pitch; }
 
     /*!
     * \brief Accessor for the Roll of the Drawable.
     * \details Returns the value of the myCurrentRoll private variable.
     */
-    virtual float getRoll() { return myCurrentRoll; }
+    virtual float getRoll() { return getTransform().roll; }
 
     /*!
     * \brief Accessor for the rotation x-coordinate of the Drawable.
     * \details Returns the value of the myRotationPointX private variable.
     */
-    virtual float getRotationPointX() { return myRotationPointX; }
+    virtual float getRotationPointX() { return getTransform().rotationX; }
 
     /*!
     * \brief Accessor for the rotation y-coordinate of the Drawable.
     * \details Returns the value of the myRotationPointY private variable.
     */
-    virtual float getRotationPointY() { return myRotationPointY; }
+    virtual float getRotationPointY() { return getTransform().rotationY; }
 
    /*!
     * \brief Accessor for the rotation z-coordinate of the Drawable.
     * \details Returns the value of the myRotationPointZ private variable.
     */
-    virtual float getRotationPointZ() { return myRotationPointZ; }
+    virtual float getRotationPointZ() { return getTransform().rotationZ; }
 
    /*!
     * \brief Accessor that returns if Drawable is processed and ready to be drawn
@@ -135,6 +179,13 @@ class Drawable {
     * \details Principally designed to be used within Canvas for transparency sorting.
     */
     virtual float getAlpha() { return myAlpha; }
+
+   /*!
+    * \brief Mutator for the ChangeSignal raised when the Drawable changes.
+    * \details Canvas calls this when the Drawable is added to it or removed from it.
+    *   \param signal The Canvas' ChangeSignal, or nullptr for none.
+    */
+    void setChangeSignal(ChangeSignal * signal) { attribMutex.setSignal(signal); }
 };
 
 }
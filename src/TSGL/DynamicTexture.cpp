@@ -0,0 +1,295 @@
+#include "DynamicTexture.h"
+#include "RenderService.h"  // For the context that owns our GL objects
+
+#include <cstdlib>
+#include <cstring>
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new DynamicTexture.
+  * \details This is the explicit constructor for the DynamicTexture class. Its pixels start out all zero.
+  *   \param x The x coordinate of the center of the DynamicTexture.
+  *   \param y The y coordinate of the center of the DynamicTexture.
+  *   \param z The z coordinate of the center of the DynamicTexture.
+  *   \param pixelWidth The number of columns of pixels.
+  *   \param pixelHeight The number of rows of pixels.
+  *   \param format The layout of the pixels that will be passed to update().
+  *   \param width The width of the DynamicTexture.
+  *   \param height The height of the DynamicTexture.
+  *   \param yaw The yaw orientation of the DynamicTexture.
+  *   \param pitch The pitch orientation of the DynamicTexture.
+  *   \param roll The roll orientation of the DynamicTexture.
+  *   \param alpha The alpha of the DynamicTexture.
+  * \return A new DynamicTexture is drawn with the specified coordinates, dimensions, and transparency.
+  */
+DynamicTexture::DynamicTexture(float x, float y, float z, int pixelWidth, int pixelHeight, PixelFormat format, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha) : Drawable(x,y,z,yaw,pitch,roll) {
+    vertices = nullptr;
+    staging[0] = staging[1] = nullptr;
+    myContext = nullptr;
+    myTexture = 0;
+    myPBOs[0] = myPBOs[1] = 0;
+    if (pixelWidth <= 0 || pixelHeight <= 0) {
+        TsglDebug("Cannot have a DynamicTexture with no pixels.");
+        return;
+    }
+    if (width <= 0 || height <= 0) {
+        TsglDebug("Cannot have a DynamicTexture with width or height less than or equal to 0.");
+        return;
+    }
+    if (alpha < 0.0 || alpha > 1.0) {
+        TsglDebug("Cannot have a DynamicTexture with alpha not between 0.0 and 1.0.");
+        return;
+    }
+    attribMutex.lock();
+    shaderType = TEXTURE_SHADER_TYPE;
+    myWidth = width; myHeight = height;
+    myXScale = width; myYScale = height; myZScale = 1;
+    myAlpha = alpha;
+    this->pixelWidth = pixelWidth;
+    this->pixelHeight = pixelHeight;
+    myFormat = format;
+    switch (format) {
+        case PIXEL_RGB:  bytesPerPixel = 3; break;
+        case PIXEL_GRAY: bytesPerPixel = 1; break;
+        default:         bytesPerPixel = 4; break;
+    }
+    size_t size = (size_t) pixelWidth * pixelHeight * bytesPerPixel;
+    staging[0] = (unsigned char *) calloc(size, 1);
+    staging[1] = (unsigned char *) calloc(size, 1);
+    writeIndex = 0;
+    nextPBO = 0;
+    needsCatchUp = false;
+    isDirty = true;             // Upload the initial (blank) pixels on the first frame
+    dirtyX1 = dirtyY1 = 0;
+    dirtyX2 = pixelWidth; dirtyY2 = pixelHeight;
+
+    // Same quad as Image, with the texture flipped so that row 0 of the pixels is the top.
+    vertices = new GLfloat[30];
+    vertices[0]  = vertices[1]  = vertices[5]  = vertices[15] = vertices[16] = vertices[26] = 0.5; // x + y
+    vertices[6] = vertices[10] = vertices[11] = vertices[20] = vertices[21] = vertices[25] = -0.5; // x + y
+    vertices[2] = vertices[7] = vertices[12] = vertices[17] = vertices[22] = vertices[27] = 0; // z
+    vertices[3]  = vertices[8]  = vertices[18] = vertices[9] = vertices[14] = vertices[24] = 1.0; // texture coord x + y
+    vertices[4] = vertices[13] = vertices[19] = vertices[23] = vertices[28] = vertices[29] = 0.0; // texture coord x + y
+    init = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Draw the DynamicTexture.
+  * \details This function actually draws the DynamicTexture to the Canvas, first uploading
+  *   any pixels that have changed since the last frame.
+  */
+void DynamicTexture::draw(Shader * shader) {
+    if (!init) {
+        TsglDebug("Vertex buffer is not full.");
+        return;
+    }
+    attribMutex.lock();
+    glm::mat4 model = getModelMatrix();
+
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    unsigned int alphaLoc = glGetUniformLocation(shader->ID, "alpha");
+    glUniform1f(alphaLoc, myAlpha);
+
+    if (!myTexture)
+        createTexture();
+
+    // Swap staging buffers: producers move on to the other one while we upload this one.
+    bool upload = false;
+    int x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+    stagingMutex.lock();
+    if (isDirty) {
+        x1 = dirtyX1; y1 = dirtyY1; x2 = dirtyX2; y2 = dirtyY2;
+        writeIndex = 1 - writeIndex;
+        needsCatchUp = true;
+        catchUpX1 = x1; catchUpY1 = y1; catchUpX2 = x2; catchUpY2 = y2;
+        isDirty = false;
+        upload = true;
+    }
+    const unsigned char * pixels = staging[1 - writeIndex];
+    stagingMutex.unlock();
+    if (upload)
+        uploadRect(pixels, x1, y1, x2, y2);
+
+    glBindTexture(GL_TEXTURE_2D, myTexture);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 5, vertices, GL_DYNAMIC_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    attribMutex.unlock();
+}
+
+// Creates the texture and pixel buffers in the current context. attribMutex must be held.
+void DynamicTexture::createTexture() {
+    myContext = RenderService::currentContext();
+    glGenTextures(1, &myTexture);
+    glBindTexture(GL_TEXTURE_2D, myTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    GLint internalFormat = GL_RGBA8;
+    GLenum format = GL_RGBA;
+    if (myFormat == PIXEL_BGRA) {
+        format = GL_BGRA;
+    } else if (myFormat == PIXEL_RGB) {
+        internalFormat = GL_RGB8;
+        format = GL_RGB;
+    } else if (myFormat == PIXEL_GRAY) {
+        internalFormat = GL_R8;
+        format = GL_RED;
+        GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, pixelWidth, pixelHeight, 0, format, GL_UNSIGNED_BYTE, nullptr);
+    glGenBuffers(2, myPBOs);
+}
+
+// Streams a rectangle of a staging buffer into the texture through the next pixel buffer object.
+void DynamicTexture::uploadRect(const unsigned char * pixels, int x1, int y1, int x2, int y2) {
+    int w = x2 - x1, h = y2 - y1;
+    size_t rowSize = (size_t) w * bytesPerPixel, size = rowSize * h;
+    if (size == 0) return;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, myPBOs[nextPBO]);
+    nextPBO = 1 - nextPBO;
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);   // Orphan the old storage
+    unsigned char * dst = (unsigned char *) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                                             GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (dst) {
+        for (int row = 0; row < h; row++)
+            memcpy(dst + row * rowSize, pixels + ((size_t) (y1 + row) * pixelWidth + x1) * bytesPerPixel, rowSize);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        GLenum format = GL_RGBA;
+        if (myFormat == PIXEL_BGRA) format = GL_BGRA;
+        else if (myFormat == PIXEL_RGB) format = GL_RGB;
+        else if (myFormat == PIXEL_GRAY) format = GL_RED;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glBindTexture(GL_TEXTURE_2D, myTexture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x1, y1, w, h, format, GL_UNSIGNED_BYTE, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    } else {
+        TsglErr("Could not map DynamicTexture pixel buffer.");
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);    // Other textures upload from client memory
+}
+
+// Copies a w x h block from src into the staging buffer dst at (x, y).
+void DynamicTexture::copyRect(unsigned char * dst, const unsigned char * src, int srcStride, int x, int y, int w, int h) {
+    size_t rowSize = (size_t) w * bytesPerPixel;
+    for (int row = 0; row < h; row++)
+        memcpy(dst + ((size_t) (y + row) * pixelWidth + x) * bytesPerPixel, src + (size_t) row * srcStride, rowSize);
+}
+
+ /*!
+  * \brief Replaces all of the DynamicTexture's pixels.
+  *   \param data getPixelWidth() * getPixelHeight() tightly packed pixels in the DynamicTexture's
+  *     PixelFormat, top row first.
+  * \note The pixels are copied, so data may be reused as soon as this returns.
+  */
+void DynamicTexture::update(const void * data) {
+    update(data, 0, 0, pixelWidth, pixelHeight);
+}
+
+ /*!
+  * \brief Replaces a rectangle of the DynamicTexture's pixels.
+  * \details The pixels are copied into a staging buffer and uploaded at the start of the next frame.
+  *   Several updates between two frames are uploaded together.
+  *   \param data width * height tightly packed pixels in the DynamicTexture's PixelFormat, top row first.
+  *   \param x The column of the left edge of the rectangle.
+  *   \param y The row of the top edge of the rectangle, counting down from the top.
+  *   \param width The width of the rectangle in pixels.
+  *   \param height The height of the rectangle in pixels.
+  * \note The pixels are copied, so data may be reused as soon as this returns.
+  */
+void DynamicTexture::update(const void * data, int x, int y, int width, int height) {
+    if (!init || !data) return;
+    if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > pixelWidth || y + height > pixelHeight) {
+        TsglDebug("Cannot update a rectangle outside of a DynamicTexture.");
+        return;
+    }
+    stagingMutex.lock();
+    unsigned char * dst = staging[writeIndex];
+    if (needsCatchUp) {
+        // Bring this buffer up to date with what was uploaded from the other one, unless we're overwriting it anyway.
+        if (catchUpX1 < x || catchUpY1 < y || catchUpX2 > x + width || catchUpY2 > y + height) {
+            const unsigned char * src = staging[1 - writeIndex] + ((size_t) catchUpY1 * pixelWidth + catchUpX1) * bytesPerPixel;
+            copyRect(dst, src, pixelWidth * bytesPerPixel, catchUpX1, catchUpY1, catchUpX2 - catchUpX1, catchUpY2 - catchUpY1);
+        }
+        needsCatchUp = false;
+    }
+    copyRect(dst, (const unsigned char *) data, width * bytesPerPixel, x, y, width, height);
+    if (isDirty) {
+        if (x < dirtyX1) dirtyX1 = x;
+        if (y < dirtyY1) dirtyY1 = y;
+        if (x + width > dirtyX2) dirtyX2 = x + width;
+        if (y + height > dirtyY2) dirtyY2 = y + height;
+    } else {
+        dirtyX1 = x; dirtyY1 = y; dirtyX2 = x + width; dirtyY2 = y + height;
+        isDirty = true;
+    }
+    stagingMutex.unlock();
+}
+
+/**
+ * \brief Mutates the distance from the left side of the DynamicTexture to its right side.
+ * \param width The DynamicTexture's new width.
+ */
+void DynamicTexture::setWidth(GLfloat width) {
+    if (width <= 0) {
+        TsglDebug("Cannot have a DynamicTexture with width less than or equal to 0.");
+        return;
+    }
+    attribMutex.lock();
+    myWidth = width;
+    beginTransform();
+    myXScale = width;
+    endTransform();
+    attribMutex.unlock();
+}
+
+/**
+ * \brief Mutates the distance from the top side of the DynamicTexture to its bottom side.
+ * \param height The DynamicTexture's new height.
+ */
+void DynamicTexture::setHeight(GLfloat height) {
+    if (height <= 0) {
+        TsglDebug("Cannot have a DynamicTexture with height less than or equal to 0.");
+        return;
+    }
+    attribMutex.lock();
+    myHeight = height;
+    beginTransform();
+    myYScale = height;
+    endTransform();
+    attribMutex.unlock();
+}
+
+/**
+ *  \brief Alters the DynamicTexture's transparency
+ *  \param alpha The DynamicTexture's new alpha value.
+ *  \note If parameter not 0.0 <= alpha <= 1.0 then this method will have no effect.
+ */
+void DynamicTexture::setAlpha(float alpha) {
+    if (alpha < 0.0 || alpha > 1.0) {
+        TsglDebug("Cannot have a DynamicTexture with alpha not 0.0 <= alpha <= 1.0.");
+        return;
+    }
+    attribMutex.lock();
+    myAlpha = alpha;
+    attribMutex.unlock();
+}
+
+DynamicTexture::~DynamicTexture() {
+    // We may not be on the render thread, so let it delete the GL objects.
+    TextureCache::deleteTextureLater(myContext, myTexture);
+    TextureCache::deleteBufferLater(myContext, myPBOs[0]);
+    TextureCache::deleteBufferLater(myContext, myPBOs[1]);
+    free(staging[0]);
+    free(staging[1]);
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+ * DynamicTexture.h extends Drawable and provides a class for drawing pixels streamed from memory.
+ */
+
+#ifndef DYNAMICTEXTURE_H_
+#define DYNAMICTEXTURE_H_
+
+#include <mutex>                // Needed for locking the staging buffers for thread-safety
+
+#include "Drawable.h"           // For extending our Drawable object
+#include "TextureCache.h"       // For deleting GL objects on the render thread
+
+namespace tsgl {
+
+/*! \brief Layouts of the pixels passed to DynamicTexture::update(). Every channel is one unsigned byte. */
+enum PixelFormat {
+    PIXEL_RGBA,     ///< Red, green, blue, alpha
+    PIXEL_BGRA,     ///< Blue, green, red, alpha (common for video and camera frames)
+    PIXEL_RGB,      ///< Red, green, blue; drawn fully opaque
+    PIXEL_GRAY      ///< A single luminance channel; drawn as opaque gray
+};
+
+/*! \class DynamicTexture
+ *  \brief Draw a rectangle of pixels that are updated from memory.
+ *  \details DynamicTexture is a textured rectangle, like Image, whose pixels come from the program rather than
+ *   a file. Any thread may call update() with new pixels for the whole texture or a sub-rectangle of it as often
+ *   as it likes; the Canvas uploads whatever has changed once per frame.
+ *  \details Updates are double-buffered: update() copies into a staging buffer that the render thread never reads,
+ *   and the render thread swaps buffers once per frame, so producers and the renderer never wait on each other for
+ *   longer than a copy. Uploads stream through a pair of alternating pixel buffer objects, which are orphaned
+ *   before each write so that the driver never has to wait for the GPU to finish with the previous frame.
+ *  \details Pixel rows are given top row first, and rectangles are measured from the top-left corner.
+ *  \note A DynamicTexture should only be added to one Canvas.
+ */
+class DynamicTexture : public Drawable {
+ private:
+    GLfloat myWidth, myHeight;
+    int pixelWidth, pixelHeight;
+    PixelFormat myFormat;
+    int bytesPerPixel;
+
+    std::mutex stagingMutex;            // Protects the staging buffers and dirty rectangles
+    unsigned char * staging[2];         // Full copies of the pixels; producers write staging[writeIndex]
+    int writeIndex;
+    bool isDirty;                       // Whether staging[writeIndex] has changes not yet uploaded
+    int dirtyX1, dirtyY1, dirtyX2, dirtyY2;
+    bool needsCatchUp;                  // Whether staging[writeIndex] is missing the last uploaded rectangle
+    int catchUpX1, catchUpY1, catchUpX2, catchUpY2;
+
+    GLFWwindow * myContext;             // Context the GL objects below were created in
+    GLuint myTexture;
+    GLuint myPBOs[2];
+    int nextPBO;
+
+    void copyRect(unsigned char * dst, const unsigned char * src, int srcStride, int x, int y, int w, int h);
+    void createTexture();
+    void uploadRect(const unsigned char * pixels, int x1, int y1, int x2, int y2);
+ public:
+    DynamicTexture(float x, float y, float z, int pixelWidth, int pixelHeight, PixelFormat format, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha = 1.0f);
+
+    virtual void draw(Shader * shader);
+
+    void update(const void * data);
+
+    void update(const void * data, int x, int y, int width, int height);
+
+    /*!
+     * \brief Accessor for the DynamicTexture's height.
+     * \return The height of the DynamicTexture.
+     */
+    GLfloat getHeight() { return myHeight; }
+
+    /*!
+     * \brief Accessor for the DynamicTexture's width.
+     * \return The width of the DynamicTexture.
+     */
+    GLfloat getWidth() { return myWidth; }
+
+    /*!
+     * \brief Accessor for the number of rows of pixels.
+     * \return The height of the DynamicTexture's pixels.
+     */
+    int getPixelHeight() { return pixelHeight; }
+
+    /*!
+     * \brief Accessor for the number of columns of pixels.
+     * \return The width of the DynamicTexture's pixels.
+     */
+    int getPixelWidth() { return pixelWidth; }
+
+    /*!
+     * \brief Accessor for the layout of the DynamicTexture's pixels.
+     * \return The PixelFormat given to the constructor.
+     */
+    PixelFormat getFormat() { return myFormat; }
+
+    void setWidth(GLfloat width);
+
+    void setHeight(GLfloat height);
+
+    void setAlpha(float alpha);
+
+    virtual ~DynamicTexture();
+};
+
+}
+
+#endif /* DYNAMICTEXTURE_H_ */
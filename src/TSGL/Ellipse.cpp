@@ -71,7 +71,9 @@ void Ellipse::setXRadius(GLfloat xRadius) {
     }
     attribMutex.lock();
     myXRadius = xRadius;
+    beginTransform();
     myXScale = xRadius;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -86,7 +88,9 @@ void Ellipse::changeXRadiusBy(GLfloat delta) {
     }
     attribMutex.lock();
     myXRadius += delta;
+    beginTransform();
     myXScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -101,7 +105,9 @@ void Ellipse::setYRadius(GLfloat yRadius) {
     }
     attribMutex.lock();
     myYRadius = yRadius;
+    beginTransform();
     myYScale = yRadius;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -116,7 +122,9 @@ void Ellipse::changeYRadiusBy(GLfloat delta) {
     }
     attribMutex.lock();
     myYRadius += delta;
+    beginTransform();
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -127,18 +135,12 @@ void Ellipse::changeYRadiusBy(GLfloat delta) {
 void Ellipse::setColor(ColorFloat c[]) {
     attribMutex.lock();
     myAlpha = 0.0f;
-    vertices[3] = c[0].R;
-    vertices[4] = c[0].G;
-    vertices[5] = c[0].B;
-    vertices[6] = c[0].A;
+    setVertexColor(0, c[0]);
     myAlpha += c[0].A;
     int colorIndex;
     for (int i = 1; i < numberOfVertices; ++i) {
         colorIndex = (int) ((float) (i - 1) / verticesPerColor + 1);
-        vertices[i*7 + 3] = c[colorIndex].R;
-        vertices[i*7 + 4] = c[colorIndex].G;
-        vertices[i*7 + 5] = c[colorIndex].B;
-        vertices[i*7 + 6] = c[colorIndex].A;
+        setVertexColor(i, c[colorIndex]);
         myAlpha += c[colorIndex].A;
     }
     myAlpha /= numberOfVertices;
@@ -154,9 +156,9 @@ void Ellipse::setColor(ColorFloat c[]) {
 void Ellipse::getColors(std::vector<ColorFloat> &colorVec) { 
     attribMutex.lock();
     for (int i = 0; i < numberOfVertices; i+=verticesPerColor) {
-        colorVec.push_back(ColorFloat(vertices[i*7+3],vertices[i*7+4],vertices[i*7+5],vertices[i*7+6]));
+        colorVec.push_back(getVertexColor(i));
     }
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
 }
 
 }
\ No newline at end of file
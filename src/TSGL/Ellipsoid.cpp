@@ -31,44 +31,9 @@ Ellipsoid::Ellipsoid(float x, float y, float z, GLfloat xRadius, GLfloat yRadius
     myZScale = zRadius;
     verticalSections = 36;
     horizontalSections = 20;
-    geometryType = GL_TRIANGLE_STRIP;
-    numberOfVertices = verticalSections*horizontalSections*2 + 1;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = verticalSections*horizontalSections*4 + 1;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     isOutlined = false;
+    useMesh(MESH_SPHERE, verticalSections, c);
     attribMutex.unlock();
-	for(float b=0;b<horizontalSections;b++)
-	{
-		for(float a=0;a<verticalSections;a++)
-		{
-			addVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), ColorFloat(c.R * (1 - 1 * sin(a/verticalSections * PI) / 2), c.G * (1 - 1 * sin(a/verticalSections * PI) / 2), c.B * (1 - 1 * sin(a/verticalSections * PI) / 2), c.A));
-			addVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), ColorFloat(c.R * (1 - 1 * sin(a/verticalSections * PI) / 2), c.G * (1 - 1 * sin(a/verticalSections * PI) / 2), c.B * (1 - 1 * sin(a/verticalSections * PI) / 2), c.A));
-		}
-	}
-    addVertex(0, 1, 0, c);
-
-    // horizontal outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-    
-    // vertical outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin(((a+1)*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos(((a+1)*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin(((a+1)*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-    addOutlineVertex(0, 1, 0, GRAY);
 }
 
  /*!
@@ -102,10 +67,10 @@ Ellipsoid::Ellipsoid(float x, float y, float z, GLfloat xRadius, GLfloat yRadius
     horizontalSections = 20;
     geometryType = GL_TRIANGLE_STRIP;
     numberOfVertices = verticalSections*horizontalSections*2 + 1;
-    vertices = new GLfloat[numberOfVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
     outlineGeometryType = GL_LINES;
     numberOfOutlineVertices = verticalSections*horizontalSections*4 + 1;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     isOutlined = false;
     attribMutex.unlock();
 	for(int b=0;b<horizontalSections;b++)
@@ -151,7 +116,9 @@ void Ellipsoid::setXRadius(GLfloat radiusX) {
     }
     attribMutex.lock();
     myXRadius = radiusX;
+    beginTransform();
     myXScale = radiusX;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -166,7 +133,9 @@ void Ellipsoid::changeXRadiusBy(GLfloat delta) {
     }
     attribMutex.lock();
     myXRadius += delta;
+    beginTransform();
     myXScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -181,7 +150,9 @@ void Ellipsoid::setYRadius(GLfloat radiusY) {
     }
     attribMutex.lock();
     myYRadius = radiusY;
+    beginTransform();
     myYScale = radiusY;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -196,7 +167,9 @@ void Ellipsoid::changeYRadiusBy(GLfloat delta) {
     }
     attribMutex.lock();
     myYRadius += delta;
+    beginTransform();
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -211,7 +184,9 @@ void Ellipsoid::setZRadius(GLfloat radiusZ) {
     }
     attribMutex.lock();
     myZRadius = radiusZ;
+    beginTransform();
     myZScale = radiusZ;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -226,7 +201,9 @@ void Ellipsoid::changeZRadiusBy(GLfloat delta) {
     }
     attribMutex.lock();
     myZRadius += delta;
+    beginTransform();
     myZScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -235,26 +212,22 @@ void Ellipsoid::changeZRadiusBy(GLfloat delta) {
  * \param c The new ColorFloat.
  */
 void Ellipsoid::setColor(ColorFloat c) {
+    if (myMesh) {
+        Shape::setColor(c);
+        return;
+    }
     attribMutex.lock();
     myAlpha = c.A;
 	for(int b=0;b<horizontalSections;b++)
 	{
 		for(int a=0;a<verticalSections;a++)
 		{
-			vertices[(b*verticalSections + a)*2*7 + 3] = c.R * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 4] = c.G * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 5] = c.B * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 6] = c.A;
-			vertices[(b*verticalSections + a)*2*7 + 10] = c.R * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 11] = c.G * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 12] = c.B * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 13] = c.A;
+            float shade = 1 - 1 * sin(((float)a)/verticalSections * PI) / 2;
+			setVertexColor((b*verticalSections + a)*2, ColorFloat(c.R * shade, c.G * shade, c.B * shade, c.A));
+			setVertexColor((b*verticalSections + a)*2 + 1, ColorFloat(c.R * shade, c.G * shade, c.B * shade, c.A));
 		}
 	}
-    vertices[horizontalSections*verticalSections*2*7+3] = c.R;
-    vertices[horizontalSections*verticalSections*2*7+4] = c.G;
-    vertices[horizontalSections*verticalSections*2*7+5] = c.B;
-    vertices[horizontalSections*verticalSections*2*7+6] = c.A;
+    setVertexColor(horizontalSections*verticalSections*2, c);
     attribMutex.unlock();
 }
 
@@ -265,26 +238,18 @@ void Ellipsoid::setColor(ColorFloat c) {
  */
 void Ellipsoid::setColor(ColorFloat c[]) {
     attribMutex.lock();
+    detachMesh();
     myAlpha = 0.0;
 	for(int b=0;b<horizontalSections;b++)
 	{
 		for(int a=0;a<verticalSections;a++)
 		{
-			vertices[(b*verticalSections + a)*2*7 + 3] = c[b].R;
-            vertices[(b*verticalSections + a)*2*7 + 4] = c[b].G;
-            vertices[(b*verticalSections + a)*2*7 + 5] = c[b].B;
-            vertices[(b*verticalSections + a)*2*7 + 6] = c[b].A;
-			vertices[(b*verticalSections + a)*2*7 + 10] = c[b].R;
-            vertices[(b*verticalSections + a)*2*7 + 11] = c[b].G;
-            vertices[(b*verticalSections + a)*2*7 + 12] = c[b].B;
-            vertices[(b*verticalSections + a)*2*7 + 13] = c[b].A;
+			setVertexColor((b*verticalSections + a)*2, c[b]);
+			setVertexColor((b*verticalSections + a)*2 + 1, c[b]);
             myAlpha += c[b].A * 2;
 		}
 	}
-    vertices[horizontalSections*verticalSections*2*7+3] = c[horizontalSections-1].R;
-    vertices[horizontalSections*verticalSections*2*7+4] = c[horizontalSections-1].G;
-    vertices[horizontalSections*verticalSections*2*7+5] = c[horizontalSections-1].B;
-    vertices[horizontalSections*verticalSections*2*7+6] = c[horizontalSections-1].A;
+    setVertexColor(horizontalSections*verticalSections*2, c[horizontalSections-1]);
     myAlpha += c[horizontalSections-1].A;
     myAlpha /= numberOfVertices;
     attribMutex.unlock();
@@ -299,14 +264,27 @@ void Ellipsoid::setColor(ColorFloat c[]) {
 void Ellipsoid::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
     for(int b=0;b<horizontalSections;b++) {
-        colorVec.push_back(ColorFloat(
-            vertices[(b*verticalSections)*2*7 + 3],
-            vertices[(b*verticalSections)*2*7 + 4],
-            vertices[(b*verticalSections)*2*7 + 5],
-            vertices[(b*verticalSections)*2*7 + 6])
-            );
+        colorVec.push_back(getVertexColor(b*verticalSections*2));
     }
+    attribMutex.unlockUnchanged();
+}
+
+/**
+ * \brief Sets the number of vertical sections with which the Ellipsoid is drawn.
+ * \details By default a Ellipsoid's level of detail is chosen every frame from the size it covers on screen:
+ *   a large Ellipsoid is drawn with 36 vertical sections, and smaller ones with 18 or 9, so that distant
+ *   Ellipsoids cost a few dozen triangles each. This overrides that choice.
+ * \param sections The number of vertical sections (at least 3), or 0 to choose automatically again.
+ * \note Has no effect on a Ellipsoid that has been given per-section colors, which is always drawn in full.
+ */
+void Ellipsoid::setLevelOfDetail(int sections) {
+    if (sections != 0 && sections < 3) {
+        TsglDebug("Cannot draw a Ellipsoid with fewer than 3 sections.");
+        return;
+    }
+    attribMutex.lock();
+    myDetail = sections;
     attribMutex.unlock();
 }
 
-}
\ No newline at end of file
+}
@@ -46,6 +46,14 @@ public:
     virtual void setColor(ColorFloat c[]);
 
     virtual void getColors(std::vector<ColorFloat> &colorVec);
+
+    void setLevelOfDetail(int sections);
+
+    /*!
+     * \brief Accessor for the level of detail set with setLevelOfDetail().
+     * \return The number of vertical sections the Ellipsoid is always drawn with, or 0 if it is chosen automatically.
+     */
+    int getLevelOfDetail() { return myDetail; }
 };
 
 }
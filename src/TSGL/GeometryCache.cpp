@@ -0,0 +1,352 @@
+#include "GeometryCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Error.h"
+#include "RenderService.h"
+#include "TextureCache.h"
+#include "Util.h"
+
+namespace tsgl {
+
+GeometryCache::MeshMap GeometryCache::meshes;
+std::mutex GeometryCache::cacheMutex;
+
+ /*!
+  * \brief Indices of the 12 triangles of a box.
+  * \details The box's 8 corners are numbered as in Cube and Cuboid: (-,-,-), (-,-,+), (-,+,+), (-,+,-),
+  *   (+,-,-), (+,-,+), (+,+,+), (+,+,-).
+  */
+const GLuint GeometryCache::BOX_INDICES[36] = {
+    0, 1, 2,  0, 2, 3,
+    4, 5, 6,  4, 6, 7,
+    4, 0, 1,  4, 1, 5,
+    7, 3, 2,  7, 2, 6,
+    0, 3, 7,  0, 7, 4,
+    1, 2, 6,  1, 6, 5
+};
+
+ /*!
+  * \brief Indices of the 12 edges of a box, as pairs of the corners in BOX_INDICES.
+  */
+const GLuint GeometryCache::BOX_OUTLINE_INDICES[24] = {
+    6, 7,  7, 4,  4, 5,  5, 6,
+    2, 3,  3, 0,  0, 1,  1, 2,
+    2, 6,  3, 7,  0, 4,  1, 5
+};
+
+ /*!
+  * \brief Acquires a reference to a shared unit mesh.
+  * \details If a mesh of the same kind and tessellation is already in use it is shared; otherwise it is built.
+  *   \param kind The kind of mesh to acquire.
+  *   \param tessellation The number of sections (for MESH_SPHERE) or sides (for MESH_PRISM and MESH_PYRAMID).
+  * \return A pointer to the shared Mesh, or nullptr if the tessellation is too coarse to build.
+  * \note Every successful call to acquire() must be balanced by a call to release().
+  */
+GeometryCache::Mesh * GeometryCache::acquire(MeshKind kind, int tessellation) {
+    if (tessellation < 3) {
+        TsglDebug("Cannot build a mesh with fewer than 3 sections.");
+        return nullptr;
+    }
+    cacheMutex.lock();
+    MeshMap::iterator it = meshes.find(std::make_pair(kind, tessellation));
+    if (it != meshes.end()) {
+        it->second->refCount++;
+        Mesh * mesh = it->second;
+        cacheMutex.unlock();
+        return mesh;
+    }
+    Mesh * mesh = new Mesh();
+    mesh->kind = kind;
+    mesh->tessellation = tessellation;
+    mesh->refCount = 1;
+    switch (kind) {
+        case MESH_SPHERE:  buildSphere(mesh);  break;
+        case MESH_PRISM:   buildPrism(mesh);   break;
+        case MESH_PYRAMID: buildPyramid(mesh); break;
+    }
+    meshes[std::make_pair(kind, tessellation)] = mesh;
+    cacheMutex.unlock();
+    return mesh;
+}
+
+ /*!
+  * \brief Releases a reference to a shared unit mesh.
+  * \details Once the last reference is released the mesh is freed and its buffers are queued for deletion.
+  *   \param mesh The Mesh to release. May be nullptr.
+  */
+void GeometryCache::release(Mesh * mesh) {
+    if (!mesh) return;
+    cacheMutex.lock();
+    if (--mesh->refCount > 0) {
+        cacheMutex.unlock();
+        return;
+    }
+    meshes.erase(std::make_pair(mesh->kind, mesh->tessellation));
+    cacheMutex.unlock();
+    for (LevelMap::iterator it = mesh->levels.begin(); it != mesh->levels.end(); ++it)
+        release(it->second);
+    for (BufferMap::iterator it = mesh->buffers.begin(); it != mesh->buffers.end(); ++it) {
+        TextureCache::deleteBufferLater(it->first, it->second.first);
+        TextureCache::deleteBufferLater(it->first, it->second.second);
+    }
+    delete [] mesh->vertices;
+    delete [] mesh->indices;
+    delete [] mesh->outlineIndices;
+    delete mesh;
+}
+
+ /*!
+  * \brief Chooses the level of detail at which to draw a shared unit mesh.
+  * \details For sphere meshes, estimates the radius in pixels that the mesh covers when drawn with
+  *   <code>model</code> through the shader's camera, and picks the full mesh, one with half as many
+  *   sections, or one with a quarter as many. Other kinds of mesh are always drawn in full.
+  *   \param mesh The full-detail Mesh held by the Shape.
+  *   \param model The Shape's model matrix.
+  *   \param shader The shader the Shape is drawn with, holding the camera of the current frame.
+  *   \param tessellation A number of sections to use instead of choosing one, or 0 to choose automatically.
+  * \return The Mesh to draw. Levels other than <code>mesh</code> itself are owned by <code>mesh</code>.
+  * \note Must be called on a render thread.
+  */
+GeometryCache::Mesh * GeometryCache::selectLevel(Mesh * mesh, const glm::mat4& model, Shader * shader, int tessellation) {
+    if (!mesh || mesh->kind != MESH_SPHERE) return mesh;
+    if (tessellation <= 0) {
+        if (shader->viewportHeight <= 0) return mesh;
+        glm::vec4 center = shader->view * model * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        float distance = -center.z;
+        float radius = 0;
+        for (int axis = 0; axis < 3; axis++)
+            radius = std::max(radius, (float) sqrt(model[axis][0]*model[axis][0] + model[axis][1]*model[axis][1] + model[axis][2]*model[axis][2]));
+        if (distance <= radius) return mesh;
+        float pixels = radius / distance * shader->projection[1][1] * shader->viewportHeight / 2;
+        if (pixels >= FULL_DETAIL_PIXELS)
+            return mesh;
+        tessellation = (pixels >= HALF_DETAIL_PIXELS) ? mesh->tessellation / 2 : mesh->tessellation / 4;
+    }
+    if (tessellation == mesh->tessellation) return mesh;
+
+    cacheMutex.lock();
+    LevelMap::iterator it = mesh->levels.find(tessellation);
+    if (it != mesh->levels.end()) {
+        Mesh * level = it->second;
+        cacheMutex.unlock();
+        return level;
+    }
+    cacheMutex.unlock();
+    Mesh * level = acquire(mesh->kind, tessellation);
+    if (!level) return mesh;
+    cacheMutex.lock();
+    it = mesh->levels.find(tessellation);
+    if (it != mesh->levels.end()) {
+        // Another render thread added this level first
+        Mesh * existing = it->second;
+        cacheMutex.unlock();
+        release(level);
+        return existing;
+    }
+    mesh->levels[tessellation] = level;
+    cacheMutex.unlock();
+    return level;
+}
+
+ /*!
+  * \brief Draws a shared unit mesh with the current model matrix.
+  * \details Uploads the mesh into the current context the first time it is drawn there, then draws its fill
+  *   and a prefix of its outline from those buffers. The fill's shade factors are tinted with the given color,
+  *   and the outline is drawn in a constant color. The previously bound buffers and attribute layout are
+  *   restored afterwards, so other Drawables are unaffected.
+  *   \param mesh The Mesh to draw.
+  *   \param shader The shape shader, whose model matrix has already been set.
+  *   \param filled Whether to draw the mesh's fill.
+  *   \param color The color by which the fill's shade factors are multiplied.
+  *   \param outlineIndices The number of outline indices to draw; 0 draws no outline.
+  *   \param outlineColor The color of the outline.
+  * \note Must be called on a render thread, with the shape shader in use.
+  */
+void GeometryCache::draw(Mesh * mesh, Shader * shader, bool filled, const ColorFloat& color, int outlineIndices, const ColorFloat& outlineColor) {
+    GLFWwindow * context = RenderService::currentContext();
+    if (!mesh || !context) return;
+    GLint previousBuffer, previousElements;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &previousElements);
+
+    cacheMutex.lock();
+    BufferMap::iterator it = mesh->buffers.find(context);
+    if (it == mesh->buffers.end()) {
+        GLuint buffers[2];
+        glGenBuffers(2, buffers);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * mesh->numberOfVertices * 7, mesh->vertices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * (mesh->numberOfIndices + mesh->numberOfOutlineIndices), NULL, GL_STATIC_DRAW);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(GLuint) * mesh->numberOfIndices, mesh->indices);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * mesh->numberOfIndices, sizeof(GLuint) * mesh->numberOfOutlineIndices, mesh->outlineIndices);
+        mesh->buffers[context] = std::make_pair(buffers[0], buffers[1]);
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, it->second.first);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, it->second.second);
+    }
+    cacheMutex.unlock();
+
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+    glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
+    glVertexAttribPointer(colAttrib, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+
+    if (filled) {
+        GLint tintLoc = glGetUniformLocation(shader->ID, "tint");
+        glUniform4f(tintLoc, color.R, color.G, color.B, color.A);
+        glDrawElements(mesh->geometryType, mesh->numberOfIndices, GL_UNSIGNED_INT, (void*)0);
+        glUniform4f(tintLoc, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    if (outlineIndices > 0) {
+        if (outlineIndices > mesh->numberOfOutlineIndices)
+            outlineIndices = mesh->numberOfOutlineIndices;
+        // The outline shares the fill's vertices, so replace their shades with a constant color
+        glDisableVertexAttribArray(colAttrib);
+        glVertexAttrib4f(colAttrib, outlineColor.R, outlineColor.G, outlineColor.B, outlineColor.A);
+        glDrawElements(mesh->outlineGeometryType, outlineIndices, GL_UNSIGNED_INT, (void*)(sizeof(GLuint) * mesh->numberOfIndices));
+        glEnableVertexAttribArray(colAttrib);
+    }
+
+    // The VAO remembers which buffer each attribute reads from, so point them back at the shared buffers.
+    glBindBuffer(GL_ARRAY_BUFFER, previousBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, previousElements);
+    glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
+    glVertexAttribPointer(colAttrib, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+}
+
+ /*!
+  * \brief Forgets every buffer that belonged to a destroyed GL context.
+  *   \param context The context that is being destroyed.
+  * \note Called by Canvas as it tears down its window.
+  */
+void GeometryCache::contextDestroyed(GLFWwindow * context) {
+    cacheMutex.lock();
+    for (MeshMap::iterator it = meshes.begin(); it != meshes.end(); ++it)
+        it->second->buffers.erase(context);
+    cacheMutex.unlock();
+}
+
+// Builds a unit sphere as a triangle strip of horizontal bands, shaded darker towards the equator.
+// Vertex b*verticalSections + a lies on band edge b and meridian a; vertex 0 is the pole at (0,1,0).
+void GeometryCache::buildSphere(Mesh * mesh) {
+    int verticalSections = mesh->tessellation;
+    int horizontalSections = verticalSections * 5 / 9;
+    if (horizontalSections < 2) horizontalSections = 2;
+    float half = verticalSections / 2.0f;
+    allocate(mesh, verticalSections*(horizontalSections+1), verticalSections*horizontalSections*2 + 1, verticalSections*horizontalSections*4 + 1);
+    mesh->geometryType = GL_TRIANGLE_STRIP;
+    mesh->outlineGeometryType = GL_LINES;
+
+    for (int b = 0; b <= horizontalSections; b++) {
+        for (int a = 0; a < verticalSections; a++) {
+            float shade = 1 - sin(((float)a) / verticalSections * PI) / 2;
+            setVertex(mesh->vertices, b*verticalSections + a, sin((a*PI)/half)*sin((b*PI)/horizontalSections), cos((a*PI)/half), cos((b*PI)/horizontalSections)*sin((a*PI)/half), shade);
+        }
+    }
+
+    int f = 0, o = 0;
+    for (int b = 0; b < horizontalSections; b++) {
+        for (int a = 0; a < verticalSections; a++) {
+            mesh->indices[f++] = b*verticalSections + a;
+            mesh->indices[f++] = (b+1)*verticalSections + a;
+        }
+    }
+    mesh->indices[f++] = 0;
+
+    // horizontal outline
+    for (int b = 0; b < horizontalSections; b++) {
+        for (int a = 0; a < verticalSections; a++) {
+            mesh->outlineIndices[o++] = b*verticalSections + a;
+            mesh->outlineIndices[o++] = (b+1)*verticalSections + a;
+        }
+    }
+
+    // vertical outline
+    for (int b = 0; b < horizontalSections; b++) {
+        for (int a = 0; a < verticalSections; a++) {
+            mesh->outlineIndices[o++] = b*verticalSections + a;
+            mesh->outlineIndices[o++] = b*verticalSections + (a+1) % verticalSections;
+        }
+    }
+    mesh->outlineIndices[o++] = 0;
+}
+
+// Builds a prism of unit radius and height: the top ring, the bottom ring, then the top and bottom centers.
+// The outline holds the top ring, then the bottom ring, then the vertical edges.
+void GeometryCache::buildPrism(Mesh * mesh) {
+    int sides = mesh->tessellation;
+    allocate(mesh, sides*2 + 2, sides*12, sides*6);
+    mesh->geometryType = GL_TRIANGLES;
+    mesh->outlineGeometryType = GL_LINES;
+
+    GLuint topCenter = sides*2, bottomCenter = sides*2 + 1;
+    for (int i = 0; i < sides; i++) {
+        setVertex(mesh->vertices, i, cos(TWOPI * i / sides), 0.5, sin(TWOPI * i / sides), 1);
+        setVertex(mesh->vertices, sides + i, cos(TWOPI * i / sides), -0.5, sin(TWOPI * i / sides), 1);
+    }
+    setVertex(mesh->vertices, topCenter, 0, 0.5, 0, 1);
+    setVertex(mesh->vertices, bottomCenter, 0, -0.5, 0, 1);
+
+    for (int i = 0; i < sides; i++) {
+        GLuint t1 = i, t2 = (i + 1) % sides, b1 = sides + t1, b2 = sides + t2;
+        GLuint fill[12] = { t1, topCenter, t2,  t2, t1, b1,  b1, t2, b2,  b2, b1, bottomCenter };
+        for (int j = 0; j < 12; j++)
+            mesh->indices[i*12 + j] = fill[j];
+
+        mesh->outlineIndices[i*2] = t1;
+        mesh->outlineIndices[i*2 + 1] = t2;
+        mesh->outlineIndices[sides*2 + i*2] = b1;
+        mesh->outlineIndices[sides*2 + i*2 + 1] = b2;
+        mesh->outlineIndices[sides*4 + i*2] = t1;
+        mesh->outlineIndices[sides*4 + i*2 + 1] = b1;
+    }
+}
+
+// Builds a pyramid of unit radius and height: the base ring, the base center, then the half-shaded apex.
+// The outline holds the base ring, then the edges to the apex.
+void GeometryCache::buildPyramid(Mesh * mesh) {
+    int sides = mesh->tessellation;
+    allocate(mesh, sides + 2, sides*6, sides*4);
+    mesh->geometryType = GL_TRIANGLES;
+    mesh->outlineGeometryType = GL_LINES;
+
+    GLuint center = sides, apex = sides + 1;
+    for (int i = 0; i < sides; i++)
+        setVertex(mesh->vertices, i, cos(TWOPI * i / sides), -0.5, sin(TWOPI * i / sides), 1);
+    setVertex(mesh->vertices, center, 0, -0.5, 0, 1);
+    setVertex(mesh->vertices, apex, 0, 0.5, 0, 0.5);
+
+    for (int i = 0; i < sides; i++) {
+        GLuint r1 = i, r2 = (i + 1) % sides;
+        GLuint fill[6] = { r1, center, r2,  r1, apex, r2 };
+        for (int j = 0; j < 6; j++)
+            mesh->indices[i*6 + j] = fill[j];
+
+        mesh->outlineIndices[i*2] = r1;
+        mesh->outlineIndices[i*2 + 1] = r2;
+        mesh->outlineIndices[sides*2 + i*2] = apex;
+        mesh->outlineIndices[sides*2 + i*2 + 1] = r1;
+    }
+}
+
+// Allocates a mesh's vertex and index arrays.
+void GeometryCache::allocate(Mesh * mesh, int vertices, int indices, int outlineIndices) {
+    mesh->numberOfVertices = vertices;
+    mesh->vertices = new GLfloat[vertices * 7];
+    mesh->numberOfIndices = indices;
+    mesh->indices = new GLuint[indices];
+    mesh->numberOfOutlineIndices = outlineIndices;
+    mesh->outlineIndices = new GLuint[outlineIndices];
+}
+
+// Writes one vertex whose color is a gray of the given shade with full alpha.
+void GeometryCache::setVertex(GLfloat * array, int index, GLfloat x, GLfloat y, GLfloat z, GLfloat shade) {
+    GLfloat * p = array + index * 7;
+    p[0] = x; p[1] = y; p[2] = z;
+    p[3] = p[4] = p[5] = shade;
+    p[6] = 1;
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * GeometryCache.h provides a reference-counted cache of the unit meshes shared by TSGL's 3D shapes.
+ */
+
+#ifndef GEOMETRYCACHE_H_
+#define GEOMETRYCACHE_H_
+
+#include <map>          // For the (kind, tessellation) -> Mesh and context -> buffer maps
+#include <mutex>        // Needed for locking the cache for thread-safety
+
+#include "Color.h"      // For the tint colors
+#include "Shader.h"     // For setting the tint uniform
+#include "gl_includes.h"
+
+namespace tsgl {
+
+/*! \brief The kinds of unit mesh that GeometryCache knows how to build. */
+enum MeshKind {
+    MESH_SPHERE,        ///< A unit sphere; tessellation is the number of vertical sections
+    MESH_PRISM,         ///< A prism of unit radius and height; tessellation is the number of sides
+    MESH_PYRAMID        ///< A pyramid of unit radius and height; tessellation is the number of sides
+};
+
+/*! \class GeometryCache
+ *  \brief Shares the vertices of 3D shapes between every Shape of the same kind and tessellation.
+ *  \details Sphere, Ellipsoid, Prism, Cylinder, Pyramid and Cone are all drawn from unit meshes that are
+ *    scaled, rotated and translated by each instance's model matrix, so their vertices never differ between
+ *    two shapes with the same number of sections. GeometryCache builds each mesh once and keeps it for as
+ *    long as at least one Shape holds a reference to it.
+ *  \details A mesh's fill vertices store a shade factor in place of a color; the instance's color is applied
+ *    as a tint in the shape shader, so changing a Shape's color never touches the shared vertices.
+ *  \details Meshes are indexed: each distinct vertex is stored once, and the fill and outline are lists of
+ *    indices into the same vertices. Each mesh is uploaded once per GL context into a static vertex buffer and
+ *    a static index buffer holding the fill indices followed by the outline indices. Buffers of released meshes
+ *    are deleted by the owning Canvas' render thread through TextureCache::deleteBufferLater().
+ *  \details Sphere meshes also have coarser levels of detail, which selectLevel() picks from each frame by
+ *    the size the sphere covers on screen. A sphere a few pixels across is drawn with a few dozen triangles
+ *    instead of the 1440 of a full-size one.
+ *  \note GeometryCache is used internally by Shape; most users will never need to call it directly.
+ */
+class GeometryCache {
+ public:
+    typedef std::map<GLFWwindow*, std::pair<GLuint,GLuint> > BufferMap;
+
+    /*! \brief An immutable unit mesh shared between all of its users. */
+    struct Mesh {
+        MeshKind kind;                                          // Key of this mesh, with tessellation
+        int tessellation;
+        GLfloat * vertices;                                     // Unique vertices; colors hold the shade factor
+        int numberOfVertices;
+        GLuint * indices;                                       // Vertices of the fill, in drawing order
+        int numberOfIndices;
+        GLenum geometryType;
+        GLuint * outlineIndices;                                // Vertices of the outline, in drawing order
+        int numberOfOutlineIndices;
+        GLenum outlineGeometryType;
+        unsigned refCount;                                      // Number of acquire() calls not yet released
+        BufferMap buffers;                                      // Context -> (vertex buffer, index buffer)
+        std::map<int, Mesh*> levels;                            // Tessellation -> other levels of detail of this mesh
+    };
+    typedef std::map<int, Mesh*> LevelMap;
+
+    static Mesh * acquire(MeshKind kind, int tessellation);
+
+    static void release(Mesh * mesh);
+
+    static Mesh * selectLevel(Mesh * mesh, const glm::mat4& model, Shader * shader, int tessellation = 0);
+
+    static void draw(Mesh * mesh, Shader * shader, bool filled, const ColorFloat& color, int outlineIndices, const ColorFloat& outlineColor);
+
+    static void contextDestroyed(GLFWwindow * context);
+
+    static const GLuint BOX_INDICES[36];
+
+    static const GLuint BOX_OUTLINE_INDICES[24];
+ private:
+    typedef std::map<std::pair<MeshKind,int>, Mesh*> MeshMap;
+
+    static const int FULL_DETAIL_PIXELS = 48;                   // Projected radius above which spheres are drawn in full
+    static const int HALF_DETAIL_PIXELS = 12;                   // Projected radius above which spheres use half the sections
+
+    static MeshMap meshes;                                      // All live meshes, keyed by (kind, tessellation)
+    static std::mutex cacheMutex;                               // Protects everything above
+
+    static void buildSphere(Mesh * mesh);
+
+    static void buildPrism(Mesh * mesh);
+
+    static void buildPyramid(Mesh * mesh);
+
+    static void allocate(Mesh * mesh, int vertices, int indices, int outlineIndices);
+
+    static void setVertex(GLfloat * array, int index, GLfloat x, GLfloat y, GLfloat z, GLfloat shade);
+};
+
+}
+
+#endif /* GEOMETRYCACHE_H_ */
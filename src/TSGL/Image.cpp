@@ -15,10 +15,11 @@ namespace tsgl {
   *   \param pitch The pitch orientation of the Image.
   *   \param roll The roll orientation of the Image. 
   *   \param alpha The alpha of the Image.
+  *   \param async Whether to decode the file on a worker thread instead of before returning.
   * \return A new Image is drawn with the specified coordinates, dimensions, and transparency.
   * \note <B>IMPORTANT</B>: In CartesianCanvas, *y* specifies the bottom, not the top, of the image.
   */
-Image::Image(float x, float y, float z, std::string filename, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha) : Drawable(x,y,z,yaw,pitch,roll) {
+Image::Image(float x, float y, float z, std::string filename, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha, bool async) : Drawable(x,y,z,yaw,pitch,roll) {
     if (width <= 0 || height <= 0) {
         TsglDebug("Cannot have an Image with width or height less than or equal to 0.");
         return;
@@ -34,10 +35,8 @@ Image::Image(float x, float y, float z, std::string filename, GLfloat width, GLf
     myFile = filename;
     myAlpha = alpha;
 
-	// Load the image.
-    stbi_set_flip_vertically_on_load(true);
-    data = stbi_load(filename.c_str(), &pixelWidth, &pixelHeight, 0, 4);
-    tsglAssert(data, "stbi_load(filename) failed.");
+    // Load the image, or share it if another Image already has.
+    myEntry = TextureCache::acquire(filename, async);
     // vertex allocation and assignment
     vertices = new GLfloat[30];
 
@@ -54,27 +53,23 @@ Image::Image(float x, float y, float z, std::string filename, GLfloat width, GLf
     vertices[2] = vertices[7] = vertices[12] = vertices[17] = vertices[22] = vertices[27] = 0; // z
     vertices[3]  = vertices[4]  = vertices[8] = vertices[18] = vertices[19] = vertices[29] = 1.0; // texture coord x + y
     vertices[9] = vertices[13] = vertices[14] = vertices[23] = vertices[24] = vertices[28] = 0.0; // texture coord x + y
-    init = true;
+    init = (myEntry != nullptr);
     attribMutex.unlock();
 }
 
  /*!
   * \brief Draw the Image.
   * \details This function actually draws the Image to the Canvas.
+  *   The Image's texture is uploaded the first time it is drawn in a Canvas and reused afterwards.
   */
 void Image::draw(Shader * shader) {
     if (!init) {
         TsglDebug("Vertex buffer is not full.");
         return;
     }
+    attribMutex.lock();
 
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(myXScale, myYScale, myZScale));
+    glm::mat4 model = getModelMatrix();
 
     unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
@@ -82,28 +77,15 @@ void Image::draw(Shader * shader) {
     unsigned int alphaLoc = glGetUniformLocation(shader->ID, "alpha");
     glUniform1f(alphaLoc, myAlpha);
 
-    glGenTextures(1, &myTexture);
-    // enable textures and bind the texture id
-    glBindTexture(GL_TEXTURE_2D, myTexture);
-
-    // Set texture parameters for wrapping.
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-    // Set texture parameters for filtering.
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    // actually generate the texture + mipmaps
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);	
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pixelWidth, pixelHeight, 0,
-	           	 GL_RGBA, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    // bind the shared texture, uploading it only if this context hasn't seen it yet
+    if (!TextureCache::bindTexture(myEntry)) {    // still decoding
+        attribMutex.unlock();
+        return;
+    }
 
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 5, vertices, GL_DYNAMIC_DRAW);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    glDeleteTextures(1, &myTexture);
+    attribMutex.unlock();
 }
 
 /**
@@ -117,7 +99,9 @@ void Image::setWidth(GLfloat width) {
     }
     attribMutex.lock();
     myWidth = width;
+    beginTransform();
     myXScale = width;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -132,7 +116,9 @@ void Image::changeWidthBy(GLfloat delta) {
     }
     attribMutex.lock();
     myWidth += delta;
+    beginTransform();
     myXScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -147,7 +133,9 @@ void Image::setHeight(GLfloat height) {
     }
     attribMutex.lock();
     myWidth = height;
+    beginTransform();
     myYScale = height;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -162,26 +150,26 @@ void Image::changeHeightBy(GLfloat delta) {
     }
     attribMutex.lock();
     myHeight += delta;
+    beginTransform();
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
 /*!
  * \brief Alters the file the Image draws.
- * \details Alters the values of the myFile, myWidth, myHeight, and mutates vertices.
+ * \details Alters the values of myFile, pixelWidth, and pixelHeight. The new file is loaded (or shared
+ *   from another Image that already uses it) before the old one is released.
  * \param filename New string value for myFile.
- * \param width New width of the Image.
- * \param height New height of the Image.
  */
 void Image::changeFile(std::string filename) {
+    TextureCache::Entry * entry = TextureCache::acquire(filename);
     attribMutex.lock();
-    init = false;
-    stbi_image_free(data); 
-	// Load the image.
-    stbi_set_flip_vertically_on_load(true);
-    data = stbi_load(filename.c_str(), &pixelWidth, &pixelHeight, 0, 4);
-    tsglAssert(data, "stbi_load(filename) failed.");
-    init = true;
+    TextureCache::release(myEntry);
+    myEntry = entry;
+    myFile = filename;
+    pixelWidth = pixelHeight = 0;
+    init = (myEntry != nullptr);
     attribMutex.unlock();
 }
 
@@ -200,6 +188,93 @@ void Image::setAlpha(float alpha) {
     attribMutex.unlock();
 }
 
+/*!
+ * \brief Accessor for the height of the Image's file in pixels.
+ * \return The number of rows of pixels in the file, or 0 if it hasn't been loaded yet.
+ */
+GLint Image::getPixelHeight() {
+    attribMutex.lock();
+    if (pixelHeight == 0 && TextureCache::isReady(myEntry)) {
+        pixelWidth = myEntry->width;
+        pixelHeight = myEntry->height;
+    }
+    GLint result = pixelHeight;
+    attribMutex.unlockUnchanged();
+    return result;
+}
+
+/*!
+ * \brief Accessor for the width of the Image's file in pixels.
+ * \return The number of columns of pixels in the file, or 0 if it hasn't been loaded yet.
+ */
+GLint Image::getPixelWidth() {
+    attribMutex.lock();
+    if (pixelWidth == 0 && TextureCache::isReady(myEntry)) {
+        pixelWidth = myEntry->width;
+        pixelHeight = myEntry->height;
+    }
+    GLint result = pixelWidth;
+    attribMutex.unlockUnchanged();
+    return result;
+}
+
+/*!
+ * \brief Checks whether the Image's file has been decoded.
+ * \return True if the Image is ready to be drawn, false if it is still loading or failed to load.
+ */
+bool Image::isLoaded() {
+    attribMutex.lock();
+    bool loaded = TextureCache::isReady(myEntry);
+    attribMutex.unlockUnchanged();
+    return loaded;
+}
+
+/*!
+ * \brief Checks whether the Image's file could not be decoded.
+ * \return True if loading the Image has failed, false if it loaded or is still loading.
+ */
+bool Image::loadFailed() {
+    attribMutex.lock();
+    bool failed = !myEntry || TextureCache::hasFailed(myEntry);
+    attribMutex.unlockUnchanged();
+    return failed;
+}
+
+/*!
+ * \brief Blocks until the Image's file has been decoded.
+ * \return True if the Image loaded successfully, false if its file could not be decoded.
+ * \note Returns immediately for Images that were not created asynchronously.
+ */
+bool Image::waitForLoad() {
+    attribMutex.lock();
+    TextureCache::Entry * entry = myEntry;
+    attribMutex.unlock();
+    return TextureCache::wait(entry);
+}
+
+/*!
+ * \brief Replaces the pixels of the Image.
+ * \details The pixels are copied, and the Image's texture is re-uploaded the next time it is drawn.
+ * \param data Tightly packed RGBA pixels of size getPixelWidth() x getPixelHeight(), bottom row first.
+ * \note Every Image drawing the same file shares its pixels, so all of them will show the change.
+ */
+void Image::updatePixels(const unsigned char * data) {
+    attribMutex.lock();
+    TextureCache::updatePixels(myEntry, data);
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Uploads the Image's texture ahead of time.
+ * \details Asks every Canvas to upload the texture at the start of its next frame instead of
+ *   the first time the Image is drawn, avoiding a hitch when a large Image first appears.
+ */
+void Image::prepare() {
+    attribMutex.lock();
+    TextureCache::prepare(myEntry);
+    attribMutex.unlock();
+}
+
 /*!
  * \brief Gets the dimensions of an image
  * \details Loads the header of a .png, .jpeg, or .bmp image to read their dimensions.
@@ -213,9 +288,8 @@ void Image::getFileResolution(std::string filename, int &width, int &height) {
     width = w; height = h;
 }
 
-Image::~Image() { 
-    glDeleteTextures(1, &myTexture);
-    stbi_image_free(data); 
+Image::~Image() {
+    TextureCache::release(myEntry);
 }
 
 
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "Drawable.h"           // For extending our Drawable object
+#include "TextureCache.h"       // For sharing decoded pixels and textures between Images
 #include <stb/stb_image.h>
 #include "TsglAssert.h"      // For unit testing purposes
 
@@ -20,17 +21,21 @@ namespace tsgl {
  *  \note For the time being, there is no way to measure the size of an image once it's loaded.
  *   Therefore, the width and height must be specified manually, and stretching may occur if the
  *   input dimensions don't match the images actual dimensions.
+ *  \details Images drawing the same file share one copy of its pixels and one texture per Canvas (see TextureCache),
+ *   so the file is decoded once and uploaded once rather than on every frame.
+ *  \details An Image constructed with <code>async</code> set returns immediately and is decoded on a pool of
+ *   worker threads (see ImageLoader). It draws nothing until its pixels are ready; use isLoaded() or waitForLoad()
+ *   to find out when that is.
  *  \warning Aside from an error message output to stderr, Image gives no indication if an image failed to load.
  */
 class Image : public Drawable {
  private:
-    unsigned char * data = 0;
+    TextureCache::Entry * myEntry = nullptr;
     GLfloat myWidth, myHeight;
-    GLint pixelWidth, pixelHeight;
+    GLint pixelWidth = 0, pixelHeight = 0;
     std::string myFile;
-    GLuint myTexture;
  public:
-    Image(float x, float y, float z, std::string filename, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha = 1.0f);
+    Image(float x, float y, float z, std::string filename, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha = 1.0f, bool async = false);
 
     virtual void draw(Shader * shader);
 
@@ -58,9 +63,25 @@ class Image : public Drawable {
 
     void setAlpha(float newAlpha);
 
-    GLint getPixelHeight() { return pixelHeight; }
+    void updatePixels(const unsigned char * data);
 
-    GLint getPixelWidth() { return pixelWidth; }
+    void prepare();
+
+    GLint getPixelHeight();
+
+    GLint getPixelWidth();
+
+    bool isLoaded();
+
+    bool waitForLoad();
+
+    bool loadFailed();
+
+    /*!
+     * \brief Accessor for whether the Image is ready to be drawn.
+     * \return True once the Image's pixels have been decoded.
+     */
+    virtual bool isProcessed() { return init && isLoaded(); }
 
     static void getFileResolution(std::string filename, int &width, int &height);
 
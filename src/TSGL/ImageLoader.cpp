@@ -0,0 +1,56 @@
+#include "ImageLoader.h"
+
+namespace tsgl {
+
+ImageLoader::Pool * ImageLoader::pool = nullptr;
+std::once_flag ImageLoader::poolStarted;
+
+ /*!
+  * \brief Queues a job to be run on one of the ImageLoader's worker threads.
+  *   \param job The function to run. Its return value is passed on through the returned future.
+  * \return A future that becomes ready once the job has run.
+  */
+std::shared_future<bool> ImageLoader::submit(const std::function<bool()>& job) {
+    std::call_once(poolStarted, &ImageLoader::start);
+    std::packaged_task<bool()> task(job);
+    std::shared_future<bool> result = task.get_future().share();
+    pool->queueMutex.lock();
+    pool->jobs.push_back(std::move(task));
+    pool->queueMutex.unlock();
+    pool->jobAdded.notify_one();
+    return result;
+}
+
+ /*!
+  * \brief Accessor for the number of worker threads.
+  * \return The number of threads decoding images, starting them if necessary.
+  */
+unsigned ImageLoader::getThreadCount() {
+    std::call_once(poolStarted, &ImageLoader::start);
+    return pool->threadCount;
+}
+
+// Creates the pool with one worker per hardware thread.
+void ImageLoader::start() {
+    pool = new Pool();
+    pool->threadCount = std::thread::hardware_concurrency();
+    if (pool->threadCount == 0)
+        pool->threadCount = 1;
+    for (unsigned i = 0; i < pool->threadCount; i++)
+        std::thread(&ImageLoader::work).detach();
+}
+
+// Runs queued jobs forever.
+void ImageLoader::work() {
+    while (true) {
+        std::unique_lock<std::mutex> lock(pool->queueMutex);
+        while (pool->jobs.empty())
+            pool->jobAdded.wait(lock);
+        std::packaged_task<bool()> task(std::move(pool->jobs.front()));
+        pool->jobs.pop_front();
+        lock.unlock();
+        task();
+    }
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+ * ImageLoader.h provides a pool of worker threads for decoding image files in the background.
+ */
+
+#ifndef IMAGELOADER_H_
+#define IMAGELOADER_H_
+
+#include <condition_variable>   // For waking up idle workers
+#include <deque>
+#include <functional>
+#include <future>               // For handing results back to whoever queued a job
+#include <mutex>                // Needed for locking the job queue for thread-safety
+#include <thread>
+
+namespace tsgl {
+
+/*! \class ImageLoader
+ *  \brief A pool of worker threads that decodes images off of the calling and rendering threads.
+ *  \details ImageLoader runs queued jobs on one worker per hardware thread, so many large files can
+ *    be decoded in parallel instead of one after another on whichever thread created their Images.
+ *  \details Workers are started the first time a job is submitted and live until the program exits.
+ *  \note ImageLoader is used internally by TextureCache when an Image is created asynchronously;
+ *    most users will want the <code>async</code> parameter of Image or Background::drawImage() instead.
+ */
+class ImageLoader {
+ public:
+    static std::shared_future<bool> submit(const std::function<bool()>& job);
+
+    static unsigned getThreadCount();
+ private:
+    struct Pool {
+        std::mutex queueMutex;                              // Protects jobs
+        std::condition_variable jobAdded;                   // Signalled whenever a job is queued
+        std::deque< std::packaged_task<bool()> > jobs;      // Jobs waiting for a worker
+        unsigned threadCount;
+    };
+
+    static Pool * pool;                                     // Never freed, so detached workers can outlive main()
+    static std::once_flag poolStarted;
+
+    static void start();
+
+    static void work();
+};
+
+}
+
+#endif /* IMAGELOADER_H_ */
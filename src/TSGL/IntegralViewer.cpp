@@ -7,7 +7,7 @@ namespace tsgl {
   * \details This is the default constructor for the IntegralViewer class.
   *   \param f A function to integrate and display. The function must accept exactly one argument of type
   *     Decimal, and return a Decimal.
-  *   \param width The width of the window displaying the integration.
+  *   \param width The width of each of the two views of the integration, which share one window.
   *   \param height The height of the window displaying the integration.
   *   \param startX The minimum x-value whose y-value should be computed.
   *   \param stopX The maximum x-value whose y-value should be computed.
@@ -25,28 +25,28 @@ IntegralViewer::IntegralViewer(functionPointer f, int width, int height, Decimal
     myDelay = FRAME;
     std::stringstream ss;
     ss.str("Integral of " + fname + " from " + to_string(myStartX) + " to " + to_string(myStopX));
-    setupCanvas(myTrapCanvas, ss.str() + " using Trapezoids", myDelay); //Canvas for trapezoid method
-    setupCanvas(myRecCanvas, ss.str() + " using Rectangles", myDelay);  //Canvas for rectangle method
+    //One window, with the rectangle method on the left and the trapezoid method on the right
+    myCanvas = new Canvas(-1, -1, 2 * myWidth, myHeight, ss.str(), GRAY, nullptr, myDelay);
+    myRecBackground = setupViewport(0, "Rectangles");
+    myTrapBackground = setupViewport(myWidth, "Trapezoids");
+    myCanvas->start();
 }
 
  /*!
   * \brief IntegralViewer destructor method.
   * \details This is the destructor for the IntegralViewer class.
-  * \details Frees up memory that was allocated to a IntegralViewer instance.
+  * \details Waits for the user to close the IntegralViewer's window, then frees up memory that was allocated
+  *   to a IntegralViewer instance.
   */
 IntegralViewer::~IntegralViewer() {
-    if (myRecCanvas->isOpen())
-        myRecCanvas->stop();
-    if (myTrapCanvas->isOpen())
-        myTrapCanvas->stop();
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-    delete myRecCanvas;
-    delete myTrapCanvas;
+    myCanvas->wait();
+    delete myCanvas;
+    delete myRecBackground;
+    delete myTrapBackground;
 }
 
-void IntegralViewer::drawLabels(CartesianCanvas*& can) {
-    CartesianBackground * bg = can->getBackground();
-    const float /* cpw = can->getPixelWidth(), */ cph = can->getPixelHeight();
+void IntegralViewer::drawLabels(CartesianBackground* bg) {
+    const float /* cpw = bg->getCartWidth() / (myWidth - 1), */ cph = bg->getCartHeight() / (myHeight - 1);
     const float FSIZE = cph * 30;
     const float /* xoff = cpw*FSIZE, */ yoff = cph * 20;
 
@@ -66,21 +66,20 @@ void IntegralViewer::drawLabels(CartesianCanvas*& can) {
         bg->drawText(cph * 10 + cph * 2 * stopYString.size(), myStopY+yoff, 0, stopYString, FONT, FSIZE, 0,0,0, BLACK);
 }
 
-void IntegralViewer::setupCanvas(CartesianCanvas*& can, const std::string& label, double delay) {
+CartesianBackground* IntegralViewer::setupViewport(int x, const std::string& label) {
     const float BORDER = (myStopX-myStartX)/10.0f;
     const float SPACING = BORDER;
-    can = new CartesianCanvas(-1, -1, myWidth, myHeight, myStartX - BORDER, myStartY - BORDER,
-                                myStopX + BORDER, myStopY + BORDER, label, GRAY, delay);
-
-    // can->setBackgroundColor(ColorFloat(0.95f, 0.95f, 0.95f, 1.0f));
-    CartesianBackground * bg = can->getBackground();
-
-    can->start();
+    CartesianBackground * bg = new CartesianBackground(myWidth, myHeight, myStartX - BORDER, myStartY - BORDER,
+                                                       myStopX + BORDER, myStopY + BORDER, GRAY);
+    myCanvas->addViewport(x, 0, myWidth, myHeight, bg);
 
     bg->drawRectangle((myStartX + myStopX)/2,(myStartY+myStopY)/2,0, myStopX - myStartX, myStopY - myStartY, 0,0,0,WHITE);        //Area we're drawing to
     bg->drawPartialFunction(myF,myStartX,myStopX,ColorInt(0,0,255)); //Outline of function
     bg->drawAxes(0, 0, SPACING, SPACING);                              //Axes marks
-    drawLabels(can);
+    drawLabels(bg);
+    const float cph = bg->getCartHeight() / (myHeight - 1);
+    bg->drawText((myStartX + myStopX)/2, myStopY + BORDER/2, 0, label, FONT, cph * 30, 0,0,0, BLACK);  //Which method this is
+    return bg;
 }
 
  /*!
@@ -90,7 +89,7 @@ void IntegralViewer::setupCanvas(CartesianCanvas*& can, const std::string& label
   *   the rectangle method.
   */
 long double IntegralViewer::rectangleEvaluate(long long numRectangles) {
-    CartesianBackground * bg = myRecCanvas->getBackground();
+    CartesianBackground * bg = myRecBackground;
     double startTime = omp_get_wtime();
     long double result = 0.0,
                 recWidth = fabs(myStopX - myStartX) / numRectangles,
@@ -103,8 +102,8 @@ long double IntegralViewer::rectangleEvaluate(long long numRectangles) {
 
         #pragma omp for
         for (long long i = 0; i < numRectangles; ++i) {
-            if (!myRecCanvas->isOpen()) continue;
-            myRecCanvas->sleep();
+            if (!myCanvas->isOpen()) continue;
+            myCanvas->sleep();
             xLo = myStartX + i  * recWidth;
             xMid = xLo + halfRecWidth;
             y = (*myF)(xMid);
@@ -114,7 +113,6 @@ long double IntegralViewer::rectangleEvaluate(long long numRectangles) {
         result *= recWidth;
     }
     myRecTime = omp_get_wtime() - startTime;
-    myRecCanvas->wait();
     return result;
 }
 
@@ -125,7 +123,7 @@ long double IntegralViewer::rectangleEvaluate(long long numRectangles) {
   *   the trapezoid method.
   */
 long double IntegralViewer::trapezoidEvaluate(long long numTrapezoids) {
-    CartesianBackground * cart = myTrapCanvas->getBackground();
+    CartesianBackground * cart = myTrapBackground;
     double startTime = omp_get_wtime();
     long double result = 0.0,
                 trapWidth = fabs(myStopX - myStartX) / numTrapezoids,
@@ -140,7 +138,7 @@ long double IntegralViewer::trapezoidEvaluate(long long numTrapezoids) {
 
         #pragma omp for
         for (long long i = 0; i < numTrapezoids; ++i) {
-            if (!myTrapCanvas->isOpen()) continue;
+            if (!myCanvas->isOpen()) continue;
             leftX = myStartX + i * trapWidth;
             rightX = leftX + trapWidth;
             leftY = (*myF)(leftX);
@@ -154,11 +152,10 @@ long double IntegralViewer::trapezoidEvaluate(long long numTrapezoids) {
             centerY = (leftY + rightY) / 2;
 
             cart->drawConvexPolygon(centerX, centerY, 0, 4, xValues, yValues, 0,0,0, tcol);
-            myTrapCanvas->sleep();
+            myCanvas->sleep();
         }
     }
     myTrapTime = omp_get_wtime() - startTime;
-    myTrapCanvas->wait();
     return result;
 }
 
@@ -19,7 +19,7 @@ namespace tsgl {
  *    integration, both numerically and visually. IntegralViewer can evaluate an arbitrary function of the type
  *    <code>Decimal myFunction(Decimal x)</code>, where x is the input value of the function and the return value is
  *    the y value of the function. IntegralViewer can compute integrals using one or both of the rectangle method
- *    and the trapezoid method, and provides functions for displaying both on a custom Canvas. Furthermore, these
+ *    and the trapezoid method, and displays both side by side in one window. Furthermore, these
  *    computations and visualizations are thread-safe; the number of threads to use can be set with
  *    <code>omp_set_num_threads()</code>.
  */
@@ -29,10 +29,11 @@ private:
   int myWidth, myHeight;
   long double myStartX, myStopX, myStartY, myStopY;
   double myRecTime, myTrapTime, myDelay;
-  CartesianCanvas *myRecCanvas, *myTrapCanvas;
+  Canvas *myCanvas;
+  CartesianBackground *myRecBackground, *myTrapBackground;
 
-  void drawLabels(CartesianCanvas*& can);
-  void setupCanvas(CartesianCanvas*& can, const std::string& label = "", double delay = 0.0);
+  void drawLabels(CartesianBackground* bg);
+  CartesianBackground* setupViewport(int x, const std::string& label);
 
 public:
 
@@ -133,6 +133,7 @@ void Line::setFirstEndpoint(float x, float y, float z) {
     attribMutex.lock();
     myEndpointX1 = x; myEndpointY1 = y; myEndpointZ1 = z;
     myLength = sqrt(pow(myEndpointX2 - myEndpointX1, 2) + pow(myEndpointY2 - myEndpointY1, 2) + pow(myEndpointZ2 - myEndpointZ1, 2));
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointX = (myEndpointX2 + myEndpointX1) / 2;
         myRotationPointY = (myEndpointY2 + myEndpointY1) / 2;
@@ -154,6 +155,7 @@ void Line::setFirstEndpoint(float x, float y, float z) {
     vertices[7] = myEndpointX2 - myCenterX;
     vertices[8] = myEndpointY2 - myCenterY;
     vertices[9] = myEndpointZ2 - myCenterZ;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -170,6 +172,7 @@ void Line::setSecondEndpoint(float x, float y, float z) {
     attribMutex.lock();
     myEndpointX2 = x; myEndpointY2 = y; myEndpointZ2 = z;
     myLength = sqrt(pow(myEndpointX2 - myEndpointX1, 2) + pow(myEndpointY2 - myEndpointY1, 2) + pow(myEndpointZ2 - myEndpointZ1, 2));
+    beginTransform();
     if (centerMatchesRotationPoint()) {
         myRotationPointX = (myEndpointX2 + myEndpointX1) / 2;
         myRotationPointY = (myEndpointY2 + myEndpointY1) / 2;
@@ -191,6 +194,7 @@ void Line::setSecondEndpoint(float x, float y, float z) {
     vertices[7] = myEndpointX2 - myCenterX;
     vertices[8] = myEndpointY2 - myCenterY;
     vertices[9] = myEndpointZ2 - myCenterZ;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -244,25 +248,26 @@ void Line::changeLengthBy(GLfloat delta) {
  */
 GLfloat Line::getFirstEndpointX() { 
     attribMutex.lock();
+    Transform t = getTransform();
     float ex1;
-    if (myEndpointX1 == myRotationPointX && myEndpointY1 == myRotationPointY && myEndpointZ1 == myRotationPointZ) {
+    if (myEndpointX1 == t.rotationX && myEndpointY1 == t.rotationY && myEndpointZ1 == t.rotationZ) {
         ex1 = myEndpointX1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ex1;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ex1 = myEndpointX1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ex1;
     }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ex1 = cosYaw * cosPitch * (myEndpointX1 - myRotationPointX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myEndpointY1 - myRotationPointY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myEndpointZ1 - myRotationPointZ) + myRotationPointX;
-    attribMutex.unlock();
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ex1 = cosYaw * cosPitch * (myEndpointX1 - t.rotationX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myEndpointY1 - t.rotationY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myEndpointZ1 - t.rotationZ) + t.rotationX;
+    attribMutex.unlockUnchanged();
     return ex1;
 }
 
@@ -273,25 +278,26 @@ GLfloat Line::getFirstEndpointX() {
  */
 GLfloat Line::getFirstEndpointY() { 
     attribMutex.lock();
+    Transform t = getTransform();
     float ey1;
-    if (myEndpointX1 == myRotationPointX && myEndpointY1 == myRotationPointY && myEndpointZ1 == myRotationPointZ) {
+    if (myEndpointX1 == t.rotationX && myEndpointY1 == t.rotationY && myEndpointZ1 == t.rotationZ) {
         ey1 = myEndpointY1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ey1;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ey1 = myEndpointY1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ey1;
     }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ey1 = sinYaw * cosPitch * (myEndpointX1 - myRotationPointX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myEndpointY1 - myRotationPointY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myEndpointZ1 - myRotationPointZ)  + myRotationPointY;
-    attribMutex.unlock();
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ey1 = sinYaw * cosPitch * (myEndpointX1 - t.rotationX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myEndpointY1 - t.rotationY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myEndpointZ1 - t.rotationZ)  + t.rotationY;
+    attribMutex.unlockUnchanged();
     return ey1;
 }
 
@@ -302,23 +308,24 @@ GLfloat Line::getFirstEndpointY() {
  */
 GLfloat Line::getFirstEndpointZ() { 
     attribMutex.lock();
+    Transform t = getTransform();
     float ez1;
-    if (myEndpointX1 == myRotationPointX && myEndpointY1 == myRotationPointY && myEndpointZ1 == myRotationPointZ) {
+    if (myEndpointX1 == t.rotationX && myEndpointY1 == t.rotationY && myEndpointZ1 == t.rotationZ) {
         ez1 = myEndpointZ1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ez1;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ez1 = myEndpointZ1;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ez1;
     }
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ez1 = -sinPitch * (myEndpointX1 - myRotationPointX) + cosPitch * sinRoll * (myEndpointY1 - myRotationPointY) + cosPitch * cosRoll * (myEndpointZ1 - myRotationPointZ) + myRotationPointZ;
-    attribMutex.unlock();
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ez1 = -sinPitch * (myEndpointX1 - t.rotationX) + cosPitch * sinRoll * (myEndpointY1 - t.rotationY) + cosPitch * cosRoll * (myEndpointZ1 - t.rotationZ) + t.rotationZ;
+    attribMutex.unlockUnchanged();
     return ez1; 
 }
 
@@ -329,25 +336,26 @@ GLfloat Line::getFirstEndpointZ() {
  */
 GLfloat Line::getSecondEndpointX() { 
     attribMutex.lock();
+    Transform t = getTransform();
     float ex2;
-    if (myEndpointX2 == myRotationPointX && myEndpointY2 == myRotationPointY && myEndpointZ2 == myRotationPointZ) {
+    if (myEndpointX2 == t.rotationX && myEndpointY2 == t.rotationY && myEndpointZ2 == t.rotationZ) {
         ex2 = myEndpointX2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ex2;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ex2 = myEndpointX2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ex2;
     }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ex2 = cosYaw * cosPitch * (myEndpointX2 - myRotationPointX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myEndpointY2 - myRotationPointY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myEndpointZ2 - myRotationPointZ) + myRotationPointX;
-    attribMutex.unlock();
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ex2 = cosYaw * cosPitch * (myEndpointX2 - t.rotationX) + (cosYaw * sinPitch * sinRoll - sinYaw * cosRoll) * (myEndpointY2 - t.rotationY) + (cosYaw * sinPitch * cosRoll + sinYaw * sinRoll) * (myEndpointZ2 - t.rotationZ) + t.rotationX;
+    attribMutex.unlockUnchanged();
     return ex2; 
 }
 
@@ -358,25 +366,26 @@ GLfloat Line::getSecondEndpointX() {
  */
 GLfloat Line::getSecondEndpointY() { 
     attribMutex.lock();
+    Transform t = getTransform();
     float ey2;
-    if (myEndpointX2 == myRotationPointX && myEndpointY2 == myRotationPointY && myEndpointZ2 == myRotationPointZ) {
+    if (myEndpointX2 == t.rotationX && myEndpointY2 == t.rotationY && myEndpointZ2 == t.rotationZ) {
         ey2 = myEndpointY2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ey2;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ey2 = myEndpointY2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ey2;
     }
-    float cosYaw = cos(myCurrentYaw * PI / 180);
-    float sinYaw = sin(myCurrentYaw * PI / 180);
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ey2 = sinYaw * cosPitch * (myEndpointX2 - myRotationPointX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myEndpointY2 - myRotationPointY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myEndpointZ2 - myRotationPointZ)  + myRotationPointY;
-    attribMutex.unlock();
+    float cosYaw = cos(t.yaw * PI / 180);
+    float sinYaw = sin(t.yaw * PI / 180);
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ey2 = sinYaw * cosPitch * (myEndpointX2 - t.rotationX) + (sinYaw * sinPitch * sinRoll + cosYaw * cosRoll) * (myEndpointY2 - t.rotationY) + (sinYaw * sinPitch * cosRoll - cosYaw * sinRoll) * (myEndpointZ2 - t.rotationZ)  + t.rotationY;
+    attribMutex.unlockUnchanged();
     return ey2; 
 }
 
@@ -387,23 +396,24 @@ GLfloat Line::getSecondEndpointY() {
  */
 GLfloat Line::getSecondEndpointZ() { 
     attribMutex.lock();
+    Transform t = getTransform();
     float ez2;
-    if (myEndpointX2 == myRotationPointX && myEndpointY2 == myRotationPointY && myEndpointZ2 == myRotationPointZ) {
+    if (myEndpointX2 == t.rotationX && myEndpointY2 == t.rotationY && myEndpointZ2 == t.rotationZ) {
         ez2 = myEndpointZ2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ez2;
     }
-    if (myCurrentYaw == 0 && myCurrentPitch == 0 && myCurrentRoll == 0) {
+    if (t.yaw == 0 && t.pitch == 0 && t.roll == 0) {
         ez2 = myEndpointZ2;
-        attribMutex.unlock();
+        attribMutex.unlockUnchanged();
         return ez2;
     }
-    float cosPitch = cos(myCurrentPitch * PI / 180);
-    float sinPitch = sin(myCurrentPitch * PI / 180);
-    float cosRoll = cos(myCurrentPitch * PI / 180);
-    float sinRoll = sin(myCurrentRoll * PI / 180);
-    ez2 = -sinPitch * (myEndpointX2 - myRotationPointX) + cosPitch * sinRoll * (myEndpointY2 - myRotationPointY) + cosPitch * cosRoll * (myEndpointZ2 - myRotationPointZ) + myRotationPointZ;
-    attribMutex.unlock();
+    float cosPitch = cos(t.pitch * PI / 180);
+    float sinPitch = sin(t.pitch * PI / 180);
+    float cosRoll = cos(t.pitch * PI / 180);
+    float sinRoll = sin(t.roll * PI / 180);
+    ez2 = -sinPitch * (myEndpointX2 - t.rotationX) + cosPitch * sinRoll * (myEndpointY2 - t.rotationY) + cosPitch * cosRoll * (myEndpointZ2 - t.rotationZ) + t.rotationZ;
+    attribMutex.unlockUnchanged();
     return ez2;
 }
 
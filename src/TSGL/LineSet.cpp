@@ -0,0 +1,314 @@
+#include "LineSet.h"
+#include "RenderService.h"  // For the context that owns our GL objects
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new, empty LineSet.
+  * \details This is the explicit constructor for the LineSet class.
+  *   \param x The x coordinate of the LineSet's center.
+  *   \param y The y coordinate of the LineSet's center.
+  *   \param z The z coordinate of the LineSet's center.
+  *   \param yaw The LineSet's yaw.
+  *   \param pitch The LineSet's pitch.
+  *   \param roll The LineSet's roll.
+  *   \param color The color of segments appended without a color of their own.
+  *   \param capacity The number of segments to reserve space for (optional). The LineSet grows as needed either way.
+  * \return A new LineSet with no segments.
+  */
+LineSet::LineSet(float x, float y, float z, float yaw, float pitch, float roll, ColorFloat color, int capacity) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    vertices = nullptr;
+    myXScale = myYScale = myZScale = 1;
+    myFormat = VERTEX_UNIFORM;
+    myColor = color;
+    myAlpha = color.A;
+    mySize = 0;
+    dirtyFirst = dirtyLast = 0;
+    needsRealloc = true;
+    myContext = nullptr;
+    myBuffer = 0;
+    myBufferSize = 0;
+    if (capacity > 0)
+        mySegments.reserve((size_t) capacity * 2 * floatsPerVertex(myFormat));
+    init = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Draw the LineSet.
+  * \details This function actually draws the LineSet to the Canvas, first uploading any segments
+  *   that have changed since the last frame.
+  */
+void LineSet::draw(Shader * shader) {
+    attribMutex.lock();
+    if (mySize == 0) {
+        attribMutex.unlock();
+        return;
+    }
+    glm::mat4 model = getModelMatrix();
+
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    if (!myBuffer) {
+        myContext = RenderService::currentContext();
+        glGenBuffers(1, &myBuffer);
+        needsRealloc = true;
+    }
+    GLint previousBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, myBuffer);
+
+    size_t segmentSize = 2 * floatsPerVertex(myFormat) * sizeof(GLfloat);
+    size_t used = mySize * segmentSize;
+    if (needsRealloc || used > myBufferSize) {
+        // Allocate for the whole reserved capacity, so that appends up to it only need a partial upload
+        myBufferSize = mySegments.capacity() * sizeof(GLfloat);
+        glBufferData(GL_ARRAY_BUFFER, myBufferSize, NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, used, mySegments.data());
+    } else if (dirtyFirst < dirtyLast) {
+        glBufferSubData(GL_ARRAY_BUFFER, dirtyFirst * segmentSize, (dirtyLast - dirtyFirst) * segmentSize,
+                        mySegments.data() + (size_t) dirtyFirst * 2 * floatsPerVertex(myFormat));
+    }
+    needsRealloc = false;
+    dirtyFirst = dirtyLast = 0;
+
+    useVertexFormat(shader, myFormat, myColor);
+    glDrawArrays(GL_LINES, 0, mySize * 2);
+
+    // The attribute pointers remember the buffer bound when they are set, so rebind the shared one first
+    glBindBuffer(GL_ARRAY_BUFFER, previousBuffer);
+    restoreVertexFormat(shader);
+    attribMutex.unlock();
+}
+
+// Widens the range of segments to upload on the next draw. attribMutex must be held.
+void LineSet::markDirty(int first, int last) {
+    if (dirtyFirst == dirtyLast) {
+        dirtyFirst = first;
+        dirtyLast = last;
+    } else {
+        if (first < dirtyFirst) dirtyFirst = first;
+        if (last > dirtyLast) dirtyLast = last;
+    }
+}
+
+// Writes the endpoints of an existing segment, leaving its colors alone. attribMutex must be held.
+void LineSet::writeSegment(int index, GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2) {
+    int stride = floatsPerVertex(myFormat);
+    GLfloat * v = mySegments.data() + (size_t) index * 2 * stride;
+    v[0] = x1; v[1] = y1; v[2] = z1;
+    v[stride] = x2; v[stride + 1] = y2; v[stride + 2] = z2;
+}
+
+// Gives every segment its own copy of myColor so that segments can be recolored individually. attribMutex must be held.
+void LineSet::packSegments() {
+    std::vector<GLfloat> packed;
+    packed.reserve(mySegments.capacity() / 3 * PACKED_VERTEX_FLOATS);
+    packed.resize((size_t) mySize * 2 * PACKED_VERTEX_FLOATS);
+    for (int i = 0; i < mySize * 2; i++) {
+        GLfloat * v = packed.data() + (size_t) i * PACKED_VERTEX_FLOATS;
+        v[0] = mySegments[i*3];
+        v[1] = mySegments[i*3 + 1];
+        v[2] = mySegments[i*3 + 2];
+        packColor(v + 3, myColor);
+    }
+    mySegments.swap(packed);
+    myFormat = VERTEX_PACKED;
+    needsRealloc = true;
+}
+
+ /*!
+  * \brief Adds a segment drawn in the LineSet's color.
+  *   \param x1 The x coordinate of the segment's first endpoint.
+  *   \param y1 The y coordinate of the segment's first endpoint.
+  *   \param z1 The z coordinate of the segment's first endpoint.
+  *   \param x2 The x coordinate of the segment's second endpoint.
+  *   \param y2 The y coordinate of the segment's second endpoint.
+  *   \param z2 The z coordinate of the segment's second endpoint.
+  * \return The index of the new segment.
+  */
+int LineSet::append(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2) {
+    attribMutex.lock();
+    int index = mySize++;
+    mySegments.resize((size_t) mySize * 2 * floatsPerVertex(myFormat));
+    writeSegment(index, x1, y1, z1, x2, y2, z2);
+    if (myFormat == VERTEX_PACKED) {
+        packColor(mySegments.data() + (size_t) index * 2 * PACKED_VERTEX_FLOATS + 3, myColor);
+        packColor(mySegments.data() + (size_t) index * 2 * PACKED_VERTEX_FLOATS + 7, myColor);
+    }
+    markDirty(index, mySize);
+    attribMutex.unlock();
+    return index;
+}
+
+ /*!
+  * \brief Adds a segment with its own color.
+  *   \param x1 The x coordinate of the segment's first endpoint.
+  *   \param y1 The y coordinate of the segment's first endpoint.
+  *   \param z1 The z coordinate of the segment's first endpoint.
+  *   \param x2 The x coordinate of the segment's second endpoint.
+  *   \param y2 The y coordinate of the segment's second endpoint.
+  *   \param z2 The z coordinate of the segment's second endpoint.
+  *   \param color The color of the segment.
+  * \return The index of the new segment.
+  */
+int LineSet::append(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2, ColorFloat color) {
+    int index = append(x1, y1, z1, x2, y2, z2);
+    setSegmentColor(index, color);
+    return index;
+}
+
+ /*!
+  * \brief Adds many segments drawn in the LineSet's color.
+  *   \param count The number of segments to add.
+  *   \param segments 6 floats per segment: x1, y1, z1, x2, y2, z2.
+  * \return The index of the first new segment.
+  */
+int LineSet::append(int count, const GLfloat segments[]) {
+    attribMutex.lock();
+    int first = mySize;
+    if (count > 0) {
+        mySize += count;
+        mySegments.resize((size_t) mySize * 2 * floatsPerVertex(myFormat));
+        for (int i = 0; i < count; i++) {
+            const GLfloat * s = segments + (size_t) i * 6;
+            writeSegment(first + i, s[0], s[1], s[2], s[3], s[4], s[5]);
+            if (myFormat == VERTEX_PACKED) {
+                packColor(mySegments.data() + (size_t) (first + i) * 2 * PACKED_VERTEX_FLOATS + 3, myColor);
+                packColor(mySegments.data() + (size_t) (first + i) * 2 * PACKED_VERTEX_FLOATS + 7, myColor);
+            }
+        }
+        markDirty(first, mySize);
+    }
+    attribMutex.unlock();
+    return first;
+}
+
+ /*!
+  * \brief Moves the endpoints of an existing segment.
+  *   \param index The index of the segment, as returned by append().
+  *   \param x1 The new x coordinate of the segment's first endpoint.
+  *   \param y1 The new y coordinate of the segment's first endpoint.
+  *   \param z1 The new z coordinate of the segment's first endpoint.
+  *   \param x2 The new x coordinate of the segment's second endpoint.
+  *   \param y2 The new y coordinate of the segment's second endpoint.
+  *   \param z2 The new z coordinate of the segment's second endpoint.
+  */
+void LineSet::update(int index, GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2) {
+    GLfloat segment[6] = { x1, y1, z1, x2, y2, z2 };
+    update(index, 1, segment);
+}
+
+ /*!
+  * \brief Moves the endpoints of a range of existing segments.
+  * \details Only the changed range is uploaded on the next frame.
+  *   \param first The index of the first segment to move.
+  *   \param count The number of segments to move.
+  *   \param segments 6 floats per segment: x1, y1, z1, x2, y2, z2.
+  */
+void LineSet::update(int first, int count, const GLfloat segments[]) {
+    attribMutex.lock();
+    if (first < 0 || count < 0 || first + count > mySize) {
+        TsglDebug("Cannot update segments outside of a LineSet.");
+        attribMutex.unlock();
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        const GLfloat * s = segments + (size_t) i * 6;
+        writeSegment(first + i, s[0], s[1], s[2], s[3], s[4], s[5]);
+    }
+    markDirty(first, first + count);
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Gives one segment its own color.
+  *   \param index The index of the segment, as returned by append().
+  *   \param color The new color of the segment.
+  */
+void LineSet::setSegmentColor(int index, ColorFloat color) {
+    attribMutex.lock();
+    if (index < 0 || index >= mySize) {
+        TsglDebug("Cannot color a segment outside of a LineSet.");
+        attribMutex.unlock();
+        return;
+    }
+    if (myFormat == VERTEX_UNIFORM)
+        packSegments();
+    packColor(mySegments.data() + (size_t) index * 2 * PACKED_VERTEX_FLOATS + 3, color);
+    packColor(mySegments.data() + (size_t) index * 2 * PACKED_VERTEX_FLOATS + 7, color);
+    markDirty(index, index + 1);
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Removes every segment.
+  * \details The LineSet keeps its allocated space, so refilling it to the same size does not allocate again.
+  */
+void LineSet::clear() {
+    attribMutex.lock();
+    mySegments.clear();
+    mySize = 0;
+    dirtyFirst = dirtyLast = 0;
+    if (myFormat == VERTEX_PACKED) {
+        myFormat = VERTEX_UNIFORM;
+        needsRealloc = true;
+    }
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Accessor for the number of segments.
+  * \return The number of segments in the LineSet.
+  */
+int LineSet::size() {
+    attribMutex.lock();
+    int s = mySize;
+    attribMutex.unlock();
+    return s;
+}
+
+ /*!
+  * \brief Sets every segment to one color.
+  * \details Segments that had their own colors lose them.
+  *   \param c The new color of the LineSet.
+  */
+void LineSet::setColor(ColorFloat c) {
+    attribMutex.lock();
+    myColor = c;
+    myAlpha = c.A;
+    if (myFormat == VERTEX_PACKED) {
+        std::vector<GLfloat> positions;
+        positions.reserve(mySegments.capacity() / PACKED_VERTEX_FLOATS * 3);
+        positions.resize((size_t) mySize * 2 * 3);
+        for (int i = 0; i < mySize * 2; i++) {
+            positions[i*3] = mySegments[i * PACKED_VERTEX_FLOATS];
+            positions[i*3 + 1] = mySegments[i * PACKED_VERTEX_FLOATS + 1];
+            positions[i*3 + 2] = mySegments[i * PACKED_VERTEX_FLOATS + 2];
+        }
+        mySegments.swap(positions);
+        myFormat = VERTEX_UNIFORM;
+        needsRealloc = true;
+    }
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Accessor for the LineSet's color.
+  * \return The color of segments that do not have their own color.
+  */
+ColorFloat LineSet::getColor() {
+    attribMutex.lock();
+    ColorFloat c = myColor;
+    attribMutex.unlockUnchanged();
+    return c;
+}
+
+LineSet::~LineSet() {
+    // We may not be on the render thread, so let it delete the buffer.
+    TextureCache::deleteBufferLater(myContext, myBuffer);
+}
+
+}
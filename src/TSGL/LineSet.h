@@ -0,0 +1,73 @@
+/*
+ * LineSet.h extends Drawable and provides a class for drawing large numbers of independent line segments.
+ */
+
+#ifndef LINESET_H_
+#define LINESET_H_
+
+#include <vector>               // For the growable segment storage
+
+#include "Drawable.h"           // For extending our Drawable object
+#include "TextureCache.h"       // For deleting GL objects on the render thread
+
+namespace tsgl {
+
+/*! \class LineSet
+ *  \brief Draw any number of separate line segments with one draw call.
+ *  \details LineSet holds all of its segments in one contiguous buffer and draws them with a single
+ *   GL_LINES call, so a graph with hundreds of thousands of edges costs one Drawable instead of one Line per edge.
+ *  \details Segments are given relative to the LineSet's center. They may be appended, replaced in place,
+ *   or cleared at any time; only the segments changed since the last frame are uploaded again.
+ *  \details Segments appended without a color are drawn in the LineSet's color, and take up 24 bytes each.
+ *   Giving any segment its own color stores a packed color with every vertex (32 bytes per segment) until
+ *   setColor() gives the whole set one color again.
+ *  \note A LineSet should only be added to one Canvas.
+ */
+class LineSet : public Drawable {
+ private:
+    std::vector<GLfloat> mySegments;    // Two vertices per segment, in myFormat's layout
+    VertexFormat myFormat;
+    ColorFloat myColor;                 // Color of every segment when myFormat is VERTEX_UNIFORM
+    int mySize;                         // Number of segments
+
+    int dirtyFirst, dirtyLast;          // Segments changed since the last upload, as [first, last)
+    bool needsRealloc;                  // Whether the buffer must be recreated rather than updated
+
+    GLFWwindow * myContext;             // Context the buffer below was created in
+    GLuint myBuffer;
+    size_t myBufferSize;                // Bytes allocated for myBuffer
+
+    void markDirty(int first, int last);
+    void writeSegment(int index, GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2);
+    void packSegments();
+ public:
+    LineSet(float x, float y, float z, float yaw, float pitch, float roll, ColorFloat color, int capacity = 0);
+
+    virtual void draw(Shader * shader);
+
+    int append(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2);
+
+    int append(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2, ColorFloat color);
+
+    int append(int count, const GLfloat segments[]);
+
+    void update(int index, GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2);
+
+    void update(int first, int count, const GLfloat segments[]);
+
+    void setSegmentColor(int index, ColorFloat color);
+
+    void clear();
+
+    int size();
+
+    virtual void setColor(ColorFloat c);
+
+    virtual ColorFloat getColor();
+
+    virtual ~LineSet();
+};
+
+}
+
+#endif /* LINESET_H_ */
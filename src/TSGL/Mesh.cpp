@@ -0,0 +1,649 @@
+#include "Mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>     // For mapping mesh files
+  #include <unistd.h>
+#endif
+#include <omp.h>            // For parsing in parallel
+
+#include "RenderService.h"  // For the context that owns our buffers
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new Mesh from a file.
+  * \details This is the explicit constructor for the Mesh class. The file is loaded before the constructor returns.
+  *   \param x The x coordinate of the Mesh's center.
+  *   \param y The y coordinate of the Mesh's center.
+  *   \param z The z coordinate of the Mesh's center.
+  *   \param filename The Wavefront OBJ (".obj") or binary PLY (".ply") file to load. The format is
+  *     chosen by the file's contents, not its name.
+  *   \param scale The factor by which the coordinates in the file are multiplied.
+  *   \param yaw The Mesh's yaw.
+  *   \param pitch The Mesh's pitch.
+  *   \param roll The Mesh's roll.
+  *   \param color The color of the Mesh (optional, WHITE by default). If the file gives each vertex a color,
+  *     they are multiplied by this color.
+  * \return A new Mesh holding the file's triangles, or no triangles if the file could not be loaded.
+  */
+Mesh::Mesh(float x, float y, float z, std::string filename, float scale, float yaw, float pitch, float roll, ColorFloat color) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    vertices = nullptr;
+    myXScale = myYScale = myZScale = scale;
+    myColor = color;
+    myAlpha = color.A;
+    numberOfVertices = numberOfTriangles = 0;
+    myContext = nullptr;
+    myBuffers[0] = myBuffers[1] = 0;
+
+    size_t size;
+    const char * data = mapFile(filename, size);
+    if (!data) {
+        TsglErr("Could not open mesh " + filename + ".");
+    } else {
+        std::vector<GLfloat> positions;
+        std::vector<GLubyte> colors;
+        bool loaded;
+        if (size >= 4 && memcmp(data, "ply", 3) == 0 && (data[3] == '\n' || data[3] == '\r'))
+            loaded = loadPly(data, size, positions, colors);
+        else
+            loaded = loadObj(data, size, positions);
+        unmapFile(data, size);
+        if (loaded)
+            build(positions, colors);
+        else
+            TsglErr("Could not load mesh " + filename + ".");
+    }
+    init = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Explicitly constructs a new Mesh from arrays of vertices and triangles.
+  * \details This is the explicit constructor for the Mesh class.
+  *   \param x The x coordinate of the Mesh's center.
+  *   \param y The y coordinate of the Mesh's center.
+  *   \param z The z coordinate of the Mesh's center.
+  *   \param numVertices The number of vertices.
+  *   \param vertices 3 floats per vertex, x-y-z, relative to the Mesh's center.
+  *   \param numTriangles The number of triangles.
+  *   \param indices 3 indices into vertices per triangle.
+  *   \param yaw The Mesh's yaw.
+  *   \param pitch The Mesh's pitch.
+  *   \param roll The Mesh's roll.
+  *   \param color The color of the Mesh (optional, WHITE by default).
+  * \return A new Mesh with the given triangles.
+  * \note The arrays are copied, so they may be freed as soon as this returns.
+  */
+Mesh::Mesh(float x, float y, float z, int numVertices, const GLfloat vertices[], int numTriangles, const GLuint indices[], float yaw, float pitch, float roll, ColorFloat color) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    this->vertices = nullptr;
+    myXScale = myYScale = myZScale = 1;
+    myColor = color;
+    myAlpha = color.A;
+    numberOfVertices = numberOfTriangles = 0;
+    myContext = nullptr;
+    myBuffers[0] = myBuffers[1] = 0;
+    if (numVertices > 0 && numTriangles > 0) {
+        std::vector<GLfloat> positions(vertices, vertices + (size_t) numVertices * 3);
+        myIndices.assign(indices, indices + (size_t) numTriangles * 3);
+        build(positions, std::vector<GLubyte>());
+    }
+    init = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Draw the Mesh.
+  * \details This function actually draws the Mesh to the Canvas. The first time it is called,
+  *   the Mesh's vertices and indices are uploaded and its own copies of them freed.
+  */
+void Mesh::draw(Shader * shader) {
+    attribMutex.lock();
+    if (numberOfTriangles == 0) {
+        attribMutex.unlock();
+        return;
+    }
+    glm::mat4 model = getModelMatrix();
+
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    GLint previousBuffer, previousElements;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &previousElements);
+    if (!myBuffers[0]) {
+        myContext = RenderService::currentContext();
+        glGenBuffers(2, myBuffers);
+        glBindBuffer(GL_ARRAY_BUFFER, myBuffers[0]);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * myVertices.size(), myVertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, myBuffers[1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * myIndices.size(), myIndices.data(), GL_STATIC_DRAW);
+        std::vector<GLfloat>().swap(myVertices);
+        std::vector<GLuint>().swap(myIndices);
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, myBuffers[0]);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, myBuffers[1]);
+    }
+
+    GLint tintLoc = glGetUniformLocation(shader->ID, "tint");
+    glUniform4f(tintLoc, myColor.R, myColor.G, myColor.B, myColor.A);
+    useVertexFormat(shader, VERTEX_PACKED, myColor);
+    glDrawElements(GL_TRIANGLES, numberOfTriangles * 3, GL_UNSIGNED_INT, (void*)0);
+    glUniform4f(tintLoc, 1.0f, 1.0f, 1.0f, 1.0f);
+
+    // The VAO remembers which buffer each attribute reads from, so point them back at the shared buffers.
+    glBindBuffer(GL_ARRAY_BUFFER, previousBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, previousElements);
+    restoreVertexFormat(shader);
+    attribMutex.unlock();
+}
+
+// Shades positions by a fixed light from their normals into myVertices, and checks myIndices against them.
+// colors holds 4 bytes per vertex, or is empty for white vertices. attribMutex must be held.
+void Mesh::build(const std::vector<GLfloat>& positions, const std::vector<GLubyte>& colors) {
+    int n = positions.size() / 3, t = myIndices.size() / 3;
+    bool valid = true;
+    #pragma omp parallel for reduction(&&:valid)
+    for (int i = 0; i < t * 3; i++)
+        valid = valid && myIndices[i] < (GLuint) n;
+    if (!valid) {
+        TsglErr("Mesh has triangles with vertices that do not exist.");
+        myIndices.clear();
+        return;
+    }
+
+    // Area-weighted vertex normals: the cross product of two edges is twice the triangle's area
+    std::vector<GLfloat> normals((size_t) n * 3, 0.0f);
+    for (int i = 0; i < t; i++) {
+        const GLfloat * a = &positions[myIndices[i*3] * 3];
+        const GLfloat * b = &positions[myIndices[i*3 + 1] * 3];
+        const GLfloat * c = &positions[myIndices[i*3 + 2] * 3];
+        GLfloat u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        GLfloat v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        GLfloat cross[3] = { u[1]*v[2] - u[2]*v[1], u[2]*v[0] - u[0]*v[2], u[0]*v[1] - u[1]*v[0] };
+        for (int j = 0; j < 3; j++) {
+            GLfloat * normal = &normals[myIndices[i*3 + j] * 3];
+            normal[0] += cross[0];
+            normal[1] += cross[1];
+            normal[2] += cross[2];
+        }
+    }
+
+    const GLfloat LIGHT[3] = { 0.40f, 0.80f, 0.45f };      // Roughly unit length, above and in front
+    myVertices.resize((size_t) n * PACKED_VERTEX_FLOATS);
+    #pragma omp parallel for
+    for (int i = 0; i < n; i++) {
+        const GLfloat * normal = &normals[(size_t) i * 3];
+        GLfloat length = sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+        GLfloat shade = 1.0f;
+        if (length > 0)     // Light both sides, as the Mesh may be seen from either
+            shade = 0.5f + 0.5f * fabs(normal[0]*LIGHT[0] + normal[1]*LIGHT[1] + normal[2]*LIGHT[2]) / length;
+        GLfloat * v = &myVertices[(size_t) i * PACKED_VERTEX_FLOATS];
+        v[0] = positions[(size_t) i * 3];
+        v[1] = positions[(size_t) i * 3 + 1];
+        v[2] = positions[(size_t) i * 3 + 2];
+        if (colors.empty())
+            packColor(v + 3, ColorFloat(shade, shade, shade, 1.0f));
+        else
+            packColor(v + 3, ColorFloat(colors[i*4] / 255.0f * shade, colors[i*4 + 1] / 255.0f * shade,
+                                        colors[i*4 + 2] / 255.0f * shade, colors[i*4 + 3] / 255.0f));
+    }
+    numberOfVertices = n;
+    numberOfTriangles = t;
+}
+
+// Parses a Wavefront OBJ file's "v" and "f" lines into positions and myIndices, splitting the file
+// into chunks of whole lines that are parsed in parallel.
+bool Mesh::loadObj(const char * data, size_t size, std::vector<GLfloat>& positions) {
+    const char * end = data + size;
+    int chunks = std::max(1, std::min(omp_get_max_threads(), (int) (size / PARALLEL_CHUNK)));
+    std::vector<const char *> starts(chunks + 1);
+    starts[0] = data;
+    starts[chunks] = end;
+    for (int c = 1; c < chunks; c++) {
+        const char * p = data + size / chunks * c;
+        if (p < starts[c-1]) p = starts[c-1];
+        const char * newline = (const char *) memchr(p, '\n', end - p);
+        starts[c] = newline ? newline + 1 : end;
+    }
+
+    // First count the vertices in each chunk, so that relative (negative) indices can be resolved in parallel
+    std::vector<long> firstVertex(chunks + 1, 0);
+    #pragma omp parallel for num_threads(chunks)
+    for (int c = 0; c < chunks; c++) {
+        long count = 0;
+        for (const char * p = starts[c]; p < starts[c+1]; ) {
+            while (p < starts[c+1] && (*p == ' ' || *p == '\t')) p++;
+            if (p + 1 < starts[c+1] && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+                count++;
+            const char * newline = (const char *) memchr(p, '\n', starts[c+1] - p);
+            p = newline ? newline + 1 : starts[c+1];
+        }
+        firstVertex[c+1] = count;
+    }
+    for (int c = 0; c < chunks; c++)
+        firstVertex[c+1] += firstVertex[c];
+
+    std::vector< std::vector<GLfloat> > chunkPositions(chunks);
+    std::vector< std::vector<GLuint> > chunkIndices(chunks);
+    bool valid = true;
+    #pragma omp parallel for num_threads(chunks) reduction(&&:valid)
+    for (int c = 0; c < chunks; c++) {
+        std::vector<GLfloat>& pos = chunkPositions[c];
+        std::vector<GLuint>& ind = chunkIndices[c];
+        pos.reserve((firstVertex[c+1] - firstVertex[c]) * 3);
+        long vertexCount = firstVertex[c];
+        std::vector<GLuint> face;
+        const char * lineEnd;
+        for (const char * p = starts[c]; p < starts[c+1] && valid; p = lineEnd + 1) {
+            lineEnd = (const char *) memchr(p, '\n', starts[c+1] - p);
+            if (!lineEnd) lineEnd = starts[c+1];
+            while (p < lineEnd && (*p == ' ' || *p == '\t')) p++;
+            if (p + 1 >= lineEnd || (p[1] != ' ' && p[1] != '\t'))
+                continue;
+            if (p[0] == 'v') {
+                GLfloat xyz[3];
+                p += 2;
+                for (int i = 0; i < 3 && valid; i++) {
+                    p = parseFloat(p, lineEnd, xyz[i]);
+                    valid = p != nullptr;
+                }
+                if (valid) {
+                    pos.insert(pos.end(), xyz, xyz + 3);
+                    vertexCount++;
+                }
+            } else if (p[0] == 'f') {
+                face.clear();
+                p += 2;
+                while (valid) {
+                    while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+                    if (p >= lineEnd) break;
+                    long index;
+                    p = parseInt(p, lineEnd, index);
+                    if (!p || index == 0) {
+                        valid = false;
+                        break;
+                    }
+                    face.push_back(index > 0 ? index - 1 : vertexCount + index);
+                    while (p < lineEnd && *p != ' ' && *p != '\t') p++;    // Skip "/texture/normal" indices
+                }
+                for (int i = 2; i < (int) face.size(); i++) {
+                    ind.push_back(face[0]);
+                    ind.push_back(face[i-1]);
+                    ind.push_back(face[i]);
+                }
+            }
+        }
+    }
+    if (!valid) return false;
+
+    // Concatenate the chunks in order
+    std::vector<size_t> firstIndex(chunks + 1, 0);
+    for (int c = 0; c < chunks; c++)
+        firstIndex[c+1] = firstIndex[c] + chunkIndices[c].size();
+    positions.resize(firstVertex[chunks] * 3);
+    myIndices.resize(firstIndex[chunks]);
+    #pragma omp parallel for num_threads(chunks)
+    for (int c = 0; c < chunks; c++) {
+        std::copy(chunkPositions[c].begin(), chunkPositions[c].end(), positions.begin() + firstVertex[c] * 3);
+        std::copy(chunkIndices[c].begin(), chunkIndices[c].end(), myIndices.begin() + firstIndex[c]);
+    }
+    return true;
+}
+
+// Parses a binary PLY file's vertex and face elements into positions, colors and myIndices.
+bool Mesh::loadPly(const char * data, size_t size, std::vector<GLfloat>& positions, std::vector<GLubyte>& colors) {
+    // Property types, in the order of their names below, and their sizes in bytes
+    static const char * TYPE_NAMES[] = { "char", "uchar", "short", "ushort", "int", "uint", "float", "double",
+                                         "int8", "uint8", "int16", "uint16", "int32", "uint32", "float32", "float64" };
+    static const int TYPE_SIZES[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
+    struct Property { std::string name; int type; int countType; };     // countType is -1 unless a list
+    struct Element { std::string name; long count; std::vector<Property> properties; };
+
+    const char * end = data + size;
+    const char * headerEnd = nullptr;
+    for (const char * p = data; p < end; ) {
+        const char * newline = (const char *) memchr(p, '\n', end - p);
+        if (!newline) break;
+        if (newline - p >= 10 && strncmp(p, "end_header", 10) == 0) {
+            headerEnd = newline + 1;
+            break;
+        }
+        p = newline + 1;
+    }
+    if (!headerEnd) return false;
+
+    std::vector<Element> elements;
+    bool swap = false, binary = false;
+    char line[256];
+    for (const char * p = data; p < headerEnd; ) {
+        const char * newline = (const char *) memchr(p, '\n', headerEnd - p);
+        size_t length = std::min((size_t) (newline - p), sizeof(line) - 1);
+        memcpy(line, p, length);
+        line[length] = '\0';
+        p = newline + 1;
+        char word[3][64];
+        int words = sscanf(line, "%63s %63s %63s", word[0], word[1], word[2]);
+        if (words >= 2 && strcmp(word[0], "format") == 0) {
+            binary = strcmp(word[1], "binary_little_endian") == 0 || strcmp(word[1], "binary_big_endian") == 0;
+            // Swap bytes if the file's byte order differs from ours
+            const unsigned short one = 1;
+            bool littleEndian = *(const unsigned char *) &one == 1;
+            swap = strcmp(word[1], littleEndian ? "binary_big_endian" : "binary_little_endian") == 0;
+        } else if (words == 3 && strcmp(word[0], "element") == 0) {
+            Element e;
+            e.name = word[1];
+            e.count = atol(word[2]);
+            elements.push_back(e);
+        } else if (words >= 3 && strcmp(word[0], "property") == 0 && !elements.empty()) {
+            Property prop;
+            char typeWords[3][64];
+            bool isList = strcmp(word[1], "list") == 0;
+            int typeCount = sscanf(line, isList ? "%*s %*s %63s %63s %63s" : "%*s %63s %63s", typeWords[0], typeWords[1], typeWords[2]);
+            if (typeCount < (isList ? 3 : 2)) return false;
+            prop.name = typeWords[isList ? 2 : 1];
+            prop.type = prop.countType = -1;
+            for (int i = 0; i < 16; i++) {
+                if (strcmp(typeWords[isList ? 1 : 0], TYPE_NAMES[i]) == 0) prop.type = i % 8;
+                if (isList && strcmp(typeWords[0], TYPE_NAMES[i]) == 0) prop.countType = i % 8;
+            }
+            if (prop.type < 0 || (isList && prop.countType < 0)) return false;
+            elements.back().properties.push_back(prop);
+        }
+    }
+    if (!binary) {
+        TsglErr("Only binary PLY files are supported.");
+        return false;
+    }
+
+    const char * p = headerEnd;
+    for (unsigned e = 0; e < elements.size(); e++) {
+        Element& element = elements[e];
+        bool fixed = true;
+        size_t stride = 0;
+        for (unsigned i = 0; i < element.properties.size(); i++) {
+            if (element.properties[i].countType >= 0) fixed = false;
+            else stride += TYPE_SIZES[element.properties[i].type];
+        }
+
+        if (element.name == "vertex") {
+            // Vertices have a fixed size, so each one can be read independently
+            if (!fixed || (size_t) (end - p) < stride * element.count) return false;
+            int offsets[7] = { -1, -1, -1, -1, -1, -1, -1 }, types[7] = { 0 };
+            const char * NAMES[7] = { "x", "y", "z", "red", "green", "blue", "alpha" };
+            int offset = 0;
+            for (unsigned i = 0; i < element.properties.size(); i++) {
+                for (int j = 0; j < 7; j++) {
+                    if (element.properties[i].name == NAMES[j]) {
+                        offsets[j] = offset;
+                        types[j] = element.properties[i].type;
+                    }
+                }
+                offset += TYPE_SIZES[element.properties[i].type];
+            }
+            if (offsets[0] < 0 || offsets[1] < 0 || offsets[2] < 0) return false;
+            bool hasColors = offsets[3] >= 0 && offsets[4] >= 0 && offsets[5] >= 0;
+            long n = element.count;
+            positions.resize(n * 3);
+            if (hasColors) colors.resize(n * 4);
+            const char * base = p;
+            #pragma omp parallel for if (n * stride > PARALLEL_CHUNK)
+            for (long i = 0; i < n; i++) {
+                const char * v = base + i * stride;
+                for (int j = 0; j < 3; j++)
+                    positions[i*3 + j] = readPlyValue(v + offsets[j], types[j], swap);
+                if (hasColors) {
+                    for (int j = 0; j < 4; j++) {
+                        double c = offsets[3 + j] >= 0 ? readPlyValue(v + offsets[3 + j], types[3 + j], swap) : 255;
+                        if (offsets[3 + j] >= 0 && (types[3 + j] == 6 || types[3 + j] == 7)) c *= 255;   // Floats are 0..1
+                        colors[i*4 + j] = (GLubyte) std::max(0.0, std::min(255.0, c));
+                    }
+                }
+            }
+            p += stride * n;
+        } else if (element.name == "face") {
+            int listIndex = -1;
+            for (unsigned i = 0; i < element.properties.size(); i++)
+                if (element.properties[i].countType >= 0 && (element.properties[i].name == "vertex_indices" || element.properties[i].name == "vertex_index"))
+                    listIndex = i;
+            if (listIndex < 0) return false;
+            const Property& list = element.properties[listIndex];
+            int countSize = TYPE_SIZES[list.countType], indexSize = TYPE_SIZES[list.type];
+            long m = element.count;
+
+            // Fast path: faces that are nothing but triangles have a fixed size and are read in parallel
+            size_t triangleSize = countSize + 3 * indexSize;
+            bool triangles = element.properties.size() == 1 && (size_t) (end - p) >= triangleSize * m;
+            if (triangles) {
+                const char * base = p;
+                #pragma omp parallel for reduction(&&:triangles) if (m * triangleSize > PARALLEL_CHUNK)
+                for (long i = 0; i < m; i++)
+                    triangles = triangles && readPlyValue(base + i * triangleSize, list.countType, swap) == 3;
+            }
+            if (triangles) {
+                myIndices.resize(m * 3);
+                const char * base = p;
+                #pragma omp parallel for if (m * triangleSize > PARALLEL_CHUNK)
+                for (long i = 0; i < m; i++) {
+                    const char * f = base + i * triangleSize + countSize;
+                    for (int j = 0; j < 3; j++)
+                        myIndices[i*3 + j] = (GLuint) readPlyValue(f + j * indexSize, list.type, swap);
+                }
+                p += triangleSize * m;
+            } else {
+                myIndices.reserve(m * 3);
+                for (long i = 0; i < m; i++) {
+                    for (unsigned k = 0; k < element.properties.size(); k++) {
+                        const Property& prop = element.properties[k];
+                        if (prop.countType < 0) {
+                            p += TYPE_SIZES[prop.type];
+                            continue;
+                        }
+                        if (end - p < TYPE_SIZES[prop.countType]) return false;
+                        long count = (long) readPlyValue(p, prop.countType, swap);
+                        p += TYPE_SIZES[prop.countType];
+                        if (count < 0 || end - p < count * TYPE_SIZES[prop.type]) return false;
+                        if ((int) k == listIndex) {
+                            GLuint first = (GLuint) readPlyValue(p, prop.type, swap);
+                            for (long j = 2; j < count; j++) {
+                                myIndices.push_back(first);
+                                myIndices.push_back((GLuint) readPlyValue(p + (j-1) * indexSize, prop.type, swap));
+                                myIndices.push_back((GLuint) readPlyValue(p + j * indexSize, prop.type, swap));
+                            }
+                        }
+                        p += count * TYPE_SIZES[prop.type];
+                    }
+                }
+            }
+        } else if (fixed) {
+            p += stride * element.count;
+        } else {
+            // Skip an element we don't use, one list at a time
+            for (long i = 0; i < element.count; i++) {
+                for (unsigned k = 0; k < element.properties.size(); k++) {
+                    const Property& prop = element.properties[k];
+                    if (prop.countType >= 0) {
+                        if (end - p < TYPE_SIZES[prop.countType]) return false;
+                        long count = (long) readPlyValue(p, prop.countType, swap);
+                        p += TYPE_SIZES[prop.countType] + count * TYPE_SIZES[prop.type];
+                    } else {
+                        p += TYPE_SIZES[prop.type];
+                    }
+                }
+            }
+        }
+        if (p > end) return false;
+    }
+    return !positions.empty();
+}
+
+// Maps a whole file into memory for reading, or reads it if it cannot be mapped. Returns nullptr on failure.
+const char * Mesh::mapFile(const std::string& filename, size_t& size) {
+    size = 0;
+  #ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat info;
+    void * m = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        m = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m != MAP_FAILED) {
+            madvise(m, info.st_size, MADV_SEQUENTIAL);
+            size = info.st_size;
+        }
+    }
+    close(fd);
+    return m == MAP_FAILED ? nullptr : (const char *) m;
+  #else
+    FILE * f = fopen(filename.c_str(), "rb");
+    if (!f) return nullptr;
+    struct stat info;
+    char * data = nullptr;
+    if (stat(filename.c_str(), &info) == 0 && info.st_size > 0) {
+        data = (char *) malloc(info.st_size);
+        if (data && fread(data, 1, info.st_size, f) == (size_t) info.st_size) {
+            size = info.st_size;
+        } else {
+            free(data);
+            data = nullptr;
+        }
+    }
+    fclose(f);
+    return data;
+  #endif
+}
+
+// Frees a file returned by mapFile().
+void Mesh::unmapFile(const char * data, size_t size) {
+  #ifndef _WIN32
+    munmap((void *) data, size);
+  #else
+    free((void *) data);
+  #endif
+}
+
+// Parses a decimal floating point number at p, after any spaces, without reading past end.
+// Returns the first character after it, or nullptr if there is no number.
+const char * Mesh::parseFloat(const char * p, const char * end, GLfloat& value) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+    double result = 0;
+    bool digits = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p++ - '0');
+        digits = true;
+    }
+    if (p < end && *p == '.') {
+        double place = 0.1;
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, place *= 0.1) {
+            result += (*p - '0') * place;
+            digits = true;
+        }
+    }
+    if (!digits) return nullptr;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        long exponent;
+        const char * after = parseInt(p + 1, end, exponent);
+        if (after) {
+            result *= pow(10.0, (double) exponent);
+            p = after;
+        }
+    }
+    value = negative ? -result : result;
+    return p;
+}
+
+// Parses a decimal integer at p without reading past end.
+// Returns the first character after it, or nullptr if there is no integer.
+const char * Mesh::parseInt(const char * p, const char * end, long& value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+    if (p >= end || *p < '0' || *p > '9') return nullptr;
+    long result = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+        result = result * 10 + (*p++ - '0');
+    value = negative ? -result : result;
+    return p;
+}
+
+// Reads one binary PLY value of the given type (an index into TYPE_SIZES in loadPly()).
+double Mesh::readPlyValue(const char * p, int type, bool swap) {
+    static const int TYPE_SIZES[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
+    unsigned char bytes[8];
+    int size = TYPE_SIZES[type];
+    for (int i = 0; i < size; i++)
+        bytes[i] = p[swap ? size - 1 - i : i];
+    switch (type) {
+        case 0: { int8_t v; memcpy(&v, bytes, 1); return v; }
+        case 1: { uint8_t v; memcpy(&v, bytes, 1); return v; }
+        case 2: { int16_t v; memcpy(&v, bytes, 2); return v; }
+        case 3: { uint16_t v; memcpy(&v, bytes, 2); return v; }
+        case 4: { int32_t v; memcpy(&v, bytes, 4); return v; }
+        case 5: { uint32_t v; memcpy(&v, bytes, 4); return v; }
+        case 6: { float v; memcpy(&v, bytes, 4); return v; }
+        default: { double v; memcpy(&v, bytes, 8); return v; }
+    }
+}
+
+ /*!
+  * \brief Accessor for the number of vertices.
+  * \return The number of vertices in the Mesh.
+  */
+int Mesh::getVertexCount() {
+    attribMutex.lock();
+    int n = numberOfVertices;
+    attribMutex.unlockUnchanged();
+    return n;
+}
+
+ /*!
+  * \brief Accessor for the number of triangles.
+  * \return The number of triangles in the Mesh.
+  */
+int Mesh::getTriangleCount() {
+    attribMutex.lock();
+    int n = numberOfTriangles;
+    attribMutex.unlockUnchanged();
+    return n;
+}
+
+ /*!
+  * \brief Sets the Mesh to a new color.
+  * \details The color is applied as a tint when drawing, so this takes constant time for a Mesh of any size.
+  *   \param c The new color of the Mesh.
+  */
+void Mesh::setColor(ColorFloat c) {
+    attribMutex.lock();
+    myColor = c;
+    myAlpha = c.A;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Accessor for the Mesh's color.
+  * \return The color the Mesh is tinted with.
+  */
+ColorFloat Mesh::getColor() {
+    attribMutex.lock();
+    ColorFloat c = myColor;
+    attribMutex.unlockUnchanged();
+    return c;
+}
+
+Mesh::~Mesh() {
+    // We may not be on the render thread, so let it delete the buffers.
+    TextureCache::deleteBufferLater(myContext, myBuffers[0]);
+    TextureCache::deleteBufferLater(myContext, myBuffers[1]);
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Mesh.h extends Drawable and provides a class for drawing arbitrary triangle meshes, such as ones loaded from files.
+ */
+
+#ifndef MESH_H_
+#define MESH_H_
+
+#include <string>
+#include <vector>
+
+#include "Drawable.h"           // For extending our Drawable object
+#include "TextureCache.h"       // For deleting GL objects on the render thread
+
+namespace tsgl {
+
+/*! \class Mesh
+ *  \brief Draw an arbitrary indexed triangle mesh.
+ *  \details A Mesh is a list of vertices and a list of triangles, each three indices into the vertices. It can be
+ *   given directly as arrays, or loaded from a Wavefront OBJ file (".obj") or a binary PLY file (".ply").
+ *  \details Files are memory-mapped and parsed in parallel chunks, so meshes with millions of triangles load in a
+ *   fraction of a second. The vertices and indices are uploaded to the GPU once, on the first frame the Mesh is
+ *   drawn, and the Mesh's own copies are then freed.
+ *  \details Like Sphere and the other 3D shapes, a Mesh is shaded with a fixed light baked into its vertices,
+ *   and is tinted with its color. Per-vertex colors from a PLY file are kept and tinted in the same way.
+ *  \details Only vertex positions (and PLY vertex colors) and faces are read. Faces with more than three vertices
+ *   are split into triangle fans; texture coordinates, normals, materials and other elements are ignored.
+ *  \note A Mesh should only be added to one Canvas.
+ */
+class Mesh : public Drawable {
+ private:
+    std::vector<GLfloat> myVertices;    // PACKED_VERTEX_FLOATS per vertex, with shaded colors; freed once uploaded
+    std::vector<GLuint> myIndices;      // Three per triangle; freed once uploaded
+    int numberOfVertices, numberOfTriangles;
+    ColorFloat myColor;
+
+    GLFWwindow * myContext;             // Context the buffers below were created in
+    GLuint myBuffers[2];                // Vertex buffer, index buffer
+
+    static const size_t PARALLEL_CHUNK = 1 << 20;       // Bytes of a file each thread is given at least
+
+    bool loadObj(const char * data, size_t size, std::vector<GLfloat>& positions);
+    bool loadPly(const char * data, size_t size, std::vector<GLfloat>& positions, std::vector<GLubyte>& colors);
+    void build(const std::vector<GLfloat>& positions, const std::vector<GLubyte>& colors);
+
+    static const char * mapFile(const std::string& filename, size_t& size);
+    static void unmapFile(const char * data, size_t size);
+    static const char * parseFloat(const char * p, const char * end, GLfloat& value);
+    static const char * parseInt(const char * p, const char * end, long& value);
+    static double readPlyValue(const char * p, int type, bool swap);
+ public:
+    Mesh(float x, float y, float z, std::string filename, float scale, float yaw, float pitch, float roll, ColorFloat color = WHITE);
+
+    Mesh(float x, float y, float z, int numVertices, const GLfloat vertices[], int numTriangles, const GLuint indices[], float yaw, float pitch, float roll, ColorFloat color = WHITE);
+
+    virtual void draw(Shader * shader);
+
+    int getVertexCount();
+
+    int getTriangleCount();
+
+    virtual void setColor(ColorFloat c);
+
+    virtual ColorFloat getColor();
+
+    virtual ~Mesh();
+};
+
+}
+
+#endif /* MESH_H_ */
@@ -0,0 +1,309 @@
+#include "ParticleSystem.h"
+#include "RenderService.h"  // For the context that owns our GL objects
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new, empty ParticleSystem.
+  * \details This is the explicit constructor for the ParticleSystem class.
+  *   \param x The x coordinate of the ParticleSystem's center.
+  *   \param y The y coordinate of the ParticleSystem's center.
+  *   \param z The z coordinate of the ParticleSystem's center.
+  *   \param yaw The ParticleSystem's yaw.
+  *   \param pitch The ParticleSystem's pitch.
+  *   \param roll The ParticleSystem's roll.
+  *   \param capacity The greatest number of particles that may be alive at once.
+  *   \param round Whether particles are drawn as discs (true, the default) or as squares (false).
+  * \return A new ParticleSystem with no particles.
+  * \note Space for capacity particles is allocated up front, so emitting never allocates.
+  */
+ParticleSystem::ParticleSystem(float x, float y, float z, float yaw, float pitch, float roll, int capacity, bool round) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    if (capacity < 0) {
+        TsglDebug("Cannot have a negative number of particles.");
+        capacity = 0;
+    }
+    vertices = nullptr;
+    myXScale = myYScale = myZScale = 1;
+    myCapacity = capacity;
+    myCount = 0;
+    isRound = round;
+    isDirty = false;
+    myContext = nullptr;
+    myBuffer = 0;
+    std::vector<GLfloat> * arrays[] = { &myX, &myY, &myZ, &myVX, &myVY, &myVZ, &myR, &myG, &myB, &myA, &mySizes };
+    for (unsigned i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++)
+        arrays[i]->resize(capacity);
+    init = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Draw the ParticleSystem.
+  * \details This function actually draws the ParticleSystem to the Canvas. If any particle has changed
+  *   since the last frame, the live particles are packed directly into a freshly orphaned vertex buffer.
+  */
+void ParticleSystem::draw(Shader * shader) {
+    attribMutex.lock();
+    if (myCount == 0) {
+        attribMutex.unlock();
+        return;
+    }
+    glm::mat4 model = getModelMatrix();
+
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    if (!myBuffer) {
+        myContext = RenderService::currentContext();
+        glGenBuffers(1, &myBuffer);
+        isDirty = true;
+    }
+    GLint previousBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, myBuffer);
+
+    if (isDirty) {
+        // Orphan last frame's storage so that the GPU may keep drawing from it while we write the next one
+        GLsizeiptr size = (GLsizeiptr) myCount * PARTICLE_FLOATS * sizeof(GLfloat);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) myCapacity * PARTICLE_FLOATS * sizeof(GLfloat), NULL, GL_STREAM_DRAW);
+        GLfloat * mapped = (GLfloat *) glMapBufferRange(GL_ARRAY_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped) {
+            pack(mapped);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            isDirty = false;
+        } else {
+            TsglErr("Could not map ParticleSystem vertex buffer.");
+        }
+    }
+
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+    GLint sizeAttrib = glGetAttribLocation(shader->ID, "aSize");
+    GLint roundLoc = glGetUniformLocation(shader->ID, "roundPoints");
+    glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, PARTICLE_FLOATS * sizeof(float), (void*)0);
+    glVertexAttribPointer(colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, PARTICLE_FLOATS * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(sizeAttrib);
+    glVertexAttribPointer(sizeAttrib, 1, GL_FLOAT, GL_FALSE, PARTICLE_FLOATS * sizeof(float), (void*)(4 * sizeof(float)));
+    glUniform1i(roundLoc, isRound);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+
+    glDrawArrays(GL_POINTS, 0, myCount);
+
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glUniform1i(roundLoc, 0);
+    glDisableVertexAttribArray(sizeAttrib);
+    // The attribute pointers remember the buffer bound when they are set, so rebind the shared one first
+    glBindBuffer(GL_ARRAY_BUFFER, previousBuffer);
+    restoreVertexFormat(shader);
+    attribMutex.unlock();
+}
+
+// Returns pointers to the live particle arrays. attribMutex must be held.
+ParticleSystem::Particles ParticleSystem::arrays() {
+    Particles p;
+    p.x = myX.data(); p.y = myY.data(); p.z = myZ.data();
+    p.vx = myVX.data(); p.vy = myVY.data(); p.vz = myVZ.data();
+    p.r = myR.data(); p.g = myG.data(); p.b = myB.data(); p.a = myA.data();
+    p.size = mySizes.data();
+    p.count = myCount;
+    return p;
+}
+
+// Writes the live particles into vertices, PARTICLE_FLOATS per particle. attribMutex must be held.
+void ParticleSystem::pack(GLfloat * vertices) {
+    const int count = myCount;
+    #pragma omp parallel for if (count > UPDATE_CHUNK)
+    for (int i = 0; i < count; i++) {
+        GLfloat * v = vertices + (size_t) i * PARTICLE_FLOATS;
+        v[0] = myX[i];
+        v[1] = myY[i];
+        v[2] = myZ[i];
+        packColor(v + 3, ColorFloat(myR[i], myG[i], myB[i], myA[i]));
+        v[4] = mySizes[i];
+    }
+}
+
+ /*!
+  * \brief Creates a new particle.
+  *   \param x The x coordinate of the particle, relative to the ParticleSystem's center.
+  *   \param y The y coordinate of the particle, relative to the ParticleSystem's center.
+  *   \param z The z coordinate of the particle, relative to the ParticleSystem's center.
+  *   \param vx The x component of the particle's velocity.
+  *   \param vy The y component of the particle's velocity.
+  *   \param vz The z component of the particle's velocity.
+  *   \param color The color of the particle.
+  *   \param size The diameter of the particle in pixels.
+  * \return The index of the new particle, or -1 if the ParticleSystem is full.
+  * \note Indices are only stable until the next call to kill(), removeFaded() or clear().
+  */
+int ParticleSystem::emit(GLfloat x, GLfloat y, GLfloat z, GLfloat vx, GLfloat vy, GLfloat vz, ColorFloat color, GLfloat size) {
+    attribMutex.lock();
+    if (myCount == myCapacity) {
+        attribMutex.unlock();
+        return -1;
+    }
+    int i = myCount++;
+    myX[i] = x; myY[i] = y; myZ[i] = z;
+    myVX[i] = vx; myVY[i] = vy; myVZ[i] = vz;
+    myR[i] = color.R; myG[i] = color.G; myB[i] = color.B; myA[i] = color.A;
+    mySizes[i] = size;
+    isDirty = true;
+    attribMutex.unlock();
+    return i;
+}
+
+ /*!
+  * \brief Removes a particle.
+  * \details The last particle is moved into the removed particle's place, so removal takes constant time.
+  *   \param index The index of the particle to remove.
+  */
+void ParticleSystem::kill(int index) {
+    attribMutex.lock();
+    if (index < 0 || index >= myCount) {
+        TsglDebug("Cannot kill a particle outside of a ParticleSystem.");
+        attribMutex.unlock();
+        return;
+    }
+    int last = --myCount;
+    std::vector<GLfloat> * arrays[] = { &myX, &myY, &myZ, &myVX, &myVY, &myVZ, &myR, &myG, &myB, &myA, &mySizes };
+    for (unsigned j = 0; j < sizeof(arrays) / sizeof(arrays[0]); j++)
+        (*arrays[j])[index] = (*arrays[j])[last];
+    isDirty = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Removes every particle that has faded away.
+  * \details A particle has faded away once its alpha is zero or less, or its size is zero or less.
+  * \return The number of particles removed.
+  */
+int ParticleSystem::removeFaded() {
+    attribMutex.lock();
+    std::vector<GLfloat> * arrays[] = { &myX, &myY, &myZ, &myVX, &myVY, &myVZ, &myR, &myG, &myB, &myA, &mySizes };
+    int kept = 0;
+    for (int i = 0; i < myCount; i++) {
+        if (myA[i] <= 0 || mySizes[i] <= 0)
+            continue;
+        if (kept != i)
+            for (unsigned j = 0; j < sizeof(arrays) / sizeof(arrays[0]); j++)
+                (*arrays[j])[kept] = (*arrays[j])[i];
+        kept++;
+    }
+    int removed = myCount - kept;
+    if (removed > 0) {
+        myCount = kept;
+        isDirty = true;
+    }
+    attribMutex.unlock();
+    return removed;
+}
+
+ /*!
+  * \brief Runs a function over every live particle, in parallel.
+  * \details The live particles are split into ranges of a few thousand, and function is called once for each
+  *   range from an OpenMP team of threads. Calls for different ranges may run at the same time, so function
+  *   should only write to particles in the range it is given.
+  *   \param function The function to call, as function(particles, first, last) for each range [first, last).
+  *   \param threads The number of threads to use (optional). 0, the default, lets OpenMP decide.
+  * \note Particles cannot be emitted or killed from inside function; set a particle's alpha to 0
+  *   and call removeFaded() afterwards instead.
+  */
+void ParticleSystem::update(UpdateFunction function, int threads) {
+    attribMutex.lock();
+    Particles p = arrays();
+    int chunks = (myCount + UPDATE_CHUNK - 1) / UPDATE_CHUNK;
+    if (threads <= 0)
+        threads = omp_get_max_threads();
+    #pragma omp parallel for num_threads(threads) schedule(dynamic) if (chunks > 1)
+    for (int c = 0; c < chunks; c++) {
+        int first = c * UPDATE_CHUNK;
+        function(p, first, std::min(first + UPDATE_CHUNK, p.count));
+    }
+    if (myCount > 0)
+        isDirty = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Moves every particle forward in time.
+  * \details Each particle moves by its velocity, then its velocity is changed by the acceleration and drag,
+  *   and its alpha is reduced by the fade rate. The work is split across threads as in update().
+  *   \param seconds The length of the time step.
+  *   \param ax The x component of the acceleration applied to every particle (optional).
+  *   \param ay The y component of the acceleration applied to every particle (optional).
+  *   \param az The z component of the acceleration applied to every particle (optional).
+  *   \param drag The fraction of its velocity each particle loses per second (optional).
+  *   \param fade The amount of alpha each particle loses per second (optional).
+  */
+void ParticleSystem::step(float seconds, float ax, float ay, float az, float drag, float fade) {
+    float keep = std::max(0.0f, 1.0f - drag * seconds);
+    update([=](Particles& p, int first, int last) {
+        for (int i = first; i < last; i++) {
+            p.x[i] += p.vx[i] * seconds;
+            p.y[i] += p.vy[i] * seconds;
+            p.z[i] += p.vz[i] * seconds;
+            p.vx[i] = (p.vx[i] + ax * seconds) * keep;
+            p.vy[i] = (p.vy[i] + ay * seconds) * keep;
+            p.vz[i] = (p.vz[i] + az * seconds) * keep;
+            p.a[i] -= fade * seconds;
+        }
+    });
+}
+
+ /*!
+  * \brief Removes every particle.
+  */
+void ParticleSystem::clear() {
+    attribMutex.lock();
+    myCount = 0;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Accessor for the number of live particles.
+  * \return The number of particles in the ParticleSystem.
+  */
+int ParticleSystem::size() {
+    attribMutex.lock();
+    int s = myCount;
+    attribMutex.unlock();
+    return s;
+}
+
+ /*!
+  * \brief Accessor for the ParticleSystem's capacity.
+  * \return The greatest number of particles that may be alive at once.
+  */
+int ParticleSystem::capacity() {
+    return myCapacity;
+}
+
+ /*!
+  * \brief Sets whether particles are drawn as discs or as squares.
+  *   \param round true to draw discs, false to draw squares.
+  */
+void ParticleSystem::setRound(bool round) {
+    attribMutex.lock();
+    isRound = round;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Sets every live particle to one color.
+  *   \param c The new color of the particles.
+  */
+void ParticleSystem::setColor(ColorFloat c) {
+    update([=](Particles& p, int first, int last) {
+        for (int i = first; i < last; i++) {
+            p.r[i] = c.R; p.g[i] = c.G; p.b[i] = c.B; p.a[i] = c.A;
+        }
+    });
+}
+
+ParticleSystem::~ParticleSystem() {
+    // We may not be on the render thread, so let it delete the buffer.
+    TextureCache::deleteBufferLater(myContext, myBuffer);
+}
+
+}
@@ -0,0 +1,86 @@
+/*
+ * ParticleSystem.h extends Drawable and provides a class for drawing and animating large numbers of particles.
+ */
+
+#ifndef PARTICLESYSTEM_H_
+#define PARTICLESYSTEM_H_
+
+#include <functional>           // For the update callbacks
+#include <vector>               // For the per-attribute particle arrays
+
+#include "Drawable.h"           // For extending our Drawable object
+#include "TextureCache.h"       // For deleting GL objects on the render thread
+
+namespace tsgl {
+
+/*! \class ParticleSystem
+ *  \brief Draw and animate up to millions of particles as one Drawable.
+ *  \details A ParticleSystem stores the position, velocity, color and size of each of its particles in
+ *   separate arrays (one array per attribute rather than one object per particle), so updating them is a
+ *   tight loop over contiguous memory that can be split across threads. Each frame, the live particles are
+ *   packed straight into a mapped vertex buffer and drawn as point sprites with a single draw call.
+ *  \details Particles are created with emit() and removed with kill() or removeFaded(). They are moved
+ *   either by step(), which integrates simple motion, or by update(), which runs a callback over ranges of
+ *   particles in parallel with OpenMP.
+ *  \details Particle positions are relative to the ParticleSystem's center; sizes are diameters in pixels.
+ *  \note A ParticleSystem should only be added to one Canvas.
+ */
+class ParticleSystem : public Drawable {
+ public:
+    /*! \brief The particle arrays, as passed to update() callbacks. Index i of each array belongs to particle i. */
+    struct Particles {
+        GLfloat * x, * y, * z;          ///< Positions
+        GLfloat * vx, * vy, * vz;       ///< Velocities, in units per second for step()
+        GLfloat * r, * g, * b, * a;     ///< Colors
+        GLfloat * size;                 ///< Diameters in pixels
+        int count;                      ///< Number of live particles
+    };
+
+    /*! \brief A callback that updates the particles in [first, last). */
+    typedef std::function<void(Particles& particles, int first, int last)> UpdateFunction;
+ private:
+    static const int PARTICLE_FLOATS = 5;       // x, y, z, packed color, size
+    static const int UPDATE_CHUNK = 4096;       // Particles given to each update() callback call
+
+    std::vector<GLfloat> myX, myY, myZ, myVX, myVY, myVZ, myR, myG, myB, myA, mySizes;
+    int myCapacity;
+    int myCount;
+    bool isRound;
+    bool isDirty;                       // Whether the particles have changed since the last upload
+
+    GLFWwindow * myContext;             // Context the buffer below was created in
+    GLuint myBuffer;
+
+    Particles arrays();
+    void pack(GLfloat * vertices);
+ public:
+    ParticleSystem(float x, float y, float z, float yaw, float pitch, float roll, int capacity, bool round = true);
+
+    virtual void draw(Shader * shader);
+
+    int emit(GLfloat x, GLfloat y, GLfloat z, GLfloat vx, GLfloat vy, GLfloat vz, ColorFloat color, GLfloat size);
+
+    void kill(int index);
+
+    int removeFaded();
+
+    void update(UpdateFunction function, int threads = 0);
+
+    void step(float seconds, float ax = 0, float ay = 0, float az = 0, float drag = 0, float fade = 0);
+
+    void clear();
+
+    int size();
+
+    int capacity();
+
+    void setRound(bool round);
+
+    virtual void setColor(ColorFloat c);
+
+    virtual ~ParticleSystem();
+};
+
+}
+
+#endif /* PARTICLESYSTEM_H_ */
@@ -48,9 +48,7 @@ Polyline::Polyline(float x, float y, float z, int numVertices, float lineVertice
     myXScale = myYScale = myZScale = 1;
     vertices = new GLfloat[numberOfVertices * 7];
     attribMutex.unlock();
-    for (int i = 0; i < numVertices; i++) {
-        addVertex(lineVertices[3*i] - x, lineVertices[3*i + 1] - y, lineVertices[3*i + 2] - z, color);
-    }
+    addVertices(lineVertices, x, y, z, &color, false);
 }
 
  /*!
@@ -76,9 +74,7 @@ Polyline::Polyline(float x, float y, float z, int numVertices, float lineVertice
     myXScale = myYScale = myZScale = 1;
     vertices = new GLfloat[numberOfVertices * 7];
     attribMutex.unlock();
-    for (int i = 0; i < numVertices; i++) {
-        addVertex(lineVertices[3*i] - x, lineVertices[3*i + 1] - y, lineVertices[3*i + 2] - z, color[i]);
-    }
+    addVertices(lineVertices, x, y, z, color, true);
 }
 
 /*!
@@ -93,13 +89,7 @@ void Polyline::draw(Shader * shader) {
         TsglDebug("Vertex buffer is not full.");
         return;
     }
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(myXScale, myYScale, myZScale));
+    glm::mat4 model = getModelMatrix();
 
     unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
@@ -140,6 +130,78 @@ void Polyline::addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &colo
     attribMutex.unlock();
 }
 
+ /*!
+  * \brief Adds every vertex of the Polyline at once.
+  * \details Equivalent to calling addVertex() numberOfVertices times, but locks attribMutex once.
+  *      \param lineVertices 3 floats per vertex, x-y-z.
+  *      \param originX Subtracted from each x coordinate, to make it relative to the Polyline's center.
+  *      \param originY Subtracted from each y coordinate.
+  *      \param originZ Subtracted from each z coordinate.
+  *      \param color The color of every vertex, or of each vertex if perVertex is true.
+  *      \param perVertex Whether color holds one color per vertex.
+  * \note This function does nothing if any vertex has already been added.
+  */
+void Polyline::addVertices(const GLfloat lineVertices[], GLfloat originX, GLfloat originY, GLfloat originZ, const ColorFloat color[], bool perVertex) {
+    attribMutex.lock();
+    if (init || currentVertex > 0) {
+        TsglDebug("Cannot add anymore vertices.");
+        attribMutex.unlock();
+        return;
+    }
+    myAlpha = 0;
+    for (int i = 0; i < numberOfVertices; i++) {
+        const ColorFloat &c = color[perVertex ? i : 0];
+        GLfloat * v = vertices + i * 7;
+        v[0] = lineVertices[3*i] - originX;
+        v[1] = lineVertices[3*i + 1] - originY;
+        v[2] = lineVertices[3*i + 2] - originZ;
+        v[3] = c.R;
+        v[4] = c.G;
+        v[5] = c.B;
+        v[6] = c.A;
+        myAlpha += c.A;
+    }
+    myAlpha /= numberOfVertices;
+    currentVertex = numberOfVertices * 7;
+    init = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Moves, and optionally recolors, a range of the Polyline's vertices in place.
+  * \details Every vertex is written in one pass under a single lock.
+  *      \param first The index of the first vertex to change.
+  *      \param count The number of vertices to change.
+  *      \param lineVertices 3 floats per vertex, x-y-z, in the same coordinates as given to the constructor.
+  *      \param color The new colors of the vertices, 1 per vertex (optional). By default they are left alone.
+  */
+void Polyline::updateVertices(int first, int count, const GLfloat lineVertices[], const ColorFloat color[]) {
+    attribMutex.lock();
+    Transform t = getTransform();
+    if (!init || first < 0 || count < 0 || first + count > numberOfVertices) {
+        TsglDebug("Cannot update vertices outside of a Polyline.");
+        attribMutex.unlock();
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        GLfloat * v = vertices + (first + i) * 7;
+        v[0] = (lineVertices[3*i] - t.centerX) / t.xScale;
+        v[1] = (lineVertices[3*i + 1] - t.centerY) / t.yScale;
+        v[2] = (lineVertices[3*i + 2] - t.centerZ) / t.zScale;
+    }
+    if (color) {
+        for (int i = 0; i < count; i++) {
+            GLfloat * v = vertices + (first + i) * 7;
+            myAlpha += (color[i].A - v[6]) / numberOfVertices;
+            v[3] = color[i].R;
+            v[4] = color[i].G;
+            v[5] = color[i].B;
+            v[6] = color[i].A;
+        }
+    }
+    attribMutex.unlock();
+}
+
 /**
  * \brief Sets the Polyline to a new color.
  * \param c The new ColorFloat.
@@ -182,7 +244,7 @@ void Polyline::setColor(ColorFloat c[]) {
 ColorFloat Polyline::getColor() {
     attribMutex.lock();
     ColorFloat c = ColorFloat(vertices[3], vertices[4], vertices[5], vertices[6]);
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
     return c;
 }
 
@@ -196,7 +258,7 @@ void Polyline::getColors(std::vector<ColorFloat> &colorVec) {
     for (int i = 0; i < numberOfVertices; i++) {
         colorVec.push_back(ColorFloat(vertices[i*7+3],vertices[i*7+4],vertices[i*7+5],vertices[i*7+6]));
     }
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
 }
 
 
@@ -23,6 +23,7 @@ class Polyline : public Drawable {
     int numberOfVertices;
     int currentVertex = 0;
     virtual void addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color = WHITE);
+    void addVertices(const GLfloat lineVertices[], GLfloat originX, GLfloat originY, GLfloat originZ, const ColorFloat color[], bool perVertex);
 
     Polyline(float x, float y, float z, int numVertices, float yaw, float pitch, float roll);
  public:
@@ -33,6 +34,8 @@ class Polyline : public Drawable {
 
     virtual void draw(Shader * shader);
 
+    virtual void updateVertices(int first, int count, const GLfloat lineVertices[], const ColorFloat color[] = nullptr);
+
     virtual void setColor(ColorFloat c);
     virtual void setColor(ColorFloat c[]);
     virtual ColorFloat getColor();
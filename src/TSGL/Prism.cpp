@@ -29,44 +29,8 @@ Prism::Prism(float x, float y, float z, int sides, GLfloat height, GLfloat radiu
     myHeight = height;
     myYScale = height;
     mySides = sides;
-    geometryType = GL_TRIANGLES;
-    numberOfVertices = mySides * 12;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = mySides * 6;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    useMesh(MESH_PRISM, mySides, c);
     attribMutex.unlock();
-    for (int i = 0; i < mySides; i++) {
-        addVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), c);
-        addVertex(0,0.5,0, c);
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c);
-
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c);
-        addVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), c);
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);
-
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c);
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c);
-
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c);
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);
-        addVertex(0,-0.5,0, c);
-    }
-
-    for (int i = 0; i < mySides; i++) {
-        addOutlineVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 3 - 14;
-
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 3 - 14;
-
-        addOutlineVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        currentOutlineVertex -= numberOfOutlineVertices * 7 * 2 / 3;
-    }
 }
 
  /*!
@@ -98,10 +62,10 @@ Prism::Prism(float x, float y, float z, int sides, GLfloat height, GLfloat radiu
     mySides = sides;
     geometryType = GL_TRIANGLES;
     numberOfVertices = mySides * 12;
-    vertices = new GLfloat[numberOfVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
     outlineGeometryType = GL_LINES;
     numberOfOutlineVertices = mySides * 6;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     attribMutex.unlock();
     for (int i = 0; i < mySides; i++) {
         addVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), c[1]);
@@ -124,15 +88,15 @@ Prism::Prism(float x, float y, float z, int sides, GLfloat height, GLfloat radiu
     for (int i = 0; i < mySides; i++) {
         addOutlineVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), GRAY);
         addOutlineVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 3 - 14;
+        currentOutlineVertex += numberOfOutlineVertices / 3 - 2;
 
         addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
         addOutlineVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 3 - 14;
+        currentOutlineVertex += numberOfOutlineVertices / 3 - 2;
 
         addOutlineVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), GRAY);
         addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        currentOutlineVertex -= numberOfOutlineVertices * 7 * 2 / 3;
+        currentOutlineVertex -= numberOfOutlineVertices * 2 / 3;
     }
 }
 
@@ -147,7 +111,9 @@ void Prism::setHeight(GLfloat height) {
     }
     attribMutex.lock();
     myHeight = height;
+    beginTransform();
     myYScale = height;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -162,7 +128,9 @@ void Prism::changeHeightBy(GLfloat delta) {
     }
     attribMutex.lock();
     myHeight += delta;
+    beginTransform();
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -177,8 +145,10 @@ void Prism::setRadius(GLfloat radius) {
     }
     attribMutex.lock();
     myRadius = radius;
+    beginTransform();
     myXScale = radius;
     myZScale = radius;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -193,8 +163,10 @@ void Prism::changeRadiusBy(GLfloat delta) {
     }
     attribMutex.lock();
     myRadius += delta;
+    beginTransform();
     myXScale += delta;
     myZScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -205,37 +177,17 @@ void Prism::changeRadiusBy(GLfloat delta) {
  */
 void Prism::setColor(ColorFloat c[]) {
     attribMutex.lock();
+    detachMesh();
     myAlpha = 0.0;
     for (int i = 0; i < mySides; i++) {
-        vertices[i*84+3] = c[1].R;
-        vertices[i*84+4] = c[1].G;
-        vertices[i*84+5] = c[1].B;
-        vertices[i*84+6] = c[1].A;
-
-        vertices[i*84+10] = c[0].R;
-        vertices[i*84+11] = c[0].G;
-        vertices[i*84+12] = c[0].B;
-        vertices[i*84+13] = c[0].A;
-
-        vertices[i*84+17] = c[1].R;
-        vertices[i*84+18] = c[1].G;
-        vertices[i*84+19] = c[1].B;
-        vertices[i*84+20] = c[1].A;
-
-        vertices[i*84+24] = vertices[i*84+31] = vertices[i*84+38] = vertices[i*84+45] = vertices[i*84+52] = vertices[i*84+59] = c[2].R;
-        vertices[i*84+25] = vertices[i*84+32] = vertices[i*84+39] = vertices[i*84+46] = vertices[i*84+53] = vertices[i*84+60] = c[2].G;
-        vertices[i*84+26] = vertices[i*84+33] = vertices[i*84+40] = vertices[i*84+47] = vertices[i*84+54] = vertices[i*84+61] = c[2].B;
-        vertices[i*84+27] = vertices[i*84+34] = vertices[i*84+41] = vertices[i*84+48] = vertices[i*84+55] = vertices[i*84+62] = c[2].A;
-
-        vertices[i*84+66] = vertices[i*84+73] = c[3].R;
-        vertices[i*84+67] = vertices[i*84+74] = c[3].G;
-        vertices[i*84+68] = vertices[i*84+75] = c[3].B;
-        vertices[i*84+69] = vertices[i*84+76] = c[3].A;
-
-        vertices[i*84+80] = c[4].R;
-        vertices[i*84+81] = c[4].G;
-        vertices[i*84+82] = c[4].B;
-        vertices[i*84+83] = c[4].A;
+        setVertexColor(i*12, c[1]);
+        setVertexColor(i*12 + 1, c[0]);
+        setVertexColor(i*12 + 2, c[1]);
+        for (int j = 3; j < 9; j++)
+            setVertexColor(i*12 + j, c[2]);
+        setVertexColor(i*12 + 9, c[3]);
+        setVertexColor(i*12 + 10, c[3]);
+        setVertexColor(i*12 + 11, c[4]);
 
         myAlpha += c[0].A + c[1].A * 2 + c[2].A * 6 + c[3].A * 2 + c[4].A;
     }
@@ -251,12 +203,12 @@ void Prism::setColor(ColorFloat c[]) {
  */
 void Prism::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
-    colorVec.push_back(ColorFloat(vertices[10],vertices[11],vertices[12],vertices[13]));
-    colorVec.push_back(ColorFloat(vertices[3],vertices[4],vertices[5],vertices[6]));
-    colorVec.push_back(ColorFloat(vertices[24],vertices[25],vertices[26],vertices[27]));
-    colorVec.push_back(ColorFloat(vertices[66],vertices[67],vertices[68],vertices[69]));
-    colorVec.push_back(ColorFloat(vertices[80],vertices[81],vertices[82],vertices[83]));
-    attribMutex.unlock();
+    colorVec.push_back(getVertexColor(1));
+    colorVec.push_back(getVertexColor(0));
+    colorVec.push_back(getVertexColor(3));
+    colorVec.push_back(getVertexColor(9));
+    colorVec.push_back(getVertexColor(11));
+    attribMutex.unlockUnchanged();
 }
 
 }
\ No newline at end of file
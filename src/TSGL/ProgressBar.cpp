@@ -61,13 +61,14 @@ ProgressBar::~ProgressBar() {
 }
 
 void ProgressBar::draw(Shader * shader) {
+    Transform t = getTransform();
     for (int i = 0; i < segs; i++) {
-        segBorders[i]->setCenter(myCenterX + (myWidth/segs) * ( (float)i - (float)(segs-1)/2), myCenterY, myCenterZ);
-        segRecs[i]->setCenter(myCenterX + (myWidth/segs) * ( (float)i - (float)(segs)/2) + segRecs[i]->getWidth()/2, myCenterY, myCenterZ);
-        segBorders[i]->setRotationPoint(myCenterX, myCenterY, myCenterZ);
-        segRecs[i]->setRotationPoint(myCenterX, myCenterY, myCenterZ);
-        segBorders[i]->setYawPitchRoll(myCurrentYaw, myCurrentPitch, myCurrentRoll);
-        segRecs[i]->setYawPitchRoll(myCurrentYaw, myCurrentPitch, myCurrentRoll);
+        segBorders[i]->setCenter(t.centerX + (myWidth/segs) * ( (float)i - (float)(segs-1)/2), t.centerY, t.centerZ);
+        segRecs[i]->setCenter(t.centerX + (myWidth/segs) * ( (float)i - (float)(segs)/2) + segRecs[i]->getWidth()/2, t.centerY, t.centerZ);
+        segBorders[i]->setRotationPoint(t.centerX, t.centerY, t.centerZ);
+        segRecs[i]->setRotationPoint(t.centerX, t.centerY, t.centerZ);
+        segBorders[i]->setYawPitchRoll(t.yaw, t.pitch, t.roll);
+        segRecs[i]->setYawPitchRoll(t.yaw, t.pitch, t.roll);
         segRecs[i]->draw(shader);
         segBorders[i]->draw(shader);
     }
@@ -80,13 +81,14 @@ void ProgressBar::draw(Shader * shader) {
   *   is set to its minimum value. If newV is more than the segment's maximum value, the segment
   *   is set to its maximum value.
   *   \param newValue The value to set the segment to.
-  *   \param segnum The segment whose value to update. A value of -1 indicates the current thread number.
+  *   \param segnum The segment whose value to update. A value of -1 indicates the current thread number,
+  *     as given by TaskPool::getThreadNumber().
   * \note The minimum value for a segment is calculated as <code>minV + (maxV-minV)*seg/segs</code>
   * \note The maximum value for a segment is calculated as <code>minV + (maxV-minV)*(seg+1)/segs</code>
   */
 void ProgressBar::update(float newValue, int segnum) {
   if (segnum == -1)
-    segnum = omp_get_thread_num();
+    segnum = TaskPool::getThreadNumber();
   float d = max-min;
   float start = min + (d * segnum)/segs;
   float end = start + d/segs;
@@ -10,6 +10,7 @@
 #include "Polyline.h"
 #include "Rectangle.h"
 #include "Drawable.h"
+#include "TaskPool.h"       // For telling TaskPool workers apart
 
 namespace tsgl {
 
@@ -44,6 +45,18 @@ class ProgressBar : public Drawable {
      */
     int getSegs() { return segs; }
 
+    /*!
+     * \brief Accessor for the ProgressBar's minimum value
+     * \return The value at which the ProgressBar is empty.
+     */
+    float getMinValue() { return min; }
+
+    /*!
+     * \brief Accessor for the ProgressBar's maximum value
+     * \return The value at which the ProgressBar is full.
+     */
+    float getMaxValue() { return max; }
+
     /*!
      * \brief Accessor for the ProgressBar's width in pixels
      * \return The pixel width of the ProgressBar.
@@ -33,32 +33,8 @@ Pyramid::Pyramid(float x, float y, float z, int sides, GLfloat height, GLfloat r
     myXScale = radius;
     myZScale = radius;
     mySides = sides;
-    geometryType = GL_TRIANGLES;
-    numberOfVertices = mySides * 6;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = mySides * 4;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    useMesh(MESH_PYRAMID, mySides, c);
     attribMutex.unlock();
-    for (int i = 0; i < mySides; i++) {
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);
-        addVertex(0,-0.5,0, c);
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c);
-
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);    
-        addVertex(0,0.5,0, ColorFloat(c.R*.5,c.G*.5,c.B*.5,c.A));
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c);
-    }
-
-    for (int i = 0; i < mySides; i++) {
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 2 - 14;
-
-        addOutlineVertex(0, 0.5, 0, GRAY);
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        currentOutlineVertex -= numberOfOutlineVertices * 7 / 2;
-    }
 }
 
  /*!
@@ -94,10 +70,10 @@ Pyramid::Pyramid(float x, float y, float z, int sides, GLfloat height, GLfloat r
     mySides = sides;
     geometryType = GL_TRIANGLES;
     numberOfVertices = mySides * 6;
-    vertices = new GLfloat[numberOfVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
     outlineGeometryType = GL_LINES;
     numberOfOutlineVertices = mySides * 4;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     attribMutex.unlock();
     for (int i = 0; i < mySides; i++) {
         addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c[i+1]);
@@ -112,11 +88,11 @@ Pyramid::Pyramid(float x, float y, float z, int sides, GLfloat height, GLfloat r
     for (int i = 0; i < mySides; i++) {
         addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
         addOutlineVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 2 - 14;
+        currentOutlineVertex += numberOfOutlineVertices / 2 - 2;
 
         addOutlineVertex(0, 0.5, 0, GRAY);
         addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        currentOutlineVertex -= numberOfOutlineVertices * 7 / 2;
+        currentOutlineVertex -= numberOfOutlineVertices / 2;
     }
 }
 
@@ -132,8 +108,10 @@ void Pyramid::setRadius(float radius) {
         return;
     }
     myRadius = radius;
+    beginTransform();
     myXScale = radius;
     myZScale = radius;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -149,8 +127,10 @@ void Pyramid::changeRadiusBy(float delta) {
         return;
     }
     myRadius += delta;
+    beginTransform();
     myXScale += delta;
     myZScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -165,7 +145,9 @@ void Pyramid::setHeight(float height) {
     }
     attribMutex.lock();
     myHeight = height;
+    beginTransform();
     myYScale = height;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -180,7 +162,9 @@ void Pyramid::changeHeightBy(float delta) {
     }
     attribMutex.lock();
     myHeight += delta;
+    beginTransform();
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -189,18 +173,19 @@ void Pyramid::changeHeightBy(float delta) {
  * \param c The new ColorFloat.
  */
 void Pyramid::setColor(ColorFloat c) {
+    if (myMesh) {
+        Shape::setColor(c);
+        return;
+    }
     attribMutex.lock();
     myAlpha = c.A;
     for(int i = 0; i < mySides; i++) {
-        vertices[i*42 + 3] = vertices[i*42 + 10] = vertices[i*42 + 17] = vertices[i*42 + 24] = vertices[i*42 + 38] = c.R;
-        vertices[i*42 + 4] = vertices[i*42 + 11] = vertices[i*42 + 18] = vertices[i*42 + 25] = vertices[i*42 + 39] = c.G;
-        vertices[i*42 + 5] = vertices[i*42 + 12] = vertices[i*42 + 19] = vertices[i*42 + 26] = vertices[i*42 + 40] = c.B;
-        vertices[i*42 + 6] = vertices[i*42 + 13] = vertices[i*42 + 20] = vertices[i*42 + 27] = vertices[i*42 + 41] = c.A;
-
-        vertices[i*42 + 31] = c.R *.5;
-        vertices[i*42 + 32] = c.G *.5;
-        vertices[i*42 + 33] = c.B *.5;
-        vertices[i*42 + 34] = c.A;
+        setVertexColor(i*6, c);
+        setVertexColor(i*6 + 1, c);
+        setVertexColor(i*6 + 2, c);
+        setVertexColor(i*6 + 3, c);
+        setVertexColor(i*6 + 4, ColorFloat(c.R * .5, c.G * .5, c.B * .5, c.A));
+        setVertexColor(i*6 + 5, c);
     }
     attribMutex.unlock();
 }
@@ -212,37 +197,15 @@ void Pyramid::setColor(ColorFloat c) {
  */
 void Pyramid::setColor(ColorFloat c[]) {
     attribMutex.lock();
+    detachMesh();
     myAlpha = 0.0;
     for(int i = 0; i < mySides; i++) {
-        vertices[i*42 + 3] = c[i+1].R;
-        vertices[i*42 + 4] = c[i+1].G;
-        vertices[i*42 + 5] = c[i+1].B;
-        vertices[i*42 + 6] = c[i+1].A;
-
-        vertices[i*42 + 10] = c[mySides+1].R;
-        vertices[i*42 + 11] = c[mySides+1].G;
-        vertices[i*42 + 12] = c[mySides+1].B;
-        vertices[i*42 + 13] = c[mySides+1].A;
-
-        vertices[i*42 + 17] = c[(i+1) % mySides + 1].R;
-        vertices[i*42 + 18] = c[(i+1) % mySides + 1].G;
-        vertices[i*42 + 19] = c[(i+1) % mySides + 1].B;
-        vertices[i*42 + 20] = c[(i+1) % mySides + 1].A;
-        
-        vertices[i*42 + 24] = c[i+1].R;
-        vertices[i*42 + 25] = c[i+1].G;
-        vertices[i*42 + 26] = c[i+1].B;
-        vertices[i*42 + 27] = c[i+1].A;
-
-        vertices[i*42 + 31] = c[0].R;
-        vertices[i*42 + 32] = c[0].G;
-        vertices[i*42 + 33] = c[0].B;
-        vertices[i*42 + 34] = c[0].A;
-
-        vertices[i*42 + 38] = c[(i+1) % mySides + 1].R;
-        vertices[i*42 + 39] = c[(i+1) % mySides + 1].G;
-        vertices[i*42 + 40] = c[(i+1) % mySides + 1].B;
-        vertices[i*42 + 41] = c[(i+1) % mySides + 1].A;
+        setVertexColor(i*6, c[i+1]);
+        setVertexColor(i*6 + 1, c[mySides+1]);
+        setVertexColor(i*6 + 2, c[(i+1) % mySides + 1]);
+        setVertexColor(i*6 + 3, c[i+1]);
+        setVertexColor(i*6 + 4, c[0]);
+        setVertexColor(i*6 + 5, c[(i+1) % mySides + 1]);
 
         myAlpha += c[i+1].A * 2 + c[0].A + c[(i+1) % mySides + 1].A * 2 + c[mySides+2].A; 
     }
@@ -258,12 +221,12 @@ void Pyramid::setColor(ColorFloat c[]) {
  */
 void Pyramid::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
-    colorVec.push_back(ColorFloat(vertices[31],vertices[32],vertices[33],vertices[34]));
+    colorVec.push_back(getVertexColor(4));
     for (int i = 0; i < mySides; i++) {
-        colorVec.push_back(ColorFloat(vertices[42*i+3],vertices[42*i+4],vertices[42*i+5],vertices[42*i+6]));
+        colorVec.push_back(getVertexColor(6*i));
     }
-    colorVec.push_back(ColorFloat(vertices[10],vertices[11],vertices[12],vertices[13]));
-    attribMutex.unlock();
+    colorVec.push_back(getVertexColor(1));
+    attribMutex.unlockUnchanged();
 }
 
 }
\ No newline at end of file
@@ -83,7 +83,9 @@ void Rectangle::setWidth(GLfloat width) {
     }
     attribMutex.lock();
     myWidth = width;
+    beginTransform();
     myXScale = width;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -98,7 +100,9 @@ void Rectangle::changeWidthBy(GLfloat delta) {
     }
     attribMutex.lock();
     myWidth += delta;
+    beginTransform();
     myXScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -113,7 +117,9 @@ void Rectangle::setHeight(GLfloat height) {
     }
     attribMutex.lock();
     myHeight = height;
+    beginTransform();
     myYScale = height;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -128,7 +134,9 @@ void Rectangle::changeHeightBy(GLfloat delta) {
     }
     attribMutex.lock();
     myHeight += delta;
+    beginTransform();
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -66,8 +66,10 @@ void RegularPolygon::setRadius(GLfloat radius) {
     }
     attribMutex.lock();
     myRadius = radius;
+    beginTransform();
     myXScale = radius;
     myYScale = radius;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -82,8 +84,10 @@ void RegularPolygon::changeRadiusBy(GLfloat delta) {
     }
     attribMutex.lock();
     myRadius += delta;
+    beginTransform();
     myXScale += delta;
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
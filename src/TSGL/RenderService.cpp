@@ -0,0 +1,197 @@
+#include "RenderService.h"
+
+#include "Canvas.h"
+#include "Error.h"
+
+namespace tsgl {
+
+std::mutex RenderService::serviceMutex;
+std::condition_variable RenderService::serviceCondition;
+std::vector<Canvas*> RenderService::startingCanvases;
+std::thread RenderService::renderThread;
+bool RenderService::enabled = false;
+bool RenderService::stopping = false;
+GLFWwindow * RenderService::sharedContext = nullptr;
+Shader * RenderService::sharedShaders[3] = { nullptr, nullptr, nullptr };
+Timer RenderService::timer(FRAME);
+thread_local bool RenderService::onRenderThread = false;
+
+ /*!
+  * \brief Turns the RenderService on or off for Canvases created from now on.
+  * \details Canvases that already exist keep rendering the way they were created to.
+  *   \param enable Whether new Canvases should be drawn by the RenderService.
+  */
+void RenderService::setEnabled(bool enable) {
+  #ifdef __APPLE__
+    if (enable) TsglDebug("The RenderService is not available on Mac OS X.");
+  #else
+    serviceMutex.lock();
+    enabled = enable;
+    serviceMutex.unlock();
+  #endif
+}
+
+ /*!
+  * \brief Accessor for whether new Canvases are drawn by the RenderService.
+  * \return Whether the RenderService is enabled.
+  */
+bool RenderService::isEnabled() {
+    std::lock_guard<std::mutex> lock(serviceMutex);
+    return enabled;
+}
+
+ /*!
+  * \brief Changes how often the RenderService draws.
+  *   \param seconds The number of seconds between frames. The default is FRAME.
+  */
+void RenderService::setPeriod(double seconds) {
+    timer.setPeriod(seconds);
+}
+
+ /*!
+  * \brief Starts drawing a Canvas.
+  * \details The rendering thread is started along with the first Canvas.
+  *   \param can The Canvas to draw, which must have been created while the RenderService was enabled.
+  * \note Called by Canvas::start().
+  */
+void RenderService::add(Canvas * can) {
+    serviceMutex.lock();
+    startingCanvases.push_back(can);
+    if (!renderThread.joinable())
+        renderThread = std::thread(run);
+    serviceMutex.unlock();
+    serviceCondition.notify_all();
+}
+
+// Body of the rendering thread: draws every Canvas once per period of timer, then handles input for all of them.
+void RenderService::run() {
+    onRenderThread = true;
+    ChangeSignal::onRenderingThread = true;
+    std::vector<Canvas*> canvases;
+    while (true) {
+        std::unique_lock<std::mutex> lock(serviceMutex);
+        serviceCondition.wait(lock, [&canvases]() { return stopping || !canvases.empty() || !startingCanvases.empty(); });
+        if (stopping) break;
+        std::vector<Canvas*> starting;
+        starting.swap(startingCanvases);
+        lock.unlock();
+        for (unsigned i = 0; i < starting.size(); i++) {
+            starting[i]->beginDrawing();
+            canvases.push_back(starting[i]);
+        }
+
+        timer.sleep(true);
+        for (unsigned i = 0; i < canvases.size(); ) {
+            Canvas * can = canvases[i];
+            if (glfwWindowShouldClose(can->window)) {
+                can->glDestroy();
+                glfwDestroyWindow(can->window);
+                can->endDrawing();
+                canvases.erase(canvases.begin() + i);
+                continue;
+            }
+            if (can->getFramePacing() != PACE_ON_CHANGE || can->changeSignal->wait(0)) {
+                if (can->tryBeginFrame()) {
+                    can->drawTimer->tick();
+                    can->drawFrame(PACE_UNCAPPED, false);   // Never wait on one window's vsync
+                } else {
+                    can->changeSignal->notify();  // Don't wait out its update; draw it on a later pass instead
+                }
+            }
+            i++;
+        }
+        glfwPollEvents();   // Handle the input of every window at once
+    }
+}
+
+ /*!
+  * \brief Accessor for the context that every Canvas drawn by the RenderService shares.
+  * \details The shared context belongs to a hidden window, which is created the first time this is called.
+  * \return The shared context.
+  * \note Called by Canvas while it creates its window, with GLFW initialized and its window hints set.
+  */
+GLFWwindow * RenderService::getSharedContext() {
+    std::lock_guard<std::mutex> lock(serviceMutex);
+    if (!sharedContext) {
+        glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+        sharedContext = glfwCreateWindow(1, 1, "", NULL, NULL);
+        TextureCache::contextCreated(sharedContext);
+    }
+    return sharedContext;
+}
+
+ /*!
+  * \brief Accessor for the shaders shared by every Canvas drawn by the RenderService.
+  *   \param text Set to the text shader.
+  *   \param shape Set to the shape shader.
+  *   \param texture Set to the texture shader.
+  * \return Whether the shaders have been compiled yet. If not, the parameters are left unchanged.
+  * \see setShaders()
+  */
+bool RenderService::getShaders(Shader *& text, Shader *& shape, Shader *& texture) {
+    std::lock_guard<std::mutex> lock(serviceMutex);
+    if (!sharedShaders[0]) return false;
+    text = sharedShaders[0];
+    shape = sharedShaders[1];
+    texture = sharedShaders[2];
+    return true;
+}
+
+ /*!
+  * \brief Hands the RenderService the shaders for every Canvas it draws.
+  * \details The first Canvas created for the RenderService compiles its shaders in its context, which shares them
+  *   with every other, and then gives them to the RenderService, which deletes them once every Canvas is gone.
+  *   \param text The text shader.
+  *   \param shape The shape shader.
+  *   \param texture The texture shader.
+  */
+void RenderService::setShaders(Shader * text, Shader * shape, Shader * texture) {
+    std::lock_guard<std::mutex> lock(serviceMutex);
+    sharedShaders[0] = text;
+    sharedShaders[1] = shape;
+    sharedShaders[2] = texture;
+}
+
+ /*!
+  * \brief Accessor for the context GL objects should be cached under on the calling thread.
+  * \details On the RenderService's thread, every context shares its objects, so this is the shared context.
+  *   Elsewhere it is the current context.
+  * \return The context to cache GL objects under, or nullptr if there is no current context.
+  */
+GLFWwindow * RenderService::currentContext() {
+    GLFWwindow * context = glfwGetCurrentContext();
+    return (onRenderThread && context) ? sharedContext : context;
+}
+
+ /*!
+  * \brief Stops the rendering thread and destroys the shared context.
+  * \details Any Canvases still being drawn stop updating.
+  * \note Called by Canvas once the last Canvas is destroyed, before GLFW is terminated.
+  */
+void RenderService::shutdown() {
+    serviceMutex.lock();
+    stopping = true;
+    serviceMutex.unlock();
+    serviceCondition.notify_all();
+    if (renderThread.joinable())
+        renderThread.join();
+
+    serviceMutex.lock();
+    stopping = false;
+    startingCanvases.clear();
+    if (sharedContext) {
+        glfwMakeContextCurrent(sharedContext);
+        for (int i = 0; i < 3; i++) {
+            delete sharedShaders[i];
+            sharedShaders[i] = nullptr;
+        }
+        TextureCache::contextDestroyed(sharedContext);
+        GeometryCache::contextDestroyed(sharedContext);
+        glfwMakeContextCurrent(NULL);
+        glfwDestroyWindow(sharedContext);
+        sharedContext = nullptr;
+    }
+    serviceMutex.unlock();
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * RenderService.h provides a single rendering thread that can draw any number of Canvases.
+ */
+
+#ifndef RENDERSERVICE_H_
+#define RENDERSERVICE_H_
+
+#include <condition_variable>   // For waking the rendering thread when a Canvas starts
+#include <mutex>                // Needed for locking the service for thread-safety
+#include <thread>               // For the rendering thread
+#include <vector>
+
+#include "Shader.h"
+#include "Timer.h"              // For pacing every Canvas together
+#include "gl_includes.h"
+
+namespace tsgl {
+
+class Canvas;
+
+/*! \class RenderService
+ *  \brief Draws every Canvas that uses it from one shared rendering thread.
+ *  \details Normally each Canvas spawns its own rendering thread with its own GL context, and each of those threads
+ *    wakes every frame. Once RenderService is enabled, Canvases created afterwards are instead drawn one after the
+ *    other by a single thread, paced by a single Timer, which also handles the input of every window at once.
+ *  \details The Canvases' GL contexts are all created sharing one hidden context, so the shader programs are
+ *    compiled only once, and textures in TextureCache and meshes in GeometryCache are uploaded only once for all of them.
+ *  \details While drawn by the RenderService, a Canvas draws every frame of the service's Timer, except that a Canvas
+ *    paced with PACE_ON_CHANGE skips the frames in which nothing it draws has changed. Its other FramePacings are ignored.
+ *  \details A Canvas with an update in progress (see Canvas::beginUpdate()) is skipped until the update ends, rather than
+ *    waited for, so a long update or batch on one Canvas never holds up the others.
+ *  \note RenderService is not available on Mac OS X, which only lets windows be destroyed on the main thread.
+ */
+class RenderService {
+ private:
+    static std::mutex serviceMutex;
+    static std::condition_variable serviceCondition;    // Signaled when a Canvas starts or the service stops
+    static std::vector<Canvas*> startingCanvases;       // Canvases started since the rendering thread last looked
+    static std::thread renderThread;
+    static bool enabled;
+    static bool stopping;
+    static GLFWwindow * sharedContext;                  // Hidden window whose context every Canvas' context shares
+    static Shader * sharedShaders[3];                   // Text, shape and texture shaders, shared by every Canvas
+    static Timer timer;
+    static thread_local bool onRenderThread;
+
+    static void run();
+ public:
+    static void setEnabled(bool enable);
+
+    static bool isEnabled();
+
+    static void setPeriod(double seconds);
+
+    static void add(Canvas * can);
+
+    static GLFWwindow * getSharedContext();
+
+    static bool getShaders(Shader *& text, Shader *& shape, Shader *& texture);
+
+    static void setShaders(Shader * text, Shader * shape, Shader * texture);
+
+    static GLFWwindow * currentContext();
+
+    static void shutdown();
+};
+
+}
+
+#endif /* RENDERSERVICE_H_ */
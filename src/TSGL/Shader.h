@@ -13,6 +13,10 @@ class Shader
 {
 public:
     unsigned int ID;
+    // camera of the most recent selectShaders() call; used to pick levels of detail
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::mat4 view = glm::mat4(1.0f);
+    float viewportHeight = 0.0f;
     // constructor generates the shader on the fly
     // ------------------------------------------------------------------------
     Shader(const char* vertexShader, const char* fragmentShader, const char* geometryShader = nullptr)
@@ -11,7 +11,10 @@ namespace tsgl {
  * \warning <b>You <i>must</i> inherit the parent's constructor if you are extending Shape.</b>
  * \note Refer to the Shape class description for more details.
  */
-Shape::Shape(float x, float y, float z, float yaw, float pitch, float roll) : Drawable(x,y,z,yaw,pitch,roll) { }
+Shape::Shape(float x, float y, float z, float yaw, float pitch, float roll) : Drawable(x,y,z,yaw,pitch,roll) {
+    myTint = WHITE;
+    myOutlineTint = GRAY;
+}
 
 /*!
  * \brief Draw the Shape.
@@ -25,26 +28,50 @@ void Shape::draw(Shader * shader) {
         TsglDebug("Vertex buffer is not full.");
         return;
     }
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(myXScale, myYScale, myZScale));
+    glm::mat4 model = getModelMatrix();
 
     unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
 
-    if (isFilled) {
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * 7, vertices, GL_DYNAMIC_DRAW);
+    if (myMesh) {
+        GeometryCache::Mesh * mesh = GeometryCache::selectLevel(myMesh, model, shader, myDetail);
+        int outline = isOutlined ? numberOfOutlineVertices : 0;
+        if (mesh != myMesh)
+            outline = (long long) outline * mesh->numberOfOutlineIndices / myMesh->numberOfOutlineIndices;
+        GeometryCache::draw(mesh, shader, isFilled, myTint, outline, myOutlineTint);
+        return;
+    }
+
+    // Recoloring can replace the vertex arrays, so they must not change while they are uploaded
+    attribMutex.lock();
+    useVertexFormat(shader, myFormat, myTint);
+    if (indices) {
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * floatsPerVertex(myFormat), vertices, GL_DYNAMIC_DRAW);
+        if (isFilled) {
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * numberOfIndices, indices, GL_DYNAMIC_DRAW);
+            glDrawElements(geometryType, numberOfIndices, GL_UNSIGNED_INT, (void*)0);
+        }
+    } else if (isFilled) {
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * floatsPerVertex(myFormat), vertices, GL_DYNAMIC_DRAW);
         glDrawArrays(geometryType, 0, numberOfVertices);
     }
 
-    if (isOutlined) {
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfOutlineVertices * 7, outlineVertices, GL_DYNAMIC_DRAW);
+    if (isOutlined && outlineIndices) {
+        if (!indices)
+            glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * floatsPerVertex(myFormat), vertices, GL_DYNAMIC_DRAW);
+        // The outline reuses the fill's vertices, so draw it in a constant color instead of theirs
+        GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+        glDisableVertexAttribArray(colAttrib);
+        glVertexAttrib4f(colAttrib, myOutlineTint.R, myOutlineTint.G, myOutlineTint.B, myOutlineTint.A);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * numberOfOutlineIndices, outlineIndices, GL_DYNAMIC_DRAW);
+        glDrawElements(outlineGeometryType, numberOfOutlineIndices, GL_UNSIGNED_INT, (void*)0);
+    } else if (isOutlined) {
+        useVertexFormat(shader, myOutlineFormat, myOutlineTint);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfOutlineVertices * floatsPerVertex(myOutlineFormat), outlineVertices, GL_DYNAMIC_DRAW);
         glDrawArrays(outlineGeometryType, 0, numberOfOutlineVertices);
     }
+    attribMutex.unlock();
+    restoreVertexFormat(shader);
 }
 
  /*!
@@ -63,17 +90,21 @@ void Shape::addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color)
         return;
     }
     attribMutex.lock();
-    vertices[currentVertex] = x;
-    vertices[currentVertex + 1] = y;
-    vertices[currentVertex + 2] = z;
-    vertices[currentVertex + 3] = color.R;
-    vertices[currentVertex + 4] = color.G;
-    vertices[currentVertex + 5] = color.B;
-    vertices[currentVertex + 6] = color.A;
-    currentVertex += 7;
+    GLfloat * v = vertices + currentVertex * PACKED_VERTEX_FLOATS;
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+    packColor(v + 3, color);
+    if (currentVertex == 0)
+        myTint = color;
+    else if (color.R != myTint.R || color.G != myTint.G || color.B != myTint.B || color.A != myTint.A)
+        myFormat = VERTEX_PACKED;
+    currentVertex++;
     myAlpha += color.A;
-    if (currentVertex == numberOfVertices*7) {
+    if (currentVertex == numberOfVertices) {
         myAlpha /= numberOfVertices;
+        if (myFormat == VERTEX_UNIFORM)
+            vertices = dropColors(vertices, numberOfVertices);
         init = true;
     }
     attribMutex.unlock();
@@ -96,32 +127,328 @@ void Shape::addOutlineVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &
         return;
     }
     attribMutex.lock();
-    outlineVertices[currentOutlineVertex] = x;
-    outlineVertices[currentOutlineVertex + 1] = y;
-    outlineVertices[currentOutlineVertex + 2] = z;
-    outlineVertices[currentOutlineVertex + 3] = color.R;
-    outlineVertices[currentOutlineVertex + 4] = color.G;
-    outlineVertices[currentOutlineVertex + 5] = color.B;
-    outlineVertices[currentOutlineVertex + 6] = color.A;
-    currentOutlineVertex += 7;
-    if (currentOutlineVertex == numberOfOutlineVertices*7) {
+    GLfloat * v = outlineVertices + currentOutlineVertex * PACKED_VERTEX_FLOATS;
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+    packColor(v + 3, color);
+    if (currentOutlineVertex == 0)
+        myOutlineTint = color;
+    else if (color.R != myOutlineTint.R || color.G != myOutlineTint.G || color.B != myOutlineTint.B || color.A != myOutlineTint.A)
+        myOutlineFormat = VERTEX_PACKED;
+    currentOutlineVertex++;
+    if (currentOutlineVertex == numberOfOutlineVertices) {
+        if (myOutlineFormat == VERTEX_UNIFORM)
+            outlineVertices = dropColors(outlineVertices, numberOfOutlineVertices);
         outlineInit = true;
     }
     attribMutex.unlock();
 }
 
+/*!
+ * \brief Makes the Shape draw a unit mesh shared through GeometryCache.
+ * \details Replaces the Shape's own vertex buffers with a reference to the shared mesh, so that only the
+ *   Shape's transform and colors are stored per instance. Subclasses call this from their constructors
+ *   with attribMutex held, after setting the scale that maps the unit mesh to the Shape's size.
+ *   \param kind The kind of mesh to draw.
+ *   \param tessellation The number of sections or sides of the mesh.
+ *   \param color The color with which to tint the mesh.
+ */
+void Shape::useMesh(MeshKind kind, int tessellation, const ColorFloat &color) {
+    myMesh = GeometryCache::acquire(kind, tessellation);
+    if (!myMesh) return;
+    vertices = nullptr;
+    outlineVertices = nullptr;
+    numberOfVertices = myMesh->numberOfIndices;
+    geometryType = myMesh->geometryType;
+    numberOfOutlineVertices = myMesh->numberOfOutlineIndices;
+    outlineGeometryType = myMesh->outlineGeometryType;
+    myTint = color;
+    myOutlineTint = GRAY;
+    myAlpha = color.A;
+    init = outlineInit = true;
+}
+
+/*!
+ * \brief Gives the Shape its own copy of its shared mesh.
+ * \details Called before the Shape is given per-vertex colors, which a shared mesh cannot hold.
+ *   The mesh's indices are expanded into one vertex per index, colored exactly as the tinted mesh was drawn.
+ * \note attribMutex must be held. Does nothing if the Shape does not draw a shared mesh.
+ */
+void Shape::detachMesh() {
+    if (!myMesh) return;
+    vertices = new GLfloat[myMesh->numberOfIndices * PACKED_VERTEX_FLOATS];
+    for (int i = 0; i < myMesh->numberOfIndices; i++) {
+        GLfloat * v = myMesh->vertices + myMesh->indices[i] * 7;
+        GLfloat * dst = vertices + i * PACKED_VERTEX_FLOATS;
+        dst[0] = v[0];
+        dst[1] = v[1];
+        dst[2] = v[2];
+        packColor(dst + 3, ColorFloat(v[3] * myTint.R, v[4] * myTint.G, v[5] * myTint.B, v[6] * myTint.A));
+    }
+    myFormat = VERTEX_PACKED;
+    outlineVertices = new GLfloat[myMesh->numberOfOutlineIndices * 3];
+    for (int i = 0; i < myMesh->numberOfOutlineIndices; i++) {
+        GLfloat * v = myMesh->vertices + myMesh->outlineIndices[i] * 7;
+        outlineVertices[i*3] = v[0];
+        outlineVertices[i*3 + 1] = v[1];
+        outlineVertices[i*3 + 2] = v[2];
+    }
+    myOutlineFormat = VERTEX_UNIFORM;
+    GeometryCache::release(myMesh);
+    myMesh = nullptr;
+}
+
+/*!
+ * \brief Accessor for the color of one of the Shape's vertices.
+ *   \param index The position of the vertex in drawing order.
+ * \return The color with which the vertex is drawn, whatever the Shape's vertex layout.
+ * \note attribMutex must be held.
+ */
+ColorFloat Shape::getVertexColor(int index) {
+    if (myMesh) {
+        GLfloat * v = myMesh->vertices + myMesh->indices[index] * 7;
+        return ColorFloat(v[3] * myTint.R, v[4] * myTint.G, v[5] * myTint.B, v[6] * myTint.A);
+    }
+    if (init && myFormat == VERTEX_UNIFORM)
+        return myTint;
+    return unpackColor(vertices + index * PACKED_VERTEX_FLOATS + 3);
+}
+
+/*!
+ * \brief Mutator for the color of one of the Shape's vertices.
+ * \details A Shape whose vertices shared one color is first given per-vertex colors.
+ *   \param index The position of the vertex in drawing order.
+ *   \param color The vertex's new color.
+ * \note attribMutex must be held, and the Shape must not draw a shared mesh (see detachMesh()).
+ */
+void Shape::setVertexColor(int index, const ColorFloat &color) {
+    if (init && myFormat == VERTEX_UNIFORM)
+        packVertices();
+    packColor(vertices + index * PACKED_VERTEX_FLOATS + 3, color);
+}
+
+/*!
+ * \brief Moves one of the Shape's vertices.
+ *   \param index The position of the vertex in drawing order.
+ *   \param x The new x coordinate of the vertex.
+ *   \param y The new y coordinate of the vertex.
+ *   \param z The new z coordinate of the vertex.
+ * \note attribMutex must be held.
+ */
+void Shape::setVertexPosition(int index, GLfloat x, GLfloat y, GLfloat z) {
+    GLfloat * v = vertices + index * floatsPerVertex(init ? myFormat : VERTEX_PACKED);
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+}
+
+/*!
+ * \brief Moves one of the Shape's outline vertices.
+ *   \param index The position of the outline vertex in drawing order.
+ *   \param x The new x coordinate of the vertex.
+ *   \param y The new y coordinate of the vertex.
+ *   \param z The new z coordinate of the vertex.
+ * \note attribMutex must be held.
+ */
+void Shape::setOutlineVertexPosition(int index, GLfloat x, GLfloat y, GLfloat z) {
+    GLfloat * v = outlineVertices + index * floatsPerVertex(outlineInit ? myOutlineFormat : VERTEX_PACKED);
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+}
+
+/*!
+ * \brief Adds every vertex of a Shape at once.
+ * \details Equivalent to calling addVertex() numberOfVertices times, but locks attribMutex once and writes
+ *   the vertices straight into their final layout: positions only if they all share one color, or packed otherwise.
+ *   \param x The x coordinates of the vertices.
+ *   \param y The y coordinates of the vertices.
+ *   \param z The z coordinates of the vertices, or nullptr if they are all 0.
+ *   \param originX Subtracted from each x coordinate, to make it relative to the Shape's center.
+ *   \param originY Subtracted from each y coordinate.
+ *   \param originZ Subtracted from each z coordinate.
+ *   \param color The color of every vertex, if colors is nullptr.
+ *   \param colors The color of each vertex (optional).
+ * \note This function does nothing if any vertex has already been added.
+ */
+void Shape::addVertices(const GLfloat x[], const GLfloat y[], const GLfloat z[], GLfloat originX, GLfloat originY, GLfloat originZ,
+                        const ColorFloat &color, const ColorFloat colors[]) {
+    attribMutex.lock();
+    if (init || currentVertex > 0) {
+        TsglDebug("Cannot add anymore vertices.");
+        attribMutex.unlock();
+        return;
+    }
+    bool uniform = true;
+    if (colors) {
+        for (int i = 1; i < numberOfVertices && uniform; i++)
+            uniform = colors[i].R == colors[0].R && colors[i].G == colors[0].G && colors[i].B == colors[0].B && colors[i].A == colors[0].A;
+    }
+    myFormat = uniform ? VERTEX_UNIFORM : VERTEX_PACKED;
+    int stride = floatsPerVertex(myFormat);
+    if (uniform) {
+        delete[] vertices;
+        vertices = new GLfloat[numberOfVertices * 3];
+    }
+    for (int i = 0; i < numberOfVertices; i++) {
+        GLfloat * v = vertices + i * stride;
+        v[0] = x[i] - originX;
+        v[1] = y[i] - originY;
+        v[2] = (z ? z[i] : 0) - originZ;
+    }
+    if (uniform) {
+        myTint = colors && numberOfVertices > 0 ? colors[0] : color;
+        myAlpha = myTint.A;
+    } else {
+        myAlpha = 0;
+        for (int i = 0; i < numberOfVertices; i++) {
+            packColor(vertices + i * PACKED_VERTEX_FLOATS + 3, colors[i]);
+            myAlpha += colors[i].A;
+        }
+        myAlpha /= numberOfVertices;
+    }
+    currentVertex = numberOfVertices;
+    init = true;
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Adds every outline vertex of a Shape at once, all in one color.
+ * \details Equivalent to calling addOutlineVertex() numberOfOutlineVertices times with the same color, but locks
+ *   attribMutex once and stores only the vertices' positions.
+ *   \param x The x coordinates of the outline vertices.
+ *   \param y The y coordinates of the outline vertices.
+ *   \param z The z coordinates of the outline vertices, or nullptr if they are all 0.
+ *   \param originX Subtracted from each x coordinate, to make it relative to the Shape's center.
+ *   \param originY Subtracted from each y coordinate.
+ *   \param originZ Subtracted from each z coordinate.
+ *   \param color The color of the outline.
+ * \note This function does nothing if any outline vertex has already been added.
+ */
+void Shape::addOutlineVertices(const GLfloat x[], const GLfloat y[], const GLfloat z[], GLfloat originX, GLfloat originY, GLfloat originZ,
+                               const ColorFloat &color) {
+    attribMutex.lock();
+    if (outlineInit || currentOutlineVertex > 0) {
+        TsglDebug("Cannot add anymore vertices.");
+        attribMutex.unlock();
+        return;
+    }
+    delete[] outlineVertices;
+    outlineVertices = new GLfloat[numberOfOutlineVertices * 3];
+    for (int i = 0; i < numberOfOutlineVertices; i++) {
+        outlineVertices[i*3] = x[i] - originX;
+        outlineVertices[i*3 + 1] = y[i] - originY;
+        outlineVertices[i*3 + 2] = (z ? z[i] : 0) - originZ;
+    }
+    myOutlineFormat = VERTEX_UNIFORM;
+    myOutlineTint = color;
+    currentOutlineVertex = numberOfOutlineVertices;
+    outlineInit = true;
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Moves, and optionally recolors, a range of a Shape's vertices in place.
+ * \details Coordinates are given as to the constructors: in world units, and not yet made relative to the
+ *   Shape's center, which is subtracted here (as is any scale the Shape applies to its vertices). Outline vertices
+ *   made from the same points follow them; a Shape whose fill has n more vertices than its outline (such as a
+ *   Circle's center) is taken to have outline vertex i at fill vertex i + n.
+ *   \param first The index of the first vertex to change.
+ *   \param count The number of vertices to change.
+ *   \param x The new x coordinates of the vertices.
+ *   \param y The new y coordinates of the vertices.
+ *   \param z The new z coordinates of the vertices, or nullptr to keep them in the Shape's plane.
+ *   \param colors The new colors of the vertices, or nullptr to leave them alone.
+ * \return Whether the range was valid; nothing is changed if it was not.
+ * \note attribMutex must be held, and the Shape must not draw a shared mesh (see detachMesh()).
+ */
+bool Shape::writeVertices(int first, int count, const GLfloat x[], const GLfloat y[], const GLfloat z[], const ColorFloat colors[]) {
+    if (!init || first < 0 || count < 0 || first + count > numberOfVertices) {
+        TsglDebug("Cannot update vertices outside of a Shape.");
+        return false;
+    }
+    Transform t = getTransform();
+    int stride = floatsPerVertex(myFormat);
+    for (int i = 0; i < count; i++) {
+        GLfloat * v = vertices + (first + i) * stride;
+        v[0] = (x[i] - t.centerX) / t.xScale;
+        v[1] = (y[i] - t.centerY) / t.yScale;
+        v[2] = z ? (z[i] - t.centerZ) / t.zScale : 0;
+    }
+    if (outlineVertices && outlineInit && !outlineIndices) {
+        int offset = numberOfVertices - numberOfOutlineVertices;
+        int outlineStride = floatsPerVertex(myOutlineFormat);
+        for (int i = std::max(first, offset); i < first + count; i++) {
+            const GLfloat * v = vertices + i * stride;
+            GLfloat * o = outlineVertices + (i - offset) * outlineStride;
+            o[0] = v[0];
+            o[1] = v[1];
+            o[2] = v[2];
+        }
+    }
+    if (colors) {
+        for (int i = 0; i < count; i++)
+            setVertexColor(first + i, colors[i]);
+    }
+    return true;
+}
+
+/*!
+ * \brief Strips the colors from an array of VERTEX_PACKED vertices.
+ *   \param packed The packed vertices, which are deleted.
+ *   \param count The number of vertices.
+ * \return A new array holding just the positions of the vertices.
+ */
+GLfloat * Shape::dropColors(GLfloat * packed, int count) {
+    GLfloat * positions = new GLfloat[count * 3];
+    for (int i = 0; i < count; i++) {
+        positions[i*3] = packed[i * PACKED_VERTEX_FLOATS];
+        positions[i*3 + 1] = packed[i * PACKED_VERTEX_FLOATS + 1];
+        positions[i*3 + 2] = packed[i * PACKED_VERTEX_FLOATS + 2];
+    }
+    delete[] packed;
+    return positions;
+}
+
+/*!
+ * \brief Gives a VERTEX_UNIFORM Shape per-vertex colors again, each set to its uniform color.
+ * \note attribMutex must be held.
+ */
+void Shape::packVertices() {
+    GLfloat * packed = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
+    for (int i = 0; i < numberOfVertices; i++) {
+        GLfloat * v = packed + i * PACKED_VERTEX_FLOATS;
+        v[0] = vertices[i*3];
+        v[1] = vertices[i*3 + 1];
+        v[2] = vertices[i*3 + 2];
+        packColor(v + 3, myTint);
+    }
+    delete[] vertices;
+    vertices = packed;
+    myFormat = VERTEX_PACKED;
+}
+
 /**
  * \brief Sets the Shape to a new color.
+ * \details Once the Shape is constructed this takes constant time: a Shape with per-vertex colors drops them,
+ *   and from then on only its uniform color changes.
  * \param c The new ColorFloat.
  */
 void Shape::setColor(ColorFloat c) {
     attribMutex.lock();
     myAlpha = c.A;
-    for(int i = 0; i < numberOfVertices; i++) {
-        vertices[i*7 + 3] = c.R;
-        vertices[i*7 + 4] = c.G;
-        vertices[i*7 + 5] = c.B;
-        vertices[i*7 + 6] = c.A;
+    myTint = c;
+    if (myMesh || (init && myFormat == VERTEX_UNIFORM)) {
+        attribMutex.unlock();
+        return;
+    }
+    if (init) {
+        vertices = dropColors(vertices, numberOfVertices);
+        myFormat = VERTEX_UNIFORM;
+    } else {
+        for(int i = 0; i < currentVertex; i++)
+            packColor(vertices + i * PACKED_VERTEX_FLOATS + 3, c);
     }
     attribMutex.unlock();
 }
@@ -132,12 +459,10 @@ void Shape::setColor(ColorFloat c) {
  */
 void Shape::setColor(ColorFloat c[]) {
     attribMutex.lock();
+    detachMesh();
     myAlpha = 0.0;
     for(int i = 0; i < numberOfVertices; i++) {
-        vertices[i*7 + 3] = c[i].R;
-        vertices[i*7 + 4] = c[i].G;
-        vertices[i*7 + 5] = c[i].B;
-        vertices[i*7 + 6] = c[i].A;
+        setVertexColor(i, c[i]);
         myAlpha += c[i].A;
     }
     myAlpha /= numberOfVertices;
@@ -150,11 +475,13 @@ void Shape::setColor(ColorFloat c[]) {
  */
 void Shape::setOutlineColor(ColorFloat c) {
     attribMutex.lock();
-    for(int i = 0; i < numberOfOutlineVertices; i++) {
-        outlineVertices[i*7 + 3] = c.R;
-        outlineVertices[i*7 + 4] = c.G;
-        outlineVertices[i*7 + 5] = c.B;
-        outlineVertices[i*7 + 6] = c.A;
+    myOutlineTint = c;
+    if (outlineInit && !myMesh && !outlineIndices && myOutlineFormat == VERTEX_PACKED) {
+        outlineVertices = dropColors(outlineVertices, numberOfOutlineVertices);
+        myOutlineFormat = VERTEX_UNIFORM;
+    } else if (!outlineInit) {
+        for(int i = 0; i < currentOutlineVertex; i++)
+            packColor(outlineVertices + i * PACKED_VERTEX_FLOATS + 3, c);
     }
     attribMutex.unlock();
 }
@@ -166,8 +493,8 @@ void Shape::setOutlineColor(ColorFloat c) {
  */
 ColorFloat Shape::getColor() {
     attribMutex.lock();
-    ColorFloat c = ColorFloat(vertices[3], vertices[4], vertices[5], vertices[6]);
-    attribMutex.unlock();
+    ColorFloat c = getVertexColor(0);
+    attribMutex.unlockUnchanged();
     return c;
 }
 
@@ -179,9 +506,17 @@ ColorFloat Shape::getColor() {
 void Shape::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
     for (int i = 0; i < numberOfVertices; i++) {
-        colorVec.push_back(ColorFloat(vertices[i*7+3],vertices[i*7+4],vertices[i*7+5],vertices[i*7+6]));
+        colorVec.push_back(getVertexColor(i));
     }
-    attribMutex.unlock();
+    attribMutex.unlockUnchanged();
 }
 
-}
\ No newline at end of file
+/*!
+ * \brief Destructor for the Shape.
+ * \details Releases the Shape's shared mesh, if it has one.
+ */
+Shape::~Shape() {
+    GeometryCache::release(myMesh);
+}
+
+}
@@ -8,6 +8,7 @@
 #include <GL/glew.h>    // Needed for GL function calls
 #include "Color.h"      // Needed for color type
 #include "Drawable.h"
+#include "GeometryCache.h" // For sharing unit meshes between 3D shapes
 
 namespace tsgl {
 
@@ -17,12 +18,22 @@ namespace tsgl {
  *  could potentially mess up the internal GL calls the library uses. Proceed with great caution.</i></b>
  *  \details Shape provides a base class for drawing shapes to a Canvas or CartesianCanvas.
  *  \note Shape is abstract, and must be extended by the user.
- *  \details <code>vertices</code> should be an array of floating point values in TSGL's vertex format.
- *  One vertex consists of 6 floating point values, signifying x,y,red,green,blue,and alpha components respectively.
- *  E.g., to draw a triangle, you would need 3 vertices = 18 floats -> vertices should be an array of length 18.
+ *  \details <code>vertices</code> should be an array of <code>numberOfVertices * PACKED_VERTEX_FLOATS</code> floating point
+ *  values, filled with addVertex(). One vertex consists of its x, y and z coordinates followed by its color, packed into
+ *  a single 32-bit RGBA word. Once every vertex has been added, a Shape whose vertices all share one color drops their
+ *  colors and keeps only positions (VERTEX_UNIFORM), drawing the color as a constant instead; setColor() then costs
+ *  the same for a Shape of any size. Subclasses should read and write vertices after construction only through
+ *  getVertexColor(), setVertexColor() and setVertexPosition(), which know the Shape's current layout.
+ *  \details Subclasses built from whole arrays of vertices should fill them with addVertices() and addOutlineVertices(),
+ *  which write every vertex in one pass under a single lock, straight into the final layout.
  *  \details <code>numberofvertices</code> should be the actual integer number of vertices to be drawn (e.g., *3* for a triangle).
  *  \details <code>drawingmode</code> should be one of GL's primitive drawing modes.
  *  See https://www.opengl.org/sdk/docs/man2/xhtml/glBegin.xml for further information.
+ *  \details A Shape may also set <code>indices</code> to draw <code>vertices</code> with glDrawElements(), so that vertices
+ *  shared by several triangles are stored once. Its outline may then be given as <code>outlineIndices</code> into the same
+ *  vertices instead of as separate <code>outlineVertices</code>.
+ *  \details Shapes whose vertices never differ between instances (such as Sphere and Prism) may instead draw a mesh
+ *  shared through GeometryCache, in which case <code>vertices</code> is null and the Shape's color is applied as a tint.
  *  \details Theoretically, you could potentially extend the Shape class so that you can create another Shape class that suits your needs.
  *  \details However, this is not recommended for normal use of the TSGL library.
  */
@@ -38,11 +49,37 @@ class Shape : public Drawable {
    int currentOutlineVertex = 0;
    GLenum outlineGeometryType;
    virtual void addOutlineVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color = WHITE);
-   GLfloat * outlineVertices;
+   GLfloat * outlineVertices = nullptr;
    bool isOutlined = true;
 
    bool outlineInit = false;
 
+   const GLuint * indices = nullptr;           // Order in which to draw vertices, if they are indexed
+   int numberOfIndices = 0;
+   const GLuint * outlineIndices = nullptr;    // Vertices to outline, if the outline reuses them
+   int numberOfOutlineIndices = 0;
+
+   GeometryCache::Mesh * myMesh = nullptr;     // Shared vertices, if this Shape draws a unit mesh
+   ColorFloat myTint, myOutlineTint;           // Color of a mesh or VERTEX_UNIFORM fill; of an indexed or uniform outline
+   int myDetail = 0;                           // Tessellation at which to draw myMesh, or 0 to choose from screen size
+   void useMesh(MeshKind kind, int tessellation, const ColorFloat &color);
+   void detachMesh();
+
+   VertexFormat myFormat = VERTEX_UNIFORM;      // Layout of vertices; until init, whether every color so far matched
+   VertexFormat myOutlineFormat = VERTEX_UNIFORM;
+   ColorFloat getVertexColor(int index);
+   void setVertexColor(int index, const ColorFloat &color);
+   void setVertexPosition(int index, GLfloat x, GLfloat y, GLfloat z);
+   void setOutlineVertexPosition(int index, GLfloat x, GLfloat y, GLfloat z);
+   void addVertices(const GLfloat x[], const GLfloat y[], const GLfloat z[], GLfloat originX, GLfloat originY, GLfloat originZ,
+                    const ColorFloat &color, const ColorFloat colors[] = nullptr);
+   void addOutlineVertices(const GLfloat x[], const GLfloat y[], const GLfloat z[], GLfloat originX, GLfloat originY, GLfloat originZ,
+                           const ColorFloat &color);
+   bool writeVertices(int first, int count, const GLfloat x[], const GLfloat y[], const GLfloat z[], const ColorFloat colors[]);
+ private:
+   static GLfloat * dropColors(GLfloat * packed, int count);
+   void packVertices();
+
  public:
     Shape(float x, float y, float z, float yaw, float pitch, float roll);
 
@@ -70,7 +107,7 @@ class Shape : public Drawable {
      */
     virtual void setIsOutlined(bool status) { isOutlined = status; }
 
-    ~Shape() { /* delete [] vertices; */ }
+    virtual ~Shape();
 };
 
 }
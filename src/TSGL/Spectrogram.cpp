@@ -16,6 +16,35 @@ const float Spectrogram::PI = 3.149f;
   * \return A new Spectrogram with the specified drawing mode and size.
   */
 Spectrogram::Spectrogram(SpectrogramDrawmode drawMode, int width, int height) {
+    init(drawMode, width, height);
+    can = new Canvas(-1, 0, myWidth, myHeight ,"");
+    myViewport = nullptr;
+    ownsCanvas = true;
+    can->start();
+}
+
+ /*!
+  * \brief Constructs a Spectrogram drawn on a Canvas it shares.
+  * \details The Spectrogram is drawn into a new Viewport of <code>host</code>, instead of opening a window of its own.
+  *   \param host The Canvas to draw the Spectrogram on, which must outlive the Spectrogram.
+  *   \param x The x coordinate in pixels of the left of the Spectrogram, from the left of host's window.
+  *   \param y The y coordinate in pixels of the top of the Spectrogram, from the top of host's window.
+  *   \param drawMode Method used for displaying spectral data. Can be one of CIRCULAR
+  *     or HORIZONTAL.
+  *   \param width The width of the Spectrogram.
+  *   \param height The height of the Spectrogram. This value is ignored for
+  *     HORIZONTAL Spectrograms. Setting this to -1 sets the width automatically.
+  * \return A new Spectrogram with the specified drawing mode and size.
+  */
+Spectrogram::Spectrogram(Canvas& host, int x, int y, SpectrogramDrawmode drawMode, int width, int height) {
+    init(drawMode, width, height);
+    can = &host;
+    myViewport = host.addViewport(x, y, myWidth, myHeight, GRAY);
+    ownsCanvas = false;
+}
+
+// Sets up the Spectrogram's locks and geometry for either constructor
+void Spectrogram::init(SpectrogramDrawmode drawMode, int width, int height) {
     for (int i = 0; i < NUM_COLORS; ++i) {
         omp_init_lock(&(writelock[i]));
     }
@@ -28,7 +57,6 @@ Spectrogram::Spectrogram(SpectrogramDrawmode drawMode, int width, int height) {
     else if (myDrawMode == VERTICAL)
         myWidth = NUM_COLORS;
 
-    can = new Canvas(-1, 0, myWidth, myHeight ,"");
     maxCount = 0;
     count[0] = 0;
     xx[0] = (myWidth)/2;
@@ -39,8 +67,8 @@ Spectrogram::Spectrogram(SpectrogramDrawmode drawMode, int width, int height) {
     centerY = 0;
     for (unsigned i = 1; i < NUM_COLORS; ++i) {
         count[i] = 0;
-        xx[i] = (myWidth + myWidth*cos((2*PI*i)/NUM_COLORS))/2 - can->getWindowWidth() / 2;
-        yy[i] = (myHeight + myHeight*sin((2*PI*i)/NUM_COLORS))/2 - can->getWindowHeight() / 2;
+        xx[i] = (myWidth + myWidth*cos((2*PI*i)/NUM_COLORS))/2 - myWidth / 2;
+        yy[i] = (myHeight + myHeight*sin((2*PI*i)/NUM_COLORS))/2 - myHeight / 2;
         col[i] = ColorHSV(6.0f*i/255.0f,1.0f,1.0f);
         black[i] = col[i] * 0.25f;
         centerX += xx[i];
@@ -57,7 +85,6 @@ Spectrogram::Spectrogram(SpectrogramDrawmode drawMode, int width, int height) {
         maxx[k] = xx[k];
         maxy[k] = yy[k];
     }
-    can->start();
 }
 
  /*!
@@ -69,7 +96,8 @@ Spectrogram::~Spectrogram() {
     for (int i = 0; i < NUM_COLORS; ++i)
         omp_destroy_lock(&(writelock[i]));
     omp_destroy_lock(&masterlock);
-    delete can;
+    if (ownsCanvas)
+        delete can;
 }
 
  /*!
@@ -143,7 +171,7 @@ void Spectrogram::updateCritical(int index, float weight, float decay) {
   */
 void Spectrogram::draw(float ratio) {
     if (maxCount > 0) {
-        Background * bg = can->getBackground();
+        Background * bg = myViewport ? myViewport->getBackground() : can->getBackground();
         const float DELTA = (2*PI)/NUM_COLORS;
         float localmax = maxCount;
         float invcount = 1.0f/localmax;
@@ -165,14 +193,14 @@ void Spectrogram::draw(float ratio) {
         case HORIZONTAL:
             can->pauseDrawing();
             for (int k = 0; k < MAX_COLOR; ++k)
-                bg->drawLine(-can->getWindowWidth()/2,k - can->getWindowHeight()/2,0,(ratio*myWidth*count[k])/localmax - can->getWindowWidth()/2,k - can->getWindowHeight()/2,0, 0,0,0, ColorHSV((6.0f*k)/MAX_COLOR,1.0f,1.0f));
+                bg->drawLine(-myWidth/2,k - myHeight/2,0,(ratio*myWidth*count[k])/localmax - myWidth/2,k - myHeight/2,0, 0,0,0, ColorHSV((6.0f*k)/MAX_COLOR,1.0f,1.0f));
             can->resumeDrawing();
             break;
         case VERTICAL:
             can->pauseDrawing();
             //  can->clear();
             for (int k = 0; k < MAX_COLOR; ++k)
-                bg->drawLine(k-can->getWindowWidth()/2,myHeight - can->getWindowHeight()/2,0,k - can->getWindowWidth()/2,myHeight-(ratio*myHeight*count[k])/localmax - can->getWindowHeight()/2,0, 0,0,0, ColorHSV((6.0f*k)/MAX_COLOR,1.0f,1.0f));
+                bg->drawLine(k-myWidth/2,myHeight - myHeight/2,0,k - myWidth/2,myHeight-(ratio*myHeight*count[k])/localmax - myHeight/2,0, 0,0,0, ColorHSV((6.0f*k)/MAX_COLOR,1.0f,1.0f));
             can->resumeDrawing();
             break;
         }
@@ -183,9 +211,11 @@ void Spectrogram::draw(float ratio) {
   * \brief Finishes the spectrogram.
   * \details This function tells the Spectrogram to free all of its memory and close
   *   down its Canvas.
+  * \note A Spectrogram drawn on a shared Canvas leaves waiting for it to its owner.
   */
 void Spectrogram::finish() {
-    can->wait();
+    if (ownsCanvas)
+        can->wait();
 }
 
 }
@@ -23,6 +23,8 @@ enum SpectrogramDrawmode {
  *  \details Spectrogram is a class for visualizing data as a color spectrum.
  *    This data will typically be hues, but Spectrogram will accept any data
  *    mapping to an integer value between 0 and 255.
+ *  \details A Spectrogram opens its own window, unless it is given a Canvas to share, on which it
+ *    draws into a Viewport of its own.
  */
 class Spectrogram {
 private:
@@ -38,9 +40,15 @@ private:
   ColorFloat col[NUM_COLORS+1], black[NUM_COLORS+1];
   SpectrogramDrawmode myDrawMode;
   Canvas* can;
+  Viewport* myViewport;    // Where the Spectrogram is drawn on a Canvas it shares, if it doesn't have its own
+  bool ownsCanvas;
+
+  void init(SpectrogramDrawmode drawMode, int width, int height);
 public:
   Spectrogram(SpectrogramDrawmode drawMode, int width, int height = -1);
 
+  Spectrogram(Canvas& host, int x, int y, SpectrogramDrawmode drawMode, int width, int height = -1);
+
   ~Spectrogram();
 
   void updateLocked(int index, float weight = 1.0f, float decay = 0.8f);
@@ -28,44 +28,9 @@ Sphere::Sphere(float x, float y, float z, GLfloat radius, float yaw, float pitch
     myZScale = radius;
     verticalSections = 36;
     horizontalSections = 20;
-    geometryType = GL_TRIANGLE_STRIP;
-    numberOfVertices = verticalSections*horizontalSections*2 + 1;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = verticalSections*horizontalSections*4 + 1;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     isOutlined = false;
-    attribMutex.unlock();  
-	for(float b=0;b<horizontalSections;b++)
-	{
-		for(float a=0;a<verticalSections;a++)
-		{
-			addVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), ColorFloat(c.R * (1 - 1 * sin(a/verticalSections * PI) / 2), c.G * (1 - 1 * sin(a/verticalSections * PI) / 2), c.B * (1 - 1 * sin(a/verticalSections * PI) / 2), 1));
-			addVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), ColorFloat(c.R * (1 - 1 * sin(a/verticalSections * PI) / 2), c.G * (1 - 1 * sin(a/verticalSections * PI) / 2), c.B * (1 - 1 * sin(a/verticalSections * PI) / 2), 1));
-		}
-	}
-    addVertex(0, 1, 0, c);
-
-    // horizontal outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-
-    // vertical outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin(((a+1)*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos(((a+1)*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin(((a+1)*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-    addOutlineVertex(0, 1, 0, GRAY);
+    useMesh(MESH_SPHERE, verticalSections, c);
+    attribMutex.unlock();
 }
 
  /*!
@@ -95,10 +60,10 @@ Sphere::Sphere(float x, float y, float z, GLfloat radius, float yaw, float pitch
     horizontalSections = 20;
     geometryType = GL_TRIANGLE_STRIP;
     numberOfVertices = verticalSections*horizontalSections*2 + 1;
-    vertices = new GLfloat[numberOfVertices * 7];
+    vertices = new GLfloat[numberOfVertices * PACKED_VERTEX_FLOATS];
     outlineGeometryType = GL_LINES;
     numberOfOutlineVertices = verticalSections*horizontalSections*4 + 1;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    outlineVertices = new GLfloat[numberOfOutlineVertices * PACKED_VERTEX_FLOATS];
     isOutlined = false;
     attribMutex.unlock();
 	for(int b=0;b<horizontalSections;b++)
@@ -144,9 +109,11 @@ void Sphere::setRadius(float radius) {
     }
     attribMutex.lock();
     myRadius = radius;
+    beginTransform();
     myXScale = radius;
     myYScale = radius;
     myZScale = radius;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -161,9 +128,11 @@ void Sphere::changeRadiusBy(float delta) {
     }
     attribMutex.lock();
     myRadius += delta;
+    beginTransform();
     myXScale += delta;
     myYScale += delta;
     myZScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -172,26 +141,22 @@ void Sphere::changeRadiusBy(float delta) {
  * \param c The new ColorFloat.
  */
 void Sphere::setColor(ColorFloat c) {
+    if (myMesh) {
+        Shape::setColor(c);
+        return;
+    }
     attribMutex.lock();
     myAlpha = c.A;
 	for(int b=0;b<horizontalSections;b++)
 	{
 		for(int a=0;a<verticalSections;a++)
 		{
-			vertices[(b*verticalSections + a)*2*7 + 3] = c.R * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 4] = c.G * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 5] = c.B * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 6] = c.A;
-			vertices[(b*verticalSections + a)*2*7 + 10] = c.R * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 11] = c.G * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 12] = c.B * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 13] = c.A;
+            float shade = 1 - 1 * sin(((float)a)/verticalSections * PI) / 2;
+			setVertexColor((b*verticalSections + a)*2, ColorFloat(c.R * shade, c.G * shade, c.B * shade, c.A));
+			setVertexColor((b*verticalSections + a)*2 + 1, ColorFloat(c.R * shade, c.G * shade, c.B * shade, c.A));
 		}
 	}
-    vertices[horizontalSections*verticalSections*2*7+3] = c.R;
-    vertices[horizontalSections*verticalSections*2*7+4] = c.G;
-    vertices[horizontalSections*verticalSections*2*7+5] = c.B;
-    vertices[horizontalSections*verticalSections*2*7+6] = c.A;
+    setVertexColor(horizontalSections*verticalSections*2, c);
     attribMutex.unlock();
 }
 
@@ -202,26 +167,18 @@ void Sphere::setColor(ColorFloat c) {
  */
 void Sphere::setColor(ColorFloat c[]) {
     attribMutex.lock();
+    detachMesh();
     myAlpha = 0.0;
 	for(int b=0;b<horizontalSections;b++)
 	{
 		for(int a=0;a<verticalSections;a++)
 		{
-			vertices[(b*verticalSections + a)*2*7 + 3] = c[b].R;
-            vertices[(b*verticalSections + a)*2*7 + 4] = c[b].G;
-            vertices[(b*verticalSections + a)*2*7 + 5] = c[b].B;
-            vertices[(b*verticalSections + a)*2*7 + 6] = c[b].A;
-			vertices[(b*verticalSections + a)*2*7 + 10] = c[b].R;
-            vertices[(b*verticalSections + a)*2*7 + 11] = c[b].G;
-            vertices[(b*verticalSections + a)*2*7 + 12] = c[b].B;
-            vertices[(b*verticalSections + a)*2*7 + 13] = c[b].A;
+			setVertexColor((b*verticalSections + a)*2, c[b]);
+			setVertexColor((b*verticalSections + a)*2 + 1, c[b]);
             myAlpha += c[b].A * 2;
 		}
 	}
-    vertices[horizontalSections*verticalSections*2*7+3] = c[horizontalSections].R;
-    vertices[horizontalSections*verticalSections*2*7+4] = c[horizontalSections].G;
-    vertices[horizontalSections*verticalSections*2*7+5] = c[horizontalSections].B;
-    vertices[horizontalSections*verticalSections*2*7+6] = c[horizontalSections].A;
+    setVertexColor(horizontalSections*verticalSections*2, c[horizontalSections]);
     myAlpha += c[horizontalSections].A;
     myAlpha /= numberOfVertices;
     attribMutex.unlock();
@@ -236,14 +193,27 @@ void Sphere::setColor(ColorFloat c[]) {
 void Sphere::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
     for(int b=0;b<horizontalSections;b++) {
-        colorVec.push_back(ColorFloat(
-            vertices[(b*verticalSections)*2*7 + 3],
-            vertices[(b*verticalSections)*2*7 + 4],
-            vertices[(b*verticalSections)*2*7 + 5],
-            vertices[(b*verticalSections)*2*7 + 6])
-            );
+        colorVec.push_back(getVertexColor(b*verticalSections*2));
+    }
+    attribMutex.unlockUnchanged();
+}
+
+/**
+ * \brief Sets the number of vertical sections with which the Sphere is drawn.
+ * \details By default a Sphere's level of detail is chosen every frame from the size it covers on screen:
+ *   a large Sphere is drawn with 36 vertical sections, and smaller ones with 18 or 9, so that distant
+ *   Spheres cost a few dozen triangles each. This overrides that choice.
+ * \param sections The number of vertical sections (at least 3), or 0 to choose automatically again.
+ * \note Has no effect on a Sphere that has been given per-section colors, which is always drawn in full.
+ */
+void Sphere::setLevelOfDetail(int sections) {
+    if (sections != 0 && sections < 3) {
+        TsglDebug("Cannot draw a Sphere with fewer than 3 sections.");
+        return;
     }
+    attribMutex.lock();
+    myDetail = sections;
     attribMutex.unlock();
 }
 
-}
\ No newline at end of file
+}
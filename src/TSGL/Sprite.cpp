@@ -0,0 +1,172 @@
+#include "Sprite.h"
+#include "SpriteSheet.h"
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new Sprite.
+  * \details This is the explicit constructor for the Sprite class.
+  *   \param x The x coordinate of the center of the Sprite.
+  *   \param y The y coordinate of the center of the Sprite.
+  *   \param z The z coordinate of the center of the Sprite.
+  *   \param sheet The SpriteSheet that the Sprite shows a region of, and that will draw it.
+  *   \param region The index of the region of sheet to show.
+  *   \param width The width of the Sprite.
+  *   \param height The height of the Sprite.
+  *   \param yaw The yaw orientation of the Sprite.
+  *   \param pitch The pitch orientation of the Sprite.
+  *   \param roll The roll orientation of the Sprite.
+  *   \param alpha The alpha of the Sprite.
+  * \return A new Sprite that sheet will draw with the specified coordinates, dimensions, and transparency.
+  */
+Sprite::Sprite(float x, float y, float z, SpriteSheet * sheet, unsigned region, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha) : Drawable(x,y,z,yaw,pitch,roll) {
+    vertices = nullptr;
+    mySheet = nullptr;
+    if (!sheet) {
+        TsglDebug("Cannot have a Sprite without a SpriteSheet.");
+        return;
+    }
+    if (width <= 0 || height <= 0) {
+        TsglDebug("Cannot have a Sprite with width or height less than or equal to 0.");
+        return;
+    }
+    if (alpha < 0.0 || alpha > 1.0) {
+        TsglDebug("Cannot have a Sprite with alpha not between 0.0 and 1.0.");
+        return;
+    }
+    attribMutex.lock();
+    shaderType = TEXTURE_SHADER_TYPE;
+    myWidth = width; myHeight = height;
+    myXScale = width; myYScale = height; myZScale = 1;
+    myRegion = region;
+    myAlpha = alpha;
+    isVisible = true;
+    mySheet = sheet;
+    attribMutex.unlock();
+    sheet->addSprite(this);
+}
+
+/**
+ * \brief Mutates the distance from the left side of the Sprite to its right side.
+ * \param width The Sprite's new width.
+ */
+void Sprite::setWidth(GLfloat width) {
+    if (width <= 0) {
+        TsglDebug("Cannot have a Sprite with width less than or equal to 0.");
+        return;
+    }
+    attribMutex.lock();
+    myWidth = width;
+    beginTransform();
+    myXScale = width;
+    endTransform();
+    attribMutex.unlock();
+}
+
+/**
+ * \brief Mutates the distance from the top side of the Sprite to its bottom side.
+ * \param height The Sprite's new height.
+ */
+void Sprite::setHeight(GLfloat height) {
+    if (height <= 0) {
+        TsglDebug("Cannot have a Sprite with height less than or equal to 0.");
+        return;
+    }
+    attribMutex.lock();
+    myHeight = height;
+    beginTransform();
+    myYScale = height;
+    endTransform();
+    attribMutex.unlock();
+}
+
+/**
+ * \brief Changes which region of its SpriteSheet the Sprite shows.
+ * \param region The index of the new region.
+ * \note A Sprite with a region its SpriteSheet doesn't have is not drawn.
+ */
+void Sprite::setRegion(unsigned region) {
+    attribMutex.lock();
+    myRegion = region;
+    attribMutex.unlock();
+}
+
+/**
+ * \brief Shows or hides the Sprite.
+ * \param visible Whether the SpriteSheet should draw the Sprite.
+ */
+void Sprite::setVisible(bool visible) {
+    attribMutex.lock();
+    isVisible = visible;
+    attribMutex.unlock();
+}
+
+/**
+ *  \brief Alters the Sprite's transparency
+ *  \param alpha The Sprite's new alpha value.
+ *  \note If parameter not 0.0 <= alpha <= 1.0 then this method will have no effect.
+ */
+void Sprite::setAlpha(float alpha) {
+    if (alpha < 0.0 || alpha > 1.0) {
+        TsglDebug("Cannot have a Sprite with alpha not 0.0 <= alpha <= 1.0.");
+        return;
+    }
+    attribMutex.lock();
+    myAlpha = alpha;
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Writes the Sprite's two triangles into a SpriteSheet's vertex batch.
+ * \details The Sprite's corners are transformed into world space so that every Sprite in a batch can share one
+ *   model matrix.
+ *   \param out Where to write the 30 floats (position x,y,z and texture coordinates u,v of 6 vertices).
+ *   \param regionCoords The u0, v0, u1, v1 texture coordinates of each of the SpriteSheet's regions.
+ *   \param regionCount The number of regions in regionCoords.
+ *   \param alpha Set to the Sprite's alpha value.
+ * \return True if vertices were written, false if the Sprite is hidden or its region doesn't exist.
+ * \note Called by SpriteSheet::draw().
+ */
+bool Sprite::writeVertices(GLfloat * out, const GLfloat * regionCoords, unsigned regionCount, float& alpha) {
+    attribMutex.lock();
+    if (!isVisible || !mySheet || myRegion >= regionCount) {
+        attribMutex.unlock();
+        return false;
+    }
+    glm::mat4 model = getModelMatrix();
+    alpha = myAlpha;
+    const GLfloat * uv = regionCoords + myRegion * 4;
+    attribMutex.unlock();
+
+    // same corners as Image: top right, bottom right, bottom left, top right, bottom left, top left
+    const float corners[6][2] = { {0.5f, 0.5f}, {0.5f, -0.5f}, {-0.5f, -0.5f}, {0.5f, 0.5f}, {-0.5f, -0.5f}, {-0.5f, 0.5f} };
+    for (int i = 0; i < 6; i++) {
+        glm::vec4 p = model * glm::vec4(corners[i][0], corners[i][1], 0.0f, 1.0f);
+        out[i*5]     = p.x;
+        out[i*5 + 1] = p.y;
+        out[i*5 + 2] = p.z;
+        out[i*5 + 3] = (corners[i][0] > 0) ? uv[2] : uv[0];
+        out[i*5 + 4] = (corners[i][1] > 0) ? uv[3] : uv[1];
+    }
+    return true;
+}
+
+/*!
+ * \brief Stops the Sprite from referring to its SpriteSheet.
+ * \note Called by a SpriteSheet that is being deleted while Sprites still refer to it.
+ */
+void Sprite::detach() {
+    attribMutex.lock();
+    mySheet = nullptr;
+    attribMutex.unlock();
+}
+
+Sprite::~Sprite() {
+    attribMutex.lock();
+    SpriteSheet * sheet = mySheet;
+    attribMutex.unlock();
+    if (sheet)
+        sheet->removeSprite(this);
+}
+
+}
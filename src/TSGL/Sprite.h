@@ -0,0 +1,79 @@
+/*
+ * Sprite.h extends Drawable and provides a class for drawing one region of a SpriteSheet.
+ */
+
+#ifndef SPRITE_H_
+#define SPRITE_H_
+
+#include "Drawable.h"           // For extending our Drawable object
+
+namespace tsgl {
+
+class SpriteSheet;
+
+/*! \class Sprite
+ *  \brief Draw one region of a SpriteSheet to the Canvas.
+ *  \details Sprite is a lightweight textured rectangle that shows one region of a SpriteSheet.
+ *   A Sprite does not draw itself: its SpriteSheet draws every visible Sprite made from it in a single
+ *   batch, so only the SpriteSheet needs to be added to the Canvas.
+ *  \details Changing a Sprite's region (e.g., to animate it) is as cheap as changing its position.
+ *  \note A Sprite must be deleted before the SpriteSheet it was made from.
+ */
+class Sprite : public Drawable {
+ private:
+    SpriteSheet * mySheet;
+    unsigned myRegion;
+    GLfloat myWidth, myHeight;
+    bool isVisible;
+ public:
+    Sprite(float x, float y, float z, SpriteSheet * sheet, unsigned region, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha = 1.0f);
+
+    /*!
+     * \brief Does nothing; Sprites are drawn by their SpriteSheet.
+     */
+    virtual void draw(Shader * shader) {}
+
+    /*!
+     * \brief Accessor for the Sprite's height.
+     * \return The height of the Sprite.
+     */
+    GLfloat getHeight() { return myHeight; }
+
+    /*!
+     * \brief Accessor for the Sprite's width.
+     * \return The width of the Sprite.
+     */
+    GLfloat getWidth() { return myWidth; }
+
+    /*!
+     * \brief Accessor for the Sprite's region.
+     * \return The index of the SpriteSheet region the Sprite shows.
+     */
+    unsigned getRegion() { return myRegion; }
+
+    /*!
+     * \brief Accessor for the Sprite's visibility.
+     * \return True if the SpriteSheet will draw the Sprite, false otherwise.
+     */
+    bool getVisible() { return isVisible; }
+
+    void setWidth(GLfloat width);
+
+    void setHeight(GLfloat height);
+
+    void setRegion(unsigned region);
+
+    void setVisible(bool visible);
+
+    void setAlpha(float alpha);
+
+    bool writeVertices(GLfloat * out, const GLfloat * regionCoords, unsigned regionCount, float& alpha);
+
+    void detach();
+
+    virtual ~Sprite();
+};
+
+}
+
+#endif /* SPRITE_H_ */
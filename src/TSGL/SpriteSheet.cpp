@@ -0,0 +1,328 @@
+#include "SpriteSheet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace tsgl {
+
+ /*!
+  * \brief Constructs a new SpriteSheet from a single file.
+  * \details The SpriteSheet starts with no regions; add them with addRegion().
+  *   \param filename The filename of the image to load, a std::string.
+  * \return A new SpriteSheet drawing Sprites from the given file.
+  */
+SpriteSheet::SpriteSheet(std::string filename) : Drawable(0,0,0,0,0,0) {
+    attribMutex.lock();
+    vertices = nullptr;
+    shaderType = TEXTURE_SHADER_TYPE;
+    myAlpha = 1.0f;
+    myEntry = TextureCache::acquire(filename);
+    init = (myEntry != nullptr);
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Constructs a new SpriteSheet from a file laid out as an evenly spaced grid.
+  * \details Regions are numbered row by row, starting at the top-left cell of the grid.
+  *   \param filename The filename of the image to load, a std::string.
+  *   \param columns The number of cells in each row of the grid.
+  *   \param rows The number of cells in each column of the grid.
+  * \return A new SpriteSheet with <code>columns * rows</code> regions.
+  */
+SpriteSheet::SpriteSheet(std::string filename, unsigned columns, unsigned rows) : SpriteSheet(filename) {
+    if (columns == 0 || rows == 0) {
+        TsglDebug("Cannot have a SpriteSheet grid with no rows or columns.");
+        return;
+    }
+    int cellWidth = getPixelWidth() / columns, cellHeight = getPixelHeight() / rows;
+    for (unsigned r = 0; r < rows; r++)
+        for (unsigned c = 0; c < columns; c++)
+            addRegion(c * cellWidth, r * cellHeight, cellWidth, cellHeight);
+}
+
+ /*!
+  * \brief Constructs a new SpriteSheet by packing several files into one texture.
+  * \details The files are decoded in parallel and packed into rows of an atlas texture,
+  *   so that Sprites showing any of them can be drawn together.
+  *   \param filenames The filenames of the images to pack. Region <i>i</i> shows filenames[i].
+  * \return A new SpriteSheet with one region per file.
+  * \note Files that fail to load get an empty region.
+  */
+SpriteSheet::SpriteSheet(const std::vector<std::string>& filenames) : Drawable(0,0,0,0,0,0) {
+    attribMutex.lock();
+    vertices = nullptr;
+    shaderType = TEXTURE_SHADER_TYPE;
+    myAlpha = 1.0f;
+    myEntry = nullptr;
+    packFiles(filenames);
+    init = (myEntry != nullptr);
+    attribMutex.unlock();
+}
+
+// Decodes the files and packs them into rows ("shelves") of a new texture, tallest first.
+void SpriteSheet::packFiles(const std::vector<std::string>& filenames) {
+    const int padding = 2;      // Keeps neighbors from bleeding into each other when mipmapped
+    unsigned n = filenames.size();
+    std::vector<TextureCache::Entry*> images(n);
+    for (unsigned i = 0; i < n; i++)
+        images[i] = TextureCache::acquire(filenames[i], true);
+
+    std::vector<unsigned> order;
+    long long area = 0;
+    int widest = 0;
+    for (unsigned i = 0; i < n; i++) {
+        if (!TextureCache::wait(images[i])) continue;
+        order.push_back(i);
+        area += (long long) (images[i]->width + padding) * (images[i]->height + padding);
+        widest = std::max(widest, images[i]->width + padding);
+    }
+    std::stable_sort(order.begin(), order.end(), [&images](unsigned a, unsigned b) {
+        return images[a]->height > images[b]->height;
+    });
+
+    int atlasWidth = 1;
+    while (atlasWidth < widest || (long long) atlasWidth * atlasWidth < area)
+        atlasWidth *= 2;
+
+    std::vector<int> xs(n, 0), ys(n, 0);
+    int x = 0, y = 0, shelfHeight = 0;
+    for (unsigned k = 0; k < order.size(); k++) {
+        TextureCache::Entry * e = images[order[k]];
+        if (x + e->width + padding > atlasWidth) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        xs[order[k]] = x;
+        ys[order[k]] = y;
+        x += e->width + padding;
+        shelfHeight = std::max(shelfHeight, e->height + padding);
+    }
+    int atlasHeight = std::max(y + shelfHeight, 1);
+
+    // Copy each image into place; both are stored bottom row first, so y grows up the atlas.
+    unsigned char * pixels = (unsigned char *) calloc((size_t) atlasWidth * atlasHeight, 4);
+    for (unsigned k = 0; k < order.size(); k++) {
+        TextureCache::Entry * e = images[order[k]];
+        for (int row = 0; row < e->height; row++)
+            memcpy(pixels + ((size_t) (ys[order[k]] + row) * atlasWidth + xs[order[k]]) * 4,
+                   e->pixels + (size_t) row * e->width * 4, (size_t) e->width * 4);
+    }
+    myEntry = TextureCache::create(pixels, atlasWidth, atlasHeight);
+
+    for (unsigned i = 0; i < n; i++) {
+        bool loaded = TextureCache::isReady(images[i]);
+        int w = loaded ? images[i]->width : 0, h = loaded ? images[i]->height : 0;
+        myRegionCoords.push_back((GLfloat) xs[i] / atlasWidth);
+        myRegionCoords.push_back((GLfloat) ys[i] / atlasHeight);
+        myRegionCoords.push_back((GLfloat) (xs[i] + w) / atlasWidth);
+        myRegionCoords.push_back((GLfloat) (ys[i] + h) / atlasHeight);
+        myRegionSizes.push_back(w);
+        myRegionSizes.push_back(h);
+        TextureCache::release(images[i]);
+    }
+}
+
+ /*!
+  * \brief Draw every visible Sprite made from the SpriteSheet.
+  * \details Gathers the Sprites' vertices into one buffer, binds the sheet's texture once, and draws
+  *   the Sprites grouped by alpha value, most opaque first.
+  */
+void SpriteSheet::draw(Shader * shader) {
+    if (!init) {
+        TsglDebug("Vertex buffer is not full.");
+        return;
+    }
+    attribMutex.lock();
+    unsigned regionCount = myRegionSizes.size() / 2;
+    myBatch.resize(mySprites.size() * 30);
+    myBatchAlphas.resize(mySprites.size());
+    unsigned count = 0;
+    for (unsigned i = 0; i < mySprites.size(); i++) {
+        if (mySprites[i]->writeVertices(&myBatch[count * 30], myRegionCoords.data(), regionCount, myBatchAlphas[count]))
+            count++;
+    }
+    if (count == 0 || !TextureCache::bindTexture(myEntry)) {
+        attribMutex.unlock();
+        return;
+    }
+
+    // Group Sprites with the same alpha so each group is one draw call.
+    bool sameAlpha = true;
+    for (unsigned i = 1; i < count && sameAlpha; i++)
+        sameAlpha = (myBatchAlphas[i] == myBatchAlphas[0]);
+    std::vector<unsigned> order(count);
+    for (unsigned i = 0; i < count; i++)
+        order[i] = i;
+    const GLfloat * batch = myBatch.data();
+    std::vector<GLfloat> sorted;
+    if (!sameAlpha) {
+        std::vector<float>& alphas = myBatchAlphas;
+        std::stable_sort(order.begin(), order.end(), [&alphas](unsigned a, unsigned b) {
+            return alphas[a] > alphas[b];
+        });
+        sorted.resize(count * 30);
+        for (unsigned i = 0; i < count; i++)
+            memcpy(&sorted[i * 30], &myBatch[order[i] * 30], sizeof(GLfloat) * 30);
+        batch = sorted.data();
+    }
+
+    glm::mat4 model = glm::mat4(1.0f);
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+    unsigned int alphaLoc = glGetUniformLocation(shader->ID, "alpha");
+
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * count * 30, batch, GL_DYNAMIC_DRAW);
+    unsigned start = 0;
+    while (start < count) {
+        float alpha = myBatchAlphas[order[start]];
+        unsigned end = start + 1;
+        while (end < count && myBatchAlphas[order[end]] == alpha)
+            end++;
+        glUniform1f(alphaLoc, alpha);
+        glDrawArrays(GL_TRIANGLES, start * 6, (end - start) * 6);
+        start = end;
+    }
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Adds a rectangular region to the SpriteSheet.
+  *   \param x The distance in pixels from the left edge of the sheet to the left edge of the region.
+  *   \param y The distance in pixels from the top edge of the sheet to the top edge of the region.
+  *   \param width The width of the region in pixels.
+  *   \param height The height of the region in pixels.
+  * \return The index of the new region, for use with Sprite.
+  */
+unsigned SpriteSheet::addRegion(int x, int y, int width, int height) {
+    attribMutex.lock();
+    int sheetWidth = myEntry ? myEntry->width : 1, sheetHeight = myEntry ? myEntry->height : 1;
+    myRegionCoords.push_back((GLfloat) x / sheetWidth);
+    myRegionCoords.push_back((GLfloat) (sheetHeight - y - height) / sheetHeight);
+    myRegionCoords.push_back((GLfloat) (x + width) / sheetWidth);
+    myRegionCoords.push_back((GLfloat) (sheetHeight - y) / sheetHeight);
+    myRegionSizes.push_back(width);
+    myRegionSizes.push_back(height);
+    unsigned index = myRegionSizes.size() / 2 - 1;
+    attribMutex.unlock();
+    return index;
+}
+
+ /*!
+  * \brief Accessor for the number of regions in the SpriteSheet.
+  * \return The number of regions that Sprites can show.
+  */
+unsigned SpriteSheet::getRegionCount() {
+    attribMutex.lock();
+    unsigned count = myRegionSizes.size() / 2;
+    attribMutex.unlockUnchanged();
+    return count;
+}
+
+ /*!
+  * \brief Accessor for the width of a region in pixels.
+  *   \param region The index of the region.
+  * \return The width of the region, or 0 if there is no such region.
+  */
+int SpriteSheet::getRegionPixelWidth(unsigned region) {
+    attribMutex.lock();
+    int width = (region * 2 < myRegionSizes.size()) ? myRegionSizes[region * 2] : 0;
+    attribMutex.unlockUnchanged();
+    return width;
+}
+
+ /*!
+  * \brief Accessor for the height of a region in pixels.
+  *   \param region The index of the region.
+  * \return The height of the region, or 0 if there is no such region.
+  */
+int SpriteSheet::getRegionPixelHeight(unsigned region) {
+    attribMutex.lock();
+    int height = (region * 2 < myRegionSizes.size()) ? myRegionSizes[region * 2 + 1] : 0;
+    attribMutex.unlockUnchanged();
+    return height;
+}
+
+ /*!
+  * \brief Accessor for the texture coordinates of a region.
+  *   \param region The index of the region.
+  *   \param u0 Set to the horizontal texture coordinate of the region's left edge.
+  *   \param v0 Set to the vertical texture coordinate of the region's bottom edge.
+  *   \param u1 Set to the horizontal texture coordinate of the region's right edge.
+  *   \param v1 Set to the vertical texture coordinate of the region's top edge.
+  * \return True if the region exists, false otherwise (in which case nothing is set).
+  */
+bool SpriteSheet::getRegionCoordinates(unsigned region, GLfloat& u0, GLfloat& v0, GLfloat& u1, GLfloat& v1) {
+    attribMutex.lock();
+    bool exists = region * 4 < myRegionCoords.size();
+    if (exists) {
+        u0 = myRegionCoords[region * 4];
+        v0 = myRegionCoords[region * 4 + 1];
+        u1 = myRegionCoords[region * 4 + 2];
+        v1 = myRegionCoords[region * 4 + 3];
+    }
+    attribMutex.unlockUnchanged();
+    return exists;
+}
+
+ /*!
+  * \brief Accessor for the width of the SpriteSheet's texture in pixels.
+  * \return The width of the whole sheet, or 0 if it failed to load.
+  */
+int SpriteSheet::getPixelWidth() {
+    return myEntry ? myEntry->width : 0;
+}
+
+ /*!
+  * \brief Accessor for the height of the SpriteSheet's texture in pixels.
+  * \return The height of the whole sheet, or 0 if it failed to load.
+  */
+int SpriteSheet::getPixelHeight() {
+    return myEntry ? myEntry->height : 0;
+}
+
+ /*!
+  * \brief Uploads the SpriteSheet's texture ahead of time.
+  * \details Asks every Canvas to upload the texture at the start of its next frame instead of
+  *   the first time the SpriteSheet is drawn.
+  */
+void SpriteSheet::prepare() {
+    TextureCache::prepare(myEntry);
+}
+
+ /*!
+  * \brief Adds a Sprite to the SpriteSheet's batch.
+  *   \param sprite The Sprite to draw along with the others.
+  * \note Called by Sprite's constructor.
+  */
+void SpriteSheet::addSprite(Sprite * sprite) {
+    attribMutex.lock();
+    mySprites.push_back(sprite);
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Removes a Sprite from the SpriteSheet's batch.
+  *   \param sprite The Sprite to stop drawing.
+  * \note Called by Sprite's destructor.
+  */
+void SpriteSheet::removeSprite(Sprite * sprite) {
+    attribMutex.lock();
+    std::vector<Sprite*>::iterator it = std::find(mySprites.begin(), mySprites.end(), sprite);
+    if (it != mySprites.end())
+        mySprites.erase(it);
+    attribMutex.unlock();
+}
+
+SpriteSheet::~SpriteSheet() {
+    attribMutex.lock();
+    for (unsigned i = 0; i < mySprites.size(); i++)
+        mySprites[i]->detach();
+    mySprites.clear();
+    attribMutex.unlock();
+    TextureCache::release(myEntry);
+}
+
+}
@@ -0,0 +1,73 @@
+/*
+ * SpriteSheet.h extends Drawable and provides a class for drawing many Sprites from one shared texture.
+ */
+
+#ifndef SPRITESHEET_H_
+#define SPRITESHEET_H_
+
+#include <string>
+#include <vector>
+
+#include "Drawable.h"           // For extending our Drawable object
+#include "Sprite.h"             // For the Sprites drawn by a SpriteSheet
+#include "TextureCache.h"       // For sharing the sheet's pixels and textures
+
+namespace tsgl {
+
+/*! \class SpriteSheet
+ *  \brief Draw many Sprites that share one texture in a single draw call.
+ *  \details A SpriteSheet is one texture divided into rectangular regions. It can be made from:
+ *   - a single file, with regions added by addRegion();
+ *   - a single file split into an evenly spaced grid of regions;
+ *   - a list of files, which are packed into one texture (an atlas) with one region per file.
+ *   .
+ *  \details Sprites made from a SpriteSheet are not drawn individually. Instead, the SpriteSheet gathers every
+ *   visible Sprite into one vertex buffer each frame and draws them with a single texture bind, and one draw call per
+ *   distinct Sprite alpha value. Add the SpriteSheet, rather than its Sprites, to the Canvas.
+ *  \details Regions are measured in pixels from the top-left corner of the sheet.
+ */
+class SpriteSheet : public Drawable {
+ private:
+    TextureCache::Entry * myEntry;
+    std::vector<GLfloat> myRegionCoords;    // u0, v0, u1, v1 of each region's bottom-left and top-right corners
+    std::vector<int> myRegionSizes;         // Width and height of each region in pixels
+    std::vector<Sprite*> mySprites;
+    std::vector<GLfloat> myBatch;           // Vertices of the visible Sprites, rebuilt each frame
+    std::vector<float> myBatchAlphas;       // Alpha of each Sprite in myBatch
+
+    void packFiles(const std::vector<std::string>& filenames);
+ public:
+    SpriteSheet(std::string filename);
+
+    SpriteSheet(std::string filename, unsigned columns, unsigned rows);
+
+    SpriteSheet(const std::vector<std::string>& filenames);
+
+    virtual void draw(Shader * shader);
+
+    unsigned addRegion(int x, int y, int width, int height);
+
+    unsigned getRegionCount();
+
+    int getRegionPixelWidth(unsigned region);
+
+    int getRegionPixelHeight(unsigned region);
+
+    bool getRegionCoordinates(unsigned region, GLfloat& u0, GLfloat& v0, GLfloat& u1, GLfloat& v1);
+
+    int getPixelWidth();
+
+    int getPixelHeight();
+
+    void prepare();
+
+    void addSprite(Sprite * sprite);
+
+    void removeSprite(Sprite * sprite);
+
+    virtual ~SpriteSheet();
+};
+
+}
+
+#endif /* SPRITESHEET_H_ */
@@ -69,7 +69,9 @@ void Square::setSideLength(GLfloat sideLength) {
     }
     attribMutex.lock();
     mySideLength = sideLength;
+    beginTransform();
     myXScale = myYScale = sideLength;
+    endTransform();
     attribMutex.unlock();
 }
 
@@ -84,8 +86,10 @@ void Square::changeSideLengthBy(GLfloat delta) {
     }
     attribMutex.lock();
     mySideLength += delta;
+    beginTransform();
     myXScale += delta;
     myYScale += delta;
+    endTransform();
     attribMutex.unlock();
 }
 }
\ No newline at end of file
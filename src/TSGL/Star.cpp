@@ -94,8 +94,10 @@ void Star::setRadius(GLfloat radius) {
         return;
     }
     attribMutex.lock();
+    beginTransform();
     myXScale = radius;
     myYScale = radius;
+    endTransform();
     myRadius = radius;
     attribMutex.unlock();
 }
@@ -106,8 +108,10 @@ void Star::changeRadiusBy(GLfloat delta) {
         return;
     }
     attribMutex.lock();
+    beginTransform();
     myXScale += delta;
     myYScale += delta;
+    endTransform();
     myRadius += delta;
     attribMutex.unlock();
 }
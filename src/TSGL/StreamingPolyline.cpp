@@ -0,0 +1,217 @@
+#include "StreamingPolyline.h"
+#include "RenderService.h"  // For the context that owns our GL objects
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new, empty StreamingPolyline.
+  * \details This is the explicit constructor for the StreamingPolyline class.
+  *   \param x The x coordinate of the StreamingPolyline's center.
+  *   \param y The y coordinate of the StreamingPolyline's center.
+  *   \param z The z coordinate of the StreamingPolyline's center.
+  *   \param yaw The StreamingPolyline's yaw.
+  *   \param pitch The StreamingPolyline's pitch.
+  *   \param roll The StreamingPolyline's roll.
+  *   \param color The color of the StreamingPolyline.
+  *   \param maxSamples The number of most recent samples to keep (optional). 0, the default, keeps every sample.
+  * \return A new StreamingPolyline with no samples.
+  */
+StreamingPolyline::StreamingPolyline(float x, float y, float z, float yaw, float pitch, float roll, ColorFloat color, int maxSamples) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    if (maxSamples < 0) {
+        TsglDebug("Cannot keep a negative number of samples; keeping every sample.");
+        maxSamples = 0;
+    }
+    vertices = nullptr;
+    myXScale = myYScale = myZScale = 1;
+    myMaxSamples = maxSamples;
+    myCount = myHead = myPending = 0;
+    myColor = color;
+    myAlpha = color.A;
+    needsRealloc = true;
+    myContext = nullptr;
+    myBuffer = 0;
+    myBufferSamples = 0;
+    if (myMaxSamples > 0)
+        mySamples.resize((size_t) myMaxSamples * 3);
+    init = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Draw the StreamingPolyline.
+  * \details This function actually draws the StreamingPolyline to the Canvas, first uploading
+  *   the samples appended since the last frame.
+  */
+void StreamingPolyline::draw(Shader * shader) {
+    attribMutex.lock();
+    if (myCount < 2) {
+        attribMutex.unlock();
+        return;
+    }
+    glm::mat4 model = getModelMatrix();
+
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    if (!myBuffer) {
+        myContext = RenderService::currentContext();
+        glGenBuffers(1, &myBuffer);
+        needsRealloc = true;
+    }
+    GLint previousBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, myBuffer);
+    upload();
+
+    useVertexFormat(shader, VERTEX_UNIFORM, myColor);
+    if (myMaxSamples > 0)
+        glDrawArrays(GL_LINE_STRIP, (myHead - myCount + myMaxSamples) % myMaxSamples, myCount);
+    else
+        glDrawArrays(GL_LINE_STRIP, 0, myCount);
+
+    // The attribute pointers remember the buffer bound when they are set, so rebind the shared one first
+    glBindBuffer(GL_ARRAY_BUFFER, previousBuffer);
+    restoreVertexFormat(shader);
+    attribMutex.unlock();
+}
+
+// Uploads the pending samples to myBuffer, which must be bound. attribMutex must be held.
+void StreamingPolyline::upload() {
+    const size_t sampleSize = 3 * sizeof(GLfloat);
+    if (myMaxSamples > 0) {
+        // The ring is stored twice in a row on the GPU, so that the most recent myCount samples
+        // are always one contiguous strip starting inside the first copy.
+        if (needsRealloc) {
+            myBufferSamples = myMaxSamples * 2;
+            glBufferData(GL_ARRAY_BUFFER, myBufferSamples * sampleSize, NULL, GL_DYNAMIC_DRAW);
+            myPending = myCount;
+        }
+        int first = (myHead - myPending + myMaxSamples) % myMaxSamples;
+        while (myPending > 0) {
+            int run = std::min(myPending, myMaxSamples - first);
+            const GLfloat * data = mySamples.data() + (size_t) first * 3;
+            glBufferSubData(GL_ARRAY_BUFFER, first * sampleSize, run * sampleSize, data);
+            glBufferSubData(GL_ARRAY_BUFFER, (first + myMaxSamples) * sampleSize, run * sampleSize, data);
+            myPending -= run;
+            first = 0;
+        }
+    } else if (needsRealloc || myCount > myBufferSamples) {
+        // Allocate for the whole reserved capacity, so that appends up to it only need a partial upload
+        myBufferSamples = mySamples.capacity() / 3;
+        glBufferData(GL_ARRAY_BUFFER, myBufferSamples * sampleSize, NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, myCount * sampleSize, mySamples.data());
+    } else if (myPending > 0) {
+        int first = myCount - myPending;
+        glBufferSubData(GL_ARRAY_BUFFER, first * sampleSize, myPending * sampleSize, mySamples.data() + (size_t) first * 3);
+    }
+    myPending = 0;
+    needsRealloc = false;
+}
+
+// Stores one sample, replacing the oldest one if the ring is full. attribMutex must be held.
+void StreamingPolyline::push(GLfloat x, GLfloat y, GLfloat z) {
+    GLfloat * v;
+    if (myMaxSamples > 0) {
+        v = mySamples.data() + (size_t) myHead * 3;
+        myHead = (myHead + 1) % myMaxSamples;
+        if (myCount < myMaxSamples)
+            myCount++;
+        if (myPending < myMaxSamples)
+            myPending++;
+    } else {
+        mySamples.resize((size_t) (myCount + 1) * 3);
+        v = mySamples.data() + (size_t) myCount * 3;
+        myCount++;
+        myPending++;
+    }
+    v[0] = x; v[1] = y; v[2] = z;
+}
+
+ /*!
+  * \brief Adds a sample to the end of the StreamingPolyline.
+  * \details If the StreamingPolyline already holds its maximum number of samples, the oldest is dropped.
+  *   \param x The x coordinate of the sample.
+  *   \param y The y coordinate of the sample.
+  *   \param z The z coordinate of the sample (optional, 0 by default).
+  */
+void StreamingPolyline::append(GLfloat x, GLfloat y, GLfloat z) {
+    attribMutex.lock();
+    push(x, y, z);
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Adds many samples to the end of the StreamingPolyline.
+  * \details If this would exceed the maximum number of samples, the oldest samples are dropped.
+  *   \param count The number of samples to add.
+  *   \param samples 2 floats per sample: x, y. Their z coordinates are 0.
+  */
+void StreamingPolyline::append(int count, const GLfloat samples[]) {
+    attribMutex.lock();
+    if (myMaxSamples == 0 && count > 0)
+        mySamples.reserve((size_t) (myCount + count) * 3);
+    for (int i = 0; i < count; i++)
+        push(samples[i*2], samples[i*2 + 1], 0);
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Removes every sample.
+  * \details The StreamingPolyline keeps its allocated space, so refilling it does not allocate again.
+  */
+void StreamingPolyline::clear() {
+    attribMutex.lock();
+    myCount = myHead = myPending = 0;
+    if (myMaxSamples == 0)
+        mySamples.clear();
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Accessor for the number of samples.
+  * \return The number of samples currently drawn.
+  */
+int StreamingPolyline::size() {
+    attribMutex.lock();
+    int s = myCount;
+    attribMutex.unlock();
+    return s;
+}
+
+ /*!
+  * \brief Accessor for the maximum number of samples.
+  * \return The number of most recent samples kept, or 0 if every sample is kept.
+  */
+int StreamingPolyline::getMaxSamples() {
+    return myMaxSamples;
+}
+
+ /*!
+  * \brief Sets the StreamingPolyline to a new color.
+  *   \param c The new color of the StreamingPolyline.
+  */
+void StreamingPolyline::setColor(ColorFloat c) {
+    attribMutex.lock();
+    myColor = c;
+    myAlpha = c.A;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Accessor for the StreamingPolyline's color.
+  * \return The color of the StreamingPolyline.
+  */
+ColorFloat StreamingPolyline::getColor() {
+    attribMutex.lock();
+    ColorFloat c = myColor;
+    attribMutex.unlockUnchanged();
+    return c;
+}
+
+StreamingPolyline::~StreamingPolyline() {
+    // We may not be on the render thread, so let it delete the buffer.
+    TextureCache::deleteBufferLater(myContext, myBuffer);
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * StreamingPolyline.h extends Drawable and provides a class for drawing a Polyline that grows one vertex at a time.
+ */
+
+#ifndef STREAMINGPOLYLINE_H_
+#define STREAMINGPOLYLINE_H_
+
+#include <vector>               // For the sample storage
+
+#include "Drawable.h"           // For extending our Drawable object
+#include "TextureCache.h"       // For deleting GL objects on the render thread
+
+namespace tsgl {
+
+/*! \class StreamingPolyline
+ *  \brief Draw a chain of lines that vertices are continually appended to, such as a live plot.
+ *  \details Unlike Polyline, a StreamingPolyline does not need to know its number of vertices up front.
+ *   Vertices ("samples") are added one at a time or in batches with append(), which takes amortized
+ *   constant time, and only the samples appended since the last frame are uploaded to the GPU.
+ *  \details A StreamingPolyline may be given a maximum number of samples. Once it holds that many, each
+ *   new sample replaces the oldest one, so it always shows the most recent window of a signal. The samples
+ *   are kept in a ring buffer on the GPU, so dropping old samples costs nothing.
+ *  \details Samples are given relative to the StreamingPolyline's center, and the whole line is drawn in one color.
+ *  \note A StreamingPolyline should only be added to one Canvas.
+ */
+class StreamingPolyline : public Drawable {
+ private:
+    std::vector<GLfloat> mySamples;     // 3 floats per sample; a ring of myMaxSamples samples if that is nonzero
+    int myMaxSamples;                   // 0 if the StreamingPolyline may grow without bound
+    int myCount;                        // Number of samples currently drawn
+    int myHead;                         // Slot of the next sample in the ring
+    int myPending;                      // Samples appended since the last upload
+    ColorFloat myColor;
+    bool needsRealloc;                  // Whether the buffer must be recreated rather than updated
+
+    GLFWwindow * myContext;             // Context the buffer below was created in
+    GLuint myBuffer;
+    int myBufferSamples;                // Samples that fit in myBuffer
+
+    void push(GLfloat x, GLfloat y, GLfloat z);
+    void upload();
+ public:
+    StreamingPolyline(float x, float y, float z, float yaw, float pitch, float roll, ColorFloat color, int maxSamples = 0);
+
+    virtual void draw(Shader * shader);
+
+    void append(GLfloat x, GLfloat y, GLfloat z = 0);
+
+    void append(int count, const GLfloat samples[]);
+
+    void clear();
+
+    int size();
+
+    int getMaxSamples();
+
+    virtual void setColor(ColorFloat c);
+
+    virtual ColorFloat getColor();
+
+    virtual ~StreamingPolyline();
+};
+
+}
+
+#endif /* STREAMINGPOLYLINE_H_ */
@@ -0,0 +1,230 @@
+/*
+ * SubmissionQueue.h provides a queue that many threads can submit items to without waiting on each other.
+ */
+
+#ifndef SUBMISSIONQUEUE_H_
+#define SUBMISSIONQUEUE_H_
+
+#include <algorithm>        // For merging the lanes with a heap
+#include <atomic>           // For publishing items to the consumer without locking
+#include <functional>
+#include <memory>           // For noticing when a lane's thread has exited
+#include <mutex>            // Needed for registering new producer threads
+#include <utility>
+#include <vector>
+
+namespace tsgl {
+
+/*!
+ * \class SubmissionQueue
+ * \brief Internal queue of items submitted from many threads and drained by one.
+ * \details Each thread that pushes to a SubmissionQueue gets a lane of its own: a single-producer,
+ *   single-consumer queue of fixed-size blocks. Pushing writes the item into the thread's current block
+ *   and publishes it with a single release store, so producers never wait on each other or on the
+ *   consumer. The only cache line they share is a counter that stamps each item with a sequence number.
+ * \details The consumer merges the lanes by sequence number, so items come out in the order they were
+ *   pushed: if one push happens before another, even on a different thread, its item comes out first.
+ *   Items pushed while drain() runs may be left for the next call.
+ * \details A lane is freed once the thread that owns it has exited and the consumer has drained it.
+ * \details A thread finds its lane through a small thread-local cache, so a push costs a few loads and
+ *   stores. Only the first push from a thread, or from a thread that has pushed to many other
+ *   SubmissionQueues since, takes a lock.
+ * \note Only one thread may call drain() at a time; callers serialize it with a mutex of their own.
+ * \note Items still in the queue when it is destroyed are discarded, not deleted.
+ */
+template<typename Item>
+class SubmissionQueue {
+ private:
+    static const unsigned BLOCK_SIZE = 256;     // Items per block
+    static const unsigned CACHE_SIZE = 8;       // Lanes each thread remembers
+
+    struct Slot {
+        Item item;
+        unsigned long seq;                      // Order of the push among all of this queue's pushes
+    };
+
+    struct Block {
+        Slot items[BLOCK_SIZE];
+        std::atomic<unsigned> count;            // Items written, published by the producer
+        std::atomic<Block*> next;               // Published by the producer once this block is full
+        Block() : count(0), next(nullptr) {}
+    };
+
+    // Set once a thread has exited, so the consumer can free its lanes; one per thread, shared by its lanes
+    struct ThreadExit {
+        std::shared_ptr<std::atomic<bool> > exited;
+        ThreadExit() : exited(new std::atomic<bool>(false)) {}
+        ~ThreadExit() { exited->store(true, std::memory_order_release); }
+    };
+
+    struct Lane {
+        Block * tail;                           // Written only by the producer
+        std::shared_ptr<std::atomic<bool> > ownerExited;    // Also tells threads apart, as it is never reused while held
+        char padding[64];                       // Keeps the producer's and consumer's fields off each other's cache line
+        Block * head;                           // Read and written only by the consumer
+        unsigned read;                          // Next item of head the consumer reads
+        char padding2[64];
+        Lane() : ownerExited(threadExit.exited), read(0) { head = tail = new Block(); }
+        ~Lane() {
+            while (head) {
+                Block * next = head->next.load(std::memory_order_relaxed);
+                delete head;
+                head = next;
+            }
+        }
+    };
+
+    struct CacheEntry {
+        unsigned long id;
+        Lane * lane;
+    };
+
+    typedef std::pair<unsigned long, unsigned> Head;    // Sequence number of a lane's next item, and the lane
+
+    static std::atomic<unsigned long> nextId;
+    static thread_local CacheEntry cache[CACHE_SIZE];
+    static thread_local unsigned cacheNext;
+    static thread_local ThreadExit threadExit;
+
+    const unsigned long myId;                   // Never reused, so stale cache entries never match
+    std::atomic<unsigned long> nextSeq;
+    std::mutex lanesMutex;
+    std::vector<Lane*> lanes;
+    std::vector<Head> heads;                    // Used only by drain(), kept to save allocating it each time
+
+    // Finds the calling thread's lane, registering one if it has none
+    Lane * myLane() {
+        for (unsigned i = 0; i < CACHE_SIZE; i++)
+            if (cache[i].id == myId)
+                return cache[i].lane;
+        Lane * lane = nullptr;
+        lanesMutex.lock();
+        for (unsigned i = 0; i < lanes.size() && !lane; i++)
+            if (lanes[i]->ownerExited == threadExit.exited)
+                lane = lanes[i];
+        if (!lane) {
+            lane = new Lane();
+            lanes.push_back(lane);
+        }
+        lanesMutex.unlock();
+        cache[cacheNext].id = myId;
+        cache[cacheNext].lane = lane;
+        cacheNext = (cacheNext + 1) % CACHE_SIZE;
+        return lane;
+    }
+
+    // Finds the next item of a lane stamped before limit, freeing the blocks the consumer has finished
+    Slot * front(Lane * lane, unsigned long limit) {
+        while (true) {
+            unsigned n = lane->head->count.load(std::memory_order_acquire);
+            if (lane->read < n) {
+                Slot * slot = &lane->head->items[lane->read];
+                return (slot->seq < limit) ? slot : nullptr;
+            }
+            if (n < BLOCK_SIZE)
+                return nullptr;
+            Block * next = lane->head->next.load(std::memory_order_acquire);
+            if (!next)
+                return nullptr;
+            delete lane->head;      // The producer has moved on to next
+            lane->head = next;
+            lane->read = 0;
+        }
+    }
+ public:
+    /*!
+     * \brief SubmissionQueue constructor method.
+     * \return An empty SubmissionQueue.
+     */
+    SubmissionQueue() : myId(++nextId), nextSeq(0) {}
+
+    /*!
+     * \brief SubmissionQueue destructor method.
+     * \details Frees every lane. The items still in them are not deleted.
+     */
+    ~SubmissionQueue() {
+        for (unsigned i = 0; i < lanes.size(); i++)
+            delete lanes[i];
+    }
+
+    /*!
+     * \brief Submits an item from the calling thread.
+     * \param item The item to submit.
+     */
+    void push(const Item& item) {
+        Lane * lane = myLane();
+        Block * b = lane->tail;
+        // Releases this thread's earlier pushes to drain(), which reads nextSeq before any lane
+        unsigned long seq = nextSeq.fetch_add(1, std::memory_order_release);
+        unsigned n = b->count.load(std::memory_order_relaxed);
+        if (n < BLOCK_SIZE) {
+            b->items[n].item = item;
+            b->items[n].seq = seq;
+            b->count.store(n + 1, std::memory_order_release);
+        } else {
+            Block * fresh = new Block();
+            fresh->items[0].item = item;
+            fresh->items[0].seq = seq;
+            fresh->count.store(1, std::memory_order_relaxed);
+            b->next.store(fresh, std::memory_order_release);
+            lane->tail = fresh;
+        }
+    }
+
+    /*!
+     * \brief Takes every item submitted so far out of the queue.
+     * \param function Called with each item, in the order described for SubmissionQueue.
+     */
+    template<typename Function>
+    void drain(Function function) {
+        std::lock_guard<std::mutex> lock(lanesMutex);
+        // Every push stamped before limit has published its item, as have the pushes that happened before it
+        unsigned long limit = nextSeq.load(std::memory_order_acquire);
+        heads.clear();
+        for (unsigned i = 0; i < lanes.size(); i++) {
+            Slot * slot = front(lanes[i], limit);
+            if (slot)
+                heads.push_back(Head(slot->seq, i));
+        }
+        std::make_heap(heads.begin(), heads.end(), std::greater<Head>());
+        while (!heads.empty()) {
+            std::pop_heap(heads.begin(), heads.end(), std::greater<Head>());
+            Lane * lane = lanes[heads.back().second];
+            function(lane->head->items[lane->read].item);
+            lane->read++;
+            Slot * slot = front(lane, limit);
+            if (slot) {
+                heads.back().first = slot->seq;
+                std::push_heap(heads.begin(), heads.end(), std::greater<Head>());
+            } else {
+                heads.pop_back();
+            }
+        }
+        for (unsigned i = 0; i < lanes.size(); ) {
+            // The exit is read first, so an empty lane has no pushes left to publish
+            if (lanes[i]->ownerExited->load(std::memory_order_acquire) && !front(lanes[i], (unsigned long) -1)) {
+                delete lanes[i];
+                lanes[i] = lanes.back();
+                lanes.pop_back();
+            } else {
+                i++;
+            }
+        }
+    }
+};
+
+template<typename Item>
+std::atomic<unsigned long> SubmissionQueue<Item>::nextId(0);
+
+template<typename Item>
+thread_local typename SubmissionQueue<Item>::CacheEntry SubmissionQueue<Item>::cache[SubmissionQueue<Item>::CACHE_SIZE];
+
+template<typename Item>
+thread_local unsigned SubmissionQueue<Item>::cacheNext = 0;
+
+template<typename Item>
+thread_local typename SubmissionQueue<Item>::ThreadExit SubmissionQueue<Item>::threadExit;
+
+}
+
+#endif /* SUBMISSIONQUEUE_H_ */
@@ -0,0 +1,364 @@
+#include "TaskPool.h"
+
+#include <algorithm>
+#include <memory>
+#include <omp.h>                // For telling OpenMP threads apart outside of a TaskPool
+
+#include "Error.h"
+#include "ProgressBar.h"
+#include "Spectrogram.h"
+#include "Util.h"               // For NUM_COLORS
+#include "VisualTaskQueue.h"
+
+namespace tsgl {
+
+thread_local TaskPool * TaskPool::currentPool = nullptr;
+thread_local int TaskPool::currentWorker = -1;
+
+ /*!
+  * \brief Constructs a new TaskPool and starts its workers.
+  *   \param numberOfWorkers The number of worker threads to start. If 0 or less (the default),
+  *     one worker is started for each core.
+  * \return A new TaskPool.
+  */
+TaskPool::TaskPool(int numberOfWorkers) : sleepers(0), queued(0), unfinished(0), nextWorker(0), cancelled(false), stopping(false) {
+    if (numberOfWorkers <= 0)
+      numberOfWorkers = std::max(1u, std::thread::hardware_concurrency());
+    myQueue = nullptr;
+    myProgressBar = nullptr;
+    mySpectrogram = nullptr;
+    for (int i = 0; i < numberOfWorkers; i++)
+      workers.push_back(new Worker());
+    for (int i = 0; i < numberOfWorkers; i++)
+      threads.push_back(std::thread(&TaskPool::work, this, i));
+}
+
+ /*!
+  * \brief TaskPool destructor method.
+  * \details Waits for every task to finish, then stops the workers.
+  */
+TaskPool::~TaskPool() {
+    wait();
+    sleepMutex.lock();
+    stopping = true;
+    sleepMutex.unlock();
+    sleepCondition.notify_all();
+    for (unsigned i = 0; i < threads.size(); i++)
+      threads[i].join();
+    for (unsigned i = 0; i < workers.size(); i++)
+      delete workers[i];
+}
+
+// Returns the index of the calling thread's queue, or -1 if it isn't one of the pool's workers
+int TaskPool::ownWorker() {
+    return (currentPool == this && currentWorker < (int) workers.size()) ? currentWorker : -1;
+}
+
+// Queues a task whose dependencies have all finished: on the calling worker's own queue, or in turn on each worker's
+void TaskPool::schedule(Task * task) {
+    int self = ownWorker();
+    Worker * w = (self >= 0) ? workers[self] : workers[nextWorker++ % workers.size()];
+    w->mutex.lock();
+    w->tasks.push_back(task);
+    w->mutex.unlock();
+    ++queued;
+    wake();
+}
+
+// Takes the newest task from the calling worker's queue, or else steals the oldest from another queue
+TaskPool::Task * TaskPool::take() {
+    if (queued.load(std::memory_order_relaxed) == 0)
+      return nullptr;
+    Task * task = nullptr;
+    int self = ownWorker();
+    if (self >= 0) {
+      Worker * w = workers[self];
+      w->mutex.lock();
+      if (!w->tasks.empty()) {
+        task = w->tasks.back();
+        w->tasks.pop_back();
+      }
+      w->mutex.unlock();
+    }
+    unsigned start = (self >= 0) ? self + 1 : nextWorker.load(std::memory_order_relaxed);
+    for (unsigned i = 0; i < workers.size() && !task; i++) {
+      Worker * w = workers[(start + i) % workers.size()];
+      w->mutex.lock();
+      if (!w->tasks.empty()) {
+        task = w->tasks.front();
+        w->tasks.pop_front();
+      }
+      w->mutex.unlock();
+    }
+    if (task)
+      --queued;
+    return task;
+}
+
+// Runs a task unless the pool is cancelled, then releases the tasks that depend on it
+void TaskPool::run(Task * task) {
+    if (!cancelled.load(std::memory_order_relaxed)) {
+      try {
+        task->function();
+      } catch (std::exception& e) {
+        TsglErr(std::string("A TaskPool task threw an exception: ") + e.what());
+      } catch (...) {
+        TsglErr("A TaskPool task threw an exception.");
+      }
+    }
+    std::vector<Task*> ready;
+    task->mutex.lock();
+    task->finished = true;
+    ready.swap(task->dependents);
+    task->mutex.unlock();
+    for (unsigned i = 0; i < ready.size(); i++)
+      if (--ready[i]->pending == 0)
+        schedule(ready[i]);
+    std::atomic<int> * latch = task->latch;
+    if (task->owned)
+      delete task;
+    if (latch)
+      --*latch;
+    --unfinished;
+    wake();
+}
+
+// Wakes the threads waiting for work or for tasks to finish, if there are any
+void TaskPool::wake() {
+    if (sleepers.load() == 0)
+      return;
+    // Lock so that a thread between checking its condition and waiting cannot miss the notification
+    sleepMutex.lock();
+    sleepMutex.unlock();
+    sleepCondition.notify_all();
+}
+
+// Runs tasks until done() is true, sleeping while there are none to run
+void TaskPool::helpUntil(const std::function<bool()>& done) {
+    while (!done()) {
+      Task * task = take();
+      if (task) {
+        run(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      ++sleepers;
+      sleepCondition.wait(lock, [this, &done]() { return queued.load() > 0 || done(); });
+      --sleepers;
+    }
+}
+
+// Helps run tasks until done() is true, numbering the calling thread after the workers while it helps unless it is one
+void TaskPool::runUntil(const std::function<bool()>& done) {
+    if (currentPool == this) {
+      helpUntil(done);
+      return;
+    }
+    TaskPool * previousPool = currentPool;    // In case it works for another pool
+    int previousWorker = currentWorker;
+    currentPool = this;
+    currentWorker = workers.size();
+    helpUntil(done);
+    currentPool = previousPool;
+    currentWorker = previousWorker;
+}
+
+// The body of each worker thread
+void TaskPool::work(int index) {
+    currentPool = this;
+    currentWorker = index;
+    helpUntil([this]() { return stopping.load(); });
+}
+
+ /*!
+  * \brief Calls a function for every index in a range, sharing the indices out among the workers.
+  * \details The range is split into chunks of <code>grain</code> indices, which the workers take and steal
+  *   from each other until none are left. The calling thread runs chunks too until every index has been handled.
+  * \details While the loop runs, the TaskPool reports to the VisualTaskQueue, ProgressBar and Spectrogram it was given:
+  *   - Element <code>i - first</code> of the VisualTaskQueue is shown running, then finished, in the color of the worker
+  *     that handled index <code>i</code>.
+  *   - The ProgressBar's segments split the range evenly, in order, and each fills as its indices are handled.
+  *     Segments only ever grow, however the chunks within them finish.
+  *   - The Spectrogram counts the indices each worker handles, at hues spread evenly among the workers and
+  *     the calling thread.
+  *   \param first The first index.
+  *   \param last One past the last index.
+  *   \param body The function to call with each index. Calls for different indices may run at the same time.
+  *   \param grain The number of indices in a chunk. If 0 or less (the default), the range is split into about four
+  *     chunks per worker, so that workers that finish early have chunks left to steal.
+  * \return Whether every index was handled, which is false if the TaskPool was cancelled first.
+  */
+bool TaskPool::parallelFor(int first, int last, const indexFunction& body, int grain) {
+    if (last <= first)
+      return true;
+    int n = last - first;
+    if (grain <= 0)
+      grain = std::max(1, n / (4 * getWorkers()));
+    int chunks = (n + grain - 1) / grain;
+    std::atomic<int> remaining(chunks);
+    std::atomic<int> handled(0);
+
+    ProgressBar * bar = myProgressBar;
+    VisualTaskQueue * queue = myQueue;
+    Spectrogram * spectrogram = mySpectrogram;
+    int segs = bar ? bar->getSegs() : 0;
+    std::unique_ptr<std::atomic<int>[]> segmentDone(new std::atomic<int>[std::max(segs, 1)]);
+    std::vector<int> segmentShown(std::max(segs, 1), 0);    // The most indices shown done in each segment so far
+    std::mutex barMutex;                                    // Protects segmentShown, and orders updates to bar
+    for (int s = 0; s < segs; s++)
+      segmentDone[s] = 0;
+    std::atomic<int> * done = segmentDone.get();
+    int * shown = segmentShown.data();
+    int threadCount = getWorkers() + 1;
+
+    for (int c = 0; c < chunks; c++) {
+      int lo = first + c * grain, hi = std::min(last, lo + grain);
+      Task * task = new Task();
+      task->pending = 0;
+      task->finished = false;
+      task->owned = true;
+      task->latch = &remaining;
+      task->function = [this, lo, hi, first, n, segs, done, shown, threadCount, bar, queue, spectrogram, &barMutex, &body, &handled]() {
+        int count = 0;
+        for (int i = lo; i < hi && !isCancelled(); i++, count++) {
+          if (queue) queue->update(i - first, RUNNING);
+          body(i);
+          if (queue) queue->update(i - first, FINISHED);
+          if (bar) {
+            // Segment s holds the indices from first + ceil(s*n/segs) up to the next segment's first
+            int s = (int) ((long long) (i - first) * segs / n);
+            int segFirst = (int) (((long long) s * n + segs - 1) / segs);
+            int segLast = (int) (((long long) (s + 1) * n + segs - 1) / segs);
+            int segDone = ++done[s];
+            std::lock_guard<std::mutex> lock(barMutex);
+            if (segDone > shown[s]) {     // Another chunk in the segment may have got further first
+              shown[s] = segDone;
+              float fraction = (float) segDone / (segLast - segFirst);
+              bar->update(bar->getMinValue() + (bar->getMaxValue() - bar->getMinValue()) * (s + fraction) / segs, s);
+            }
+          }
+        }
+        handled += count;
+        if (spectrogram && count > 0)
+          spectrogram->updateLocked(getThreadNumber() * NUM_COLORS / threadCount, (float) count, 0.0f);
+      };
+      ++unfinished;
+      schedule(task);
+    }
+    runUntil([&remaining]() { return remaining.load() == 0; });
+    return handled.load() == n;
+}
+
+ /*!
+  * \brief Adds a task to the TaskPool.
+  * \details The task runs once every task in <code>dependencies</code> has finished, or right away if they
+  *   already have. Together, tasks and their dependencies make up a graph that the workers run as far in
+  *   parallel as it allows.
+  *   \param function The function the task calls.
+  *   \param dependencies The tasks that must finish before this one starts. (Defaults to none.)
+  * \return The new task, to pass in the dependencies of later tasks.
+  * \note The returned task is freed by the next wait(), and must not be used after it.
+  */
+TaskPool::Task * TaskPool::addTask(const voidFunction& function, const std::vector<Task*>& dependencies) {
+    Task * task = new Task();
+    task->function = function;
+    task->pending = 1;      // Keeps the task from being scheduled while its dependencies are still being added
+    task->finished = false;
+    task->owned = false;
+    task->latch = nullptr;
+    ++unfinished;
+    graphMutex.lock();
+    graph.push_back(task);
+    graphMutex.unlock();
+    for (unsigned i = 0; i < dependencies.size(); i++) {
+      Task * d = dependencies[i];
+      d->mutex.lock();
+      if (!d->finished) {
+        ++task->pending;
+        d->dependents.push_back(task);
+      }
+      d->mutex.unlock();
+    }
+    if (--task->pending == 0)
+      schedule(task);
+    return task;
+}
+
+ /*!
+  * \brief Waits for every task in the TaskPool to finish.
+  * \details The calling thread runs tasks while it waits. Once they have all finished, the tasks
+  *   added with addTask() are freed, and the TaskPool is no longer cancelled.
+  * \warning <b>Do not call this from a task, which would wait for itself to finish.</b>
+  */
+void TaskPool::wait() {
+    runUntil([this]() { return unfinished.load() == 0; });
+    graphMutex.lock();
+    for (unsigned i = 0; i < graph.size(); i++)
+      delete graph[i];
+    graph.clear();
+    graphMutex.unlock();
+    cancelled = false;
+}
+
+ /*!
+  * \brief Cancels the TaskPool's work.
+  * \details Tasks and loop indices that have not started yet are skipped, and tasks that depend on them
+  *   are skipped in turn. Those that have started run to completion, unless they check isCancelled().
+  *   The TaskPool takes new work again once wait() returns.
+  */
+void TaskPool::cancel() {
+    cancelled = true;
+}
+
+ /*!
+  * \brief Mutator for the VisualTaskQueue the TaskPool reports parallelFor() indices to.
+  *   \param queue The VisualTaskQueue to update, or nullptr for none.
+  * \note Set it before calling parallelFor(); it should have at least as many elements as the loop has indices.
+  */
+void TaskPool::setVisualTaskQueue(VisualTaskQueue * queue) {
+    myQueue = queue;
+}
+
+ /*!
+  * \brief Mutator for the ProgressBar the TaskPool reports parallelFor() progress to.
+  *   \param bar The ProgressBar to update, or nullptr for none.
+  * \note Set it before calling parallelFor().
+  */
+void TaskPool::setProgressBar(ProgressBar * bar) {
+    myProgressBar = bar;
+}
+
+ /*!
+  * \brief Mutator for the Spectrogram the TaskPool reports each worker's share of parallelFor() indices to.
+  *   \param spectrogram The Spectrogram to update, or nullptr for none.
+  * \note Set it before calling parallelFor(). The Spectrogram is only redrawn when its draw() method is called.
+  */
+void TaskPool::setSpectrogram(Spectrogram * spectrogram) {
+    mySpectrogram = spectrogram;
+}
+
+ /*!
+  * \brief Accessor for the number of the calling thread.
+  * \details On a TaskPool worker this is the worker's index in its pool. On a thread that is running a pool's tasks
+  *   while it waits in parallelFor() or wait(), it is the pool's getWorkers(). Elsewhere it is the OpenMP thread
+  *   number, which is 0 outside of a parallel region.
+  * \return The calling thread's number, from 0 up to one less than getThreadCount().
+  */
+int TaskPool::getThreadNumber() {
+    return (currentPool) ? currentWorker : omp_get_thread_num();
+}
+
+ /*!
+  * \brief Accessor for the number of threads working alongside the calling thread.
+  * \details On a thread running a TaskPool's tasks this is the number of workers in the pool, plus one for the
+  *   thread waiting on it. Elsewhere it is the number of threads in the current OpenMP team, which is 1 outside
+  *   of a parallel region.
+  * \return The number of threads that getThreadNumber() tells apart.
+  * \note To size a VisualTaskQueue's legend or a ProgressBar for a TaskPool from outside of it, use
+  *   <code>pool.getWorkers() + 1</code>.
+  */
+int TaskPool::getThreadCount() {
+    return (currentPool) ? currentPool->getWorkers() + 1 : omp_get_num_threads();
+}
+
+}
@@ -0,0 +1,132 @@
+/*
+ * TaskPool.h provides a pool of worker threads that share out parallel loops and graphs of tasks.
+ */
+
+#ifndef TASKPOOL_H_
+#define TASKPOOL_H_
+
+#include <atomic>               // For counting tasks without locking
+#include <condition_variable>   // For letting idle workers sleep
+#include <deque>
+#include <functional>
+#include <mutex>                // Needed for locking each worker's queue
+#include <thread>               // For the worker threads
+#include <vector>
+
+namespace tsgl {
+
+class ProgressBar;
+class Spectrogram;
+class VisualTaskQueue;
+
+/*! \class TaskPool
+ *  \brief A fixed set of worker threads that run parallel loops and graphs of tasks.
+ *  \details A TaskPool starts one worker per core, however many tasks it is given, instead of a thread per
+ *    simulated person, planet or row. Each worker keeps its own queue of tasks. It runs the newest task in its
+ *    own queue first, and once that queue is empty it steals the oldest task from another worker's, so the work
+ *    spreads itself evenly without the workers contending for a single queue.
+ *  \details parallelFor() splits a range of indices into chunks for the workers, and returns once every index has
+ *    been handled. addTask() adds a task that runs once the tasks it depends on have finished, and wait() waits for
+ *    every task to finish. Threads that wait on a TaskPool, including its own workers, run its tasks while they wait.
+ *  \details cancel() stops a TaskPool from starting any more tasks or loop indices until wait() returns.
+ *  \details A TaskPool can report what its workers do to a VisualTaskQueue, a ProgressBar and a Spectrogram,
+ *    and getThreadNumber() tells the workers apart the way <code>omp_get_thread_num()</code> tells OpenMP threads
+ *    apart, so those classes color and place each worker's updates correctly whether it runs under OpenMP or a TaskPool.
+ *    A thread that helps while it waits is numbered after the workers, so a pool tells getWorkers() + 1 threads apart.
+ *  \note A task that throws has its exception reported with TsglErr() and is otherwise treated as finished.
+ */
+class TaskPool {
+ public:
+    typedef std::function<void()>       voidFunction;
+    typedef std::function<void(int)>    indexFunction;
+
+    /*! \brief A task added with addTask(), for other tasks to depend on. */
+    struct Task {
+        voidFunction function;
+        std::atomic<int> pending;       // Unfinished dependencies, plus one while the task is being added
+        std::mutex mutex;               // Guards dependents and finished
+        std::vector<Task*> dependents;  // Tasks waiting on this one
+        bool finished;
+        bool owned;                     // Whether the TaskPool frees the Task once it finishes, rather than in wait()
+        std::atomic<int> * latch;       // Counted down once the task finishes, if not null
+    };
+ private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task*> tasks;        // The worker takes from the back; thieves take from the front
+    };
+
+    std::vector<Worker*> workers;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;     // Signaled when a task is queued or finishes
+    std::atomic<int> sleepers;                  // Threads waiting on sleepCondition
+    std::atomic<int> queued;                    // Tasks in any worker's queue
+    std::atomic<int> unfinished;                // Tasks added and not yet finished
+    std::atomic<unsigned> nextWorker;           // Queue for the next task added from outside the pool
+    std::atomic<bool> cancelled;
+    std::atomic<bool> stopping;
+    std::mutex graphMutex;
+    std::vector<Task*> graph;                   // Tasks from addTask(), freed by wait()
+    VisualTaskQueue * myQueue;
+    ProgressBar * myProgressBar;
+    Spectrogram * mySpectrogram;
+
+    static thread_local TaskPool * currentPool; // The pool the calling thread works for or is helping, if any
+    static thread_local int currentWorker;      // Its number there: its worker's index, or getWorkers() if helping
+
+    int ownWorker();
+
+    void schedule(Task * task);
+
+    Task * take();
+
+    void run(Task * task);
+
+    void wake();
+
+    void helpUntil(const std::function<bool()>& done);
+
+    void runUntil(const std::function<bool()>& done);
+
+    void work(int index);
+ public:
+    TaskPool(int numberOfWorkers = 0);
+
+    ~TaskPool();
+
+    bool parallelFor(int first, int last, const indexFunction& body, int grain = 0);
+
+    Task * addTask(const voidFunction& function, const std::vector<Task*>& dependencies = std::vector<Task*>());
+
+    void wait();
+
+    void cancel();
+
+    /*!
+     * \brief Accessor for whether the TaskPool has been cancelled.
+     * \details Long tasks can check this to stop early.
+     * \return Whether cancel() has been called since wait() last returned.
+     */
+    bool isCancelled() { return cancelled.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Accessor for the number of workers in the TaskPool.
+     * \return The number of worker threads the TaskPool started.
+     */
+    int getWorkers() { return workers.size(); }
+
+    void setVisualTaskQueue(VisualTaskQueue * queue);
+
+    void setProgressBar(ProgressBar * bar);
+
+    void setSpectrogram(Spectrogram * spectrogram);
+
+    static int getThreadNumber();
+
+    static int getThreadCount();
+};
+
+}
+
+#endif /* TASKPOOL_H_ */
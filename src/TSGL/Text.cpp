@@ -65,13 +65,9 @@ Text::Text(float x, float y, float z, std::wstring text, std::string fontFilenam
  *  \param shader Pointer to appropriate instance of Shader being used to render the Text.
  */
 void Text::draw(Shader * shader) {
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(mySize / 100, mySize / 100, myZScale));
+    Transform t = getTransform();
+    t.xScale = t.yScale = mySize / 100;    // Text is scaled by its font size rather than by myXScale and myYScale
+    glm::mat4 model = modelMatrix(t);
 
     unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
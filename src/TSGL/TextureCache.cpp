@@ -0,0 +1,658 @@
+#include "TextureCache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <sys/stat.h>
+#include <stb/stb_image.h>
+#ifdef _WIN32
+  #include <direct.h>       // For _mkdir()
+  #include <process.h>      // For _getpid()
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>     // For mapping cached pixels
+  #include <unistd.h>
+#endif
+#include "ChangeSignal.h"       // For waking idle Canvases once an image is decoded
+#include "Error.h"
+#include "ImageLoader.h"
+#include "RenderService.h"     // For the context to cache GL objects under
+
+namespace tsgl {
+
+TextureCache::EntryMap TextureCache::entries;
+TextureCache::OrphanMap TextureCache::orphans;
+TextureCache::OrphanMap TextureCache::orphanBuffers;
+std::set<GLFWwindow*> TextureCache::liveContexts;
+std::set<GLFWwindow*> TextureCache::renderContexts;
+std::set<TextureCache::Entry*> TextureCache::prepared;
+unsigned TextureCache::createdCount = 0;
+std::string TextureCache::diskCacheDirectory;
+bool TextureCache::diskCacheConfigured = false;
+std::mutex TextureCache::cacheMutex;
+
+static std::once_flag flipOnLoad;      // stb_image's flip setting is a global shared by every decoding thread
+
+ /*!
+  * \brief Acquires a reference to the decoded image stored in a file.
+  * \details If the file has already been loaded by another user its pixels are shared. Otherwise the
+  *   file is decoded on the calling thread, or, if <code>async</code> is true, queued for decoding on
+  *   the ImageLoader's worker threads.
+  *   \param filename The path of the image file to load.
+  *   \param async Whether to return immediately instead of waiting for the file to be decoded.
+  * \return A pointer to the shared Entry, or nullptr if the file could not be decoded. When
+  *   <code>async</code> is true the Entry is returned right away and may not be ready yet (see isReady()).
+  * \note Every successful call to acquire() must be balanced by a call to release().
+  */
+TextureCache::Entry * TextureCache::acquire(const std::string& filename, bool async) {
+    cacheMutex.lock();
+    EntryMap::iterator it = entries.find(filename);
+    if (it != entries.end()) {
+        Entry * e = it->second;
+        e->refCount++;
+        cacheMutex.unlock();
+        if (!async && !wait(e)) {           // Someone else is still decoding it; wait for them
+            release(e);
+            return nullptr;
+        }
+        return e;
+    }
+
+    if (async) {
+        Entry * e = new Entry();
+        e->filename = filename;
+        e->pixels = nullptr;
+        e->width = e->height = 0;
+        e->refCount = 2;                    // One for the caller, one for the worker decoding it
+        e->version = 0;
+        e->ready = e->failed = false;
+        entries[filename] = e;
+        e->loaded = ImageLoader::submit(std::bind(&TextureCache::decode, e));
+        cacheMutex.unlock();
+        return e;
+    }
+    cacheMutex.unlock();
+
+    // Decode without holding the lock so other threads can keep using the cache
+    int w = 0, h = 0;
+    void * mapping = nullptr;
+    size_t mappingSize = 0;
+    unsigned char * data = loadPixels(filename, w, h, mapping, mappingSize);
+    if (!data) {
+        TsglErr("stbi_load(" + filename + ") failed.");
+        return nullptr;
+    }
+
+    cacheMutex.lock();
+    it = entries.find(filename);
+    if (it != entries.end()) {              // Somebody else started loading it first
+        Entry * e = it->second;
+        e->refCount++;
+        cacheMutex.unlock();
+        freePixels(data, mapping, mappingSize);
+        if (!wait(e)) {
+            release(e);
+            return nullptr;
+        }
+        return e;
+    }
+    Entry * e = new Entry();
+    e->filename = filename;
+    e->pixels = data;
+    e->mapping = mapping;
+    e->mappingSize = mappingSize;
+    e->width = w;
+    e->height = h;
+    e->refCount = 1;
+    e->version = 0;
+    e->ready = true;
+    e->failed = false;
+    entries[filename] = e;
+    cacheMutex.unlock();
+    return e;
+}
+
+ /*!
+  * \brief Creates an Entry from pixels that were made in memory rather than loaded from a file.
+  * \details The Entry behaves like one made by acquire(), except that no file refers to it, so it
+  *   is never shared by a later call to acquire().
+  *   \param pixels Tightly packed RGBA pixels, bottom row first, allocated with malloc(). The cache
+  *     takes ownership of them and frees them when the Entry is released.
+  *   \param width The width of pixels.
+  *   \param height The height of pixels.
+  * \return A pointer to the new Entry, with one reference held by the caller.
+  */
+TextureCache::Entry * TextureCache::create(unsigned char * pixels, int width, int height) {
+    Entry * e = new Entry();
+    e->pixels = pixels;
+    e->mapping = nullptr;
+    e->mappingSize = 0;
+    e->width = width;
+    e->height = height;
+    e->refCount = 1;
+    e->version = 0;
+    e->ready = true;
+    e->failed = false;
+    cacheMutex.lock();
+    e->filename = "<memory " + std::to_string(createdCount++) + ">";
+    entries[e->filename] = e;
+    cacheMutex.unlock();
+    return e;
+}
+
+ /*!
+  * \brief Checks whether an Entry's pixels have been decoded.
+  *   \param entry The Entry to check.
+  * \return True if the Entry can be drawn, false if it is still being decoded or failed to decode.
+  */
+bool TextureCache::isReady(Entry * entry) {
+    if (!entry) return false;
+    cacheMutex.lock();
+    bool ready = entry->ready;
+    cacheMutex.unlock();
+    return ready;
+}
+
+ /*!
+  * \brief Checks whether an Entry's file could not be decoded.
+  *   \param entry The Entry to check.
+  * \return True if decoding has finished and failed.
+  */
+bool TextureCache::hasFailed(Entry * entry) {
+    if (!entry) return true;
+    cacheMutex.lock();
+    bool failed = entry->failed;
+    cacheMutex.unlock();
+    return failed;
+}
+
+ /*!
+  * \brief Blocks until an Entry has finished decoding.
+  *   \param entry The Entry to wait for.
+  * \return True if the Entry's pixels are available, false if decoding failed.
+  */
+bool TextureCache::wait(Entry * entry) {
+    if (!entry) return false;
+    cacheMutex.lock();
+    std::shared_future<bool> loaded = entry->loaded;
+    bool ready = entry->ready;
+    cacheMutex.unlock();
+    if (ready || !loaded.valid())
+        return ready;
+    return loaded.get();
+}
+
+ /*!
+  * \brief Releases a reference obtained from acquire().
+  * \details When the last reference is released the decoded pixels are freed, and the entry's
+  *   textures are queued for deletion by their render threads.
+  *   \param entry The Entry to release. May be nullptr.
+  */
+void TextureCache::release(Entry * entry) {
+    if (!entry) return;
+    cacheMutex.lock();
+    if (--entry->refCount == 0) {
+        EntryMap::iterator it = entries.find(entry->filename);
+        if (it != entries.end() && it->second == entry)
+            entries.erase(it);
+        for (TextureMap::iterator it = entry->textures.begin(); it != entry->textures.end(); ++it)
+            orphans[it->first].push_back(it->second.first);
+        prepared.erase(entry);
+        freePixels(entry->pixels, entry->mapping, entry->mappingSize);
+        delete entry;
+    }
+    cacheMutex.unlock();
+}
+
+ /*!
+  * \brief Binds the texture for an Entry in the current GL context.
+  * \details Creates and uploads the texture the first time the Entry is bound in this context, and
+  *   re-uploads it if its pixels have changed since; otherwise this is a plain glBindTexture().
+  *   \param entry The Entry to bind.
+  * \return The name of the bound texture, or 0 if there is no current context or the Entry isn't ready.
+  * \warning This must be called from a thread with a current GL context (e.g., from within draw()), and
+  *   with a reference to the Entry held.
+  */
+GLuint TextureCache::bindTexture(Entry * entry) {
+    GLFWwindow * context = RenderService::currentContext();
+    if (!entry || !context) return 0;
+    return upload(entry, context);
+}
+
+ /*!
+  * \brief Replaces the pixels of an Entry.
+  * \details The new pixels are copied and uploaded to every context at the next bind.
+  *   \param entry The Entry whose pixels to replace.
+  *   \param data Tightly packed RGBA pixels with the same dimensions as the Entry, bottom row first.
+  * \note All Images sharing the Entry will display the new pixels.
+  */
+void TextureCache::updatePixels(Entry * entry, const unsigned char * data) {
+    if (!entry || !data) return;
+    if (!isReady(entry)) {
+        TsglDebug("Cannot update the pixels of an image that has not been loaded.");
+        return;
+    }
+    entry->pixelMutex.lock();
+    memcpy(entry->pixels, data, (size_t) entry->width * entry->height * 4);
+    cacheMutex.lock();
+    entry->version++;
+    cacheMutex.unlock();
+    entry->pixelMutex.unlock();
+}
+
+ /*!
+  * \brief Requests that an Entry be uploaded before it is first drawn.
+  * \details Every Canvas uploads requested entries into its context at the start of its next frame
+  *   (or, for an Entry still being decoded, at the start of the first frame after it is ready).
+  *   \param entry The Entry to upload early.
+  */
+void TextureCache::prepare(Entry * entry) {
+    if (!entry) return;
+    cacheMutex.lock();
+    prepared.insert(entry);
+    cacheMutex.unlock();
+}
+
+ /*!
+  * \brief Performs the cache's per-frame work for the current GL context.
+  * \details Deletes the textures of released entries (and any other textures and buffers handed to
+  *   deleteTextureLater() or deleteBufferLater()) that belong to this context, and uploads any
+  *   entries for which prepare() was requested. Only requested entries that some Canvas has yet to upload
+  *   are looked at, and uploads are made without holding the cache's lock.
+  * \note Called by Canvas at the start of each frame.
+  */
+void TextureCache::update() {
+    GLFWwindow * context = RenderService::currentContext();
+    if (!context) return;
+    std::vector<GLuint> textures, buffers;
+    std::vector<Entry*> toUpload;
+    cacheMutex.lock();
+    renderContexts.insert(context);
+    OrphanMap::iterator it = orphans.find(context);
+    if (it != orphans.end()) {
+        textures.swap(it->second);
+        orphans.erase(it);
+    }
+    it = orphanBuffers.find(context);
+    if (it != orphanBuffers.end()) {
+        buffers.swap(it->second);
+        orphanBuffers.erase(it);
+    }
+    for (std::set<Entry*>::iterator e = prepared.begin(); e != prepared.end(); ) {
+        Entry * entry = *e;
+        bool everywhere = entry->ready;
+        for (std::set<GLFWwindow*>::iterator c = renderContexts.begin(); c != renderContexts.end() && everywhere; ++c)
+            everywhere = isUploaded(entry, *c);
+        if (everywhere) {
+            prepared.erase(e++);        // Every Canvas has it; later ones upload it when they first draw it
+            continue;
+        }
+        if (entry->ready && !isUploaded(entry, context)) {
+            entry->refCount++;          // Keeps it alive while it uploads without the lock
+            toUpload.push_back(entry);
+        }
+        ++e;
+    }
+    cacheMutex.unlock();
+
+    if (!textures.empty())
+        glDeleteTextures(textures.size(), textures.data());
+    if (!buffers.empty())
+        glDeleteBuffers(buffers.size(), buffers.data());
+    for (unsigned i = 0; i < toUpload.size(); i++) {
+        upload(toUpload[i], context);
+        release(toUpload[i]);
+    }
+}
+
+ /*!
+  * \brief Queues a texture to be deleted by the render thread that owns it.
+  * \details For Drawables that create their own textures and may be destroyed on a thread without a GL context.
+  *   \param context The context the texture was created in.
+  *   \param texture The texture to delete at the start of that context's next frame.
+  * \note If the context has already been destroyed the texture went with it, and nothing is queued.
+  */
+void TextureCache::deleteTextureLater(GLFWwindow * context, GLuint texture) {
+    if (!context || !texture) return;
+    cacheMutex.lock();
+    if (liveContexts.count(context))
+        orphans[context].push_back(texture);
+    cacheMutex.unlock();
+}
+
+ /*!
+  * \brief Queues a buffer to be deleted by the render thread that owns it.
+  *   \param context The context the buffer was created in.
+  *   \param buffer The buffer to delete at the start of that context's next frame.
+  * \note If the context has already been destroyed the buffer went with it, and nothing is queued.
+  */
+void TextureCache::deleteBufferLater(GLFWwindow * context, GLuint buffer) {
+    if (!context || !buffer) return;
+    cacheMutex.lock();
+    if (liveContexts.count(context))
+        orphanBuffers[context].push_back(buffer);
+    cacheMutex.unlock();
+}
+
+ /*!
+  * \brief Starts accepting textures and buffers to delete later in a new GL context.
+  *   \param context The context that has just been created.
+  * \note Called by Canvas (and the RenderService) as it creates its window.
+  */
+void TextureCache::contextCreated(GLFWwindow * context) {
+    cacheMutex.lock();
+    liveContexts.insert(context);
+    cacheMutex.unlock();
+}
+
+ /*!
+  * \brief Forgets every texture that belonged to a destroyed GL context.
+  * \details Later calls to deleteTextureLater() and deleteBufferLater() for the context are ignored, so
+  *   a new window that happens to get the same address never deletes objects it doesn't own.
+  *   \param context The context that is being destroyed.
+  * \note Called by Canvas as it tears down its window, before the window itself is destroyed.
+  */
+void TextureCache::contextDestroyed(GLFWwindow * context) {
+    cacheMutex.lock();
+    liveContexts.erase(context);
+    renderContexts.erase(context);
+    orphans.erase(context);
+    orphanBuffers.erase(context);
+    for (EntryMap::iterator e = entries.begin(); e != entries.end(); ++e)
+        e->second->textures.erase(context);
+    cacheMutex.unlock();
+}
+
+// Whether the Entry's current pixels have been uploaded in context. cacheMutex must be held.
+bool TextureCache::isUploaded(Entry * entry, GLFWwindow * context) {
+    TextureMap::iterator it = entry->textures.find(context);
+    return it != entry->textures.end() && it->second.second == entry->version;
+}
+
+// Creates or refreshes the Entry's texture in context and binds it, or returns 0 if the Entry isn't ready.
+// cacheMutex must not be held: only the Entry's pixelMutex is held while the pixels are uploaded, so that a large
+// upload doesn't hold up every other thread using the cache. The caller must hold a reference to the Entry.
+GLuint TextureCache::upload(Entry * entry, GLFWwindow * context) {
+    cacheMutex.lock();
+    if (!entry->ready) {
+        cacheMutex.unlock();
+        return 0;
+    }
+    TextureMap::iterator it = entry->textures.find(context);
+    GLuint texture = (it != entry->textures.end()) ? it->second.first : 0;
+    if (texture && it->second.second == entry->version) {
+        cacheMutex.unlock();
+        glBindTexture(GL_TEXTURE_2D, texture);
+        return texture;
+    }
+    cacheMutex.unlock();
+
+    entry->pixelMutex.lock();       // Keeps updatePixels() from changing them mid-upload
+    unsigned version = entry->version;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (!texture) {
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        // Set texture parameters for wrapping.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        // Set texture parameters for filtering.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, entry->width, entry->height, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, entry->pixels);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, entry->width, entry->height,
+                        GL_RGBA, GL_UNSIGNED_BYTE, entry->pixels);
+    }
+    glGenerateMipmap(GL_TEXTURE_2D);
+    entry->pixelMutex.unlock();
+
+    cacheMutex.lock();
+    entry->textures[context] = std::make_pair(texture, version);
+    cacheMutex.unlock();
+    return texture;
+}
+
+// Decodes an asynchronously acquired Entry on an ImageLoader thread, then drops the worker's reference.
+bool TextureCache::decode(Entry * entry) {
+    int w = 0, h = 0;
+    void * mapping = nullptr;
+    size_t mappingSize = 0;
+    unsigned char * data = loadPixels(entry->filename, w, h, mapping, mappingSize);
+
+    cacheMutex.lock();
+    if (data) {
+        entry->pixels = data;
+        entry->mapping = mapping;
+        entry->mappingSize = mappingSize;
+        entry->width = w;
+        entry->height = h;
+        entry->ready = true;
+    } else {
+        entry->failed = true;
+        EntryMap::iterator it = entries.find(entry->filename);
+        if (it != entries.end() && it->second == entry)
+            entries.erase(it);              // Let a later acquire() try again
+    }
+    cacheMutex.unlock();
+    if (!data)
+        TsglErr("stbi_load(" + entry->filename + ") failed.");
+    ChangeSignal::notifyAll();          // Whatever Canvas draws the entry can show it now
+    release(entry);
+    return data != nullptr;
+}
+
+// Header of a file in the disk cache. The original file's absolute path follows it, and the pixels
+// follow that at the next multiple of 64 bytes (see diskCachePixelOffset()).
+struct DiskCacheHeader {
+    char magic[8];                      // "TSGLRAW" and a terminating '\0'
+    uint32_t version;                   // DISK_CACHE_VERSION
+    uint32_t width, height;             // Dimensions of the pixels
+    uint32_t pathLength;                // Length of the path after the header, without a terminator
+    int64_t sourceModified;             // st_mtime of the original file
+    int64_t sourceSize;                 // st_size of the original file
+    char padding[24];                   // Makes the header 64 bytes long
+};
+
+static const uint32_t DISK_CACHE_VERSION = 2;
+
+// Where the pixels start in a disk cache file whose path is pathLength bytes long.
+static size_t diskCachePixelOffset(uint32_t pathLength) {
+    return (sizeof(DiskCacheHeader) + pathLength + 63) / 64 * 64;
+}
+
+// Makes a path absolute and resolves any links in it, so one file always has one name in the disk cache.
+static std::string canonicalPath(const std::string& filename) {
+  #ifdef _WIN32
+    char * path = _fullpath(nullptr, filename.c_str(), 0);
+  #else
+    char * path = realpath(filename.c_str(), nullptr);
+  #endif
+    if (!path) return filename;
+    std::string canonical(path);
+    free(path);
+    return canonical;
+}
+
+ /*!
+  * \brief Turns the on-disk cache of decoded images on or off.
+  * \details When enabled, every file decoded by the cache is also written to <code>directory</code> as raw
+  *   RGBA pixels, already flipped for GL. The next time the same file is loaded, in this run or a later one,
+  *   the raw pixels are memory-mapped instead of decoding the file, provided the original's absolute path,
+  *   modification time and size haven't changed.
+  * \details If this is never called, the directory named by the <code>TSGL_IMAGE_CACHE</code> environment
+  *   variable is used, if there is one.
+  *   \param directory The directory to store decoded images in (created if necessary), or an empty
+  *     string to disable the disk cache.
+  * \note Cached files are about as large as the images are in memory (4 bytes per pixel), and are never
+  *   removed by TSGL.
+  */
+void TextureCache::setDiskCacheDirectory(const std::string& directory) {
+    cacheMutex.lock();
+    diskCacheDirectory = directory;
+    diskCacheConfigured = true;
+    cacheMutex.unlock();
+    if (!directory.empty()) {
+      #ifdef _WIN32
+        _mkdir(directory.c_str());
+      #else
+        mkdir(directory.c_str(), 0755);
+      #endif
+    }
+}
+
+ /*!
+  * \brief Accessor for the on-disk cache's directory.
+  * \return The directory decoded images are cached in, or an empty string if the disk cache is disabled.
+  */
+std::string TextureCache::getDiskCacheDirectory() {
+    cacheMutex.lock();
+    if (!diskCacheConfigured) {
+        const char * env = getenv("TSGL_IMAGE_CACHE");
+        cacheMutex.unlock();
+        setDiskCacheDirectory(env ? env : "");
+        cacheMutex.lock();
+    }
+    std::string directory = diskCacheDirectory;
+    cacheMutex.unlock();
+    return directory;
+}
+
+// Names the disk cache file for a source file, given its canonicalPath(), or returns "" if the disk cache is disabled.
+std::string TextureCache::diskCachePath(const std::string& sourcePath) {
+    std::string directory = getDiskCacheDirectory();
+    if (directory.empty()) return "";
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.tsglraw", (unsigned long long) std::hash<std::string>()(sourcePath));
+    return directory + name;
+}
+
+// Loads a file's pixels, from the disk cache if possible, decoding (and caching) them otherwise.
+// If the pixels were mapped, mapping and mappingSize describe the mapping to free.
+unsigned char * TextureCache::loadPixels(const std::string& filename, int& width, int& height, void *& mapping, size_t& mappingSize) {
+    mapping = nullptr;
+    mappingSize = 0;
+    std::string sourcePath = canonicalPath(filename);
+    std::string cachePath = diskCachePath(sourcePath);
+    struct stat source;
+    bool cacheable = !cachePath.empty() && stat(filename.c_str(), &source) == 0;
+
+    if (cacheable) {
+        DiskCacheHeader header;
+      #ifndef _WIN32
+        int fd = open(cachePath.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat cached;
+            std::string cachedPath;
+            if (fstat(fd, &cached) == 0 && (size_t) cached.st_size >= sizeof(header)
+              && read(fd, &header, sizeof(header)) == (ssize_t) sizeof(header)
+              && memcmp(header.magic, "TSGLRAW", 8) == 0 && header.version == DISK_CACHE_VERSION
+              && header.sourceModified == (int64_t) source.st_mtime && header.sourceSize == (int64_t) source.st_size
+              && header.pathLength == sourcePath.size()
+              && (size_t) cached.st_size == diskCachePixelOffset(header.pathLength) + (size_t) header.width * header.height * 4) {
+                cachedPath.resize(header.pathLength);
+                if (read(fd, &cachedPath[0], header.pathLength) != (ssize_t) header.pathLength || cachedPath != sourcePath)
+                    cachedPath.clear();     // Another file whose path hashes the same
+            }
+            if (!cachedPath.empty()) {
+                // Private, writable mapping so updatePixels() can modify it without touching the file
+                void * m = mmap(nullptr, cached.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (m != MAP_FAILED) {
+                    close(fd);
+                    mapping = m;
+                    mappingSize = cached.st_size;
+                    width = header.width;
+                    height = header.height;
+                    return (unsigned char *) m + diskCachePixelOffset(header.pathLength);
+                }
+            }
+            close(fd);
+        }
+      #else
+        FILE * f = fopen(cachePath.c_str(), "rb");
+        if (f) {
+            std::string cachedPath;
+            if (fread(&header, sizeof(header), 1, f) == 1
+              && memcmp(header.magic, "TSGLRAW", 8) == 0 && header.version == DISK_CACHE_VERSION
+              && header.sourceModified == (int64_t) source.st_mtime && header.sourceSize == (int64_t) source.st_size
+              && header.pathLength == sourcePath.size()) {
+                cachedPath.resize(header.pathLength);
+                if (fread(&cachedPath[0], 1, header.pathLength, f) != header.pathLength || cachedPath != sourcePath
+                  || fseek(f, diskCachePixelOffset(header.pathLength), SEEK_SET) != 0)
+                    cachedPath.clear();     // Another file whose path hashes the same
+            }
+            if (!cachedPath.empty()) {
+                size_t size = (size_t) header.width * header.height * 4;
+                unsigned char * data = (unsigned char *) malloc(size);
+                if (data && fread(data, 1, size, f) == size) {
+                    fclose(f);
+                    width = header.width;
+                    height = header.height;
+                    return data;
+                }
+                free(data);
+            }
+            fclose(f);
+        }
+      #endif
+    }
+
+    std::call_once(flipOnLoad, stbi_set_flip_vertically_on_load, 1);
+    unsigned char * data = stbi_load(filename.c_str(), &width, &height, 0, 4);
+    if (!data || !cacheable) return data;
+
+    // Write to a temporary file and rename it so other threads and processes never see half a file.
+    DiskCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "TSGLRAW", 8);
+    header.version = DISK_CACHE_VERSION;
+    header.width = width;
+    header.height = height;
+    header.sourceModified = source.st_mtime;
+    header.sourceSize = source.st_size;
+    header.pathLength = sourcePath.size();
+    char suffix[48];
+  #ifdef _WIN32
+    snprintf(suffix, sizeof(suffix), ".%d.%p.tmp", _getpid(), (void *) data);
+  #else
+    snprintf(suffix, sizeof(suffix), ".%ld.%p.tmp", (long) getpid(), (void *) data);
+  #endif
+    std::string tempPath = cachePath + suffix;
+    FILE * f = fopen(tempPath.c_str(), "wb");
+    if (f) {
+        size_t size = (size_t) width * height * 4;
+        std::string gap(diskCachePixelOffset(header.pathLength) - sizeof(header) - header.pathLength, '\0');
+        bool written = fwrite(&header, sizeof(header), 1, f) == 1
+          && fwrite(sourcePath.data(), 1, sourcePath.size(), f) == sourcePath.size()
+          && fwrite(gap.data(), 1, gap.size(), f) == gap.size()
+          && fwrite(data, 1, size, f) == size;
+        written = (fclose(f) == 0) && written;
+      #ifdef _WIN32
+        remove(cachePath.c_str());      // rename() won't replace an existing file on Windows
+      #endif
+        if (!written || rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+            remove(tempPath.c_str());
+            TsglDebug("Could not write " + cachePath + " to the image cache.");
+        }
+    }
+    return data;
+}
+
+// Frees pixels returned by loadPixels() or stbi_load().
+void TextureCache::freePixels(unsigned char * pixels, void * mapping, size_t mappingSize) {
+  #ifndef _WIN32
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        return;
+    }
+  #endif
+    stbi_image_free(pixels);
+}
+
+}
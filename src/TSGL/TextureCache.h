@@ -0,0 +1,118 @@
+/*
+ * TextureCache.h provides a reference-counted cache of decoded images and the GL textures made from them.
+ */
+
+#ifndef TEXTURECACHE_H_
+#define TEXTURECACHE_H_
+
+#include <future>       // For waiting on entries that are decoded asynchronously
+#include <map>          // For the path -> Entry and context -> texture maps
+#include <mutex>        // Needed for locking the cache for thread-safety
+#include <set>          // For the contexts that are still alive
+#include <string>
+#include <vector>
+
+#include "gl_includes.h"
+
+namespace tsgl {
+
+/*! \class TextureCache
+ *  \brief Shares decoded images and their GL textures between every Drawable that uses the same file.
+ *  \details TextureCache decodes each image file once and keeps its pixels for as long as at least one
+ *    Image (or Background) holds a reference to it.
+ *  \details The GL texture for an entry is created the first time it is bound on a render thread and is
+ *    re-uploaded only when its pixels change (see updatePixels()). Since every Canvas owns its own GL context,
+ *    an entry keeps one texture per context it has been drawn in.
+ *  \details Files may also be acquired asynchronously, in which case they are decoded on the ImageLoader's worker
+ *    threads and the entry becomes ready once its pixels are available. Until then bindTexture() does nothing.
+ *  \details Decoding can optionally be skipped altogether on later runs: once a disk cache directory is set
+ *    (see setDiskCacheDirectory()), each decoded file is also written there as raw, pre-flipped RGBA pixels, and later
+ *    loads of an unchanged file memory-map those pixels instead of decoding the original.
+ *  \details Textures belonging to released entries are deleted by the owning Canvas' render thread at the
+ *    start of its next frame, so acquire() and release() may be called from any thread. Drawables that own
+ *    other GL objects can hand them to deleteTextureLater() and deleteBufferLater() for the same treatment.
+ *    Objects of a context that has already been destroyed went with it, so they are not queued at all.
+ *  \note TextureCache is used internally by Image and Background; most users will never need to call it directly.
+ */
+class TextureCache {
+ public:
+    typedef std::map<GLFWwindow*, std::pair<GLuint,unsigned> > TextureMap;
+
+    /*! \brief A decoded image shared between all of its users. */
+    struct Entry {
+        std::string filename;                                   // Key of this entry
+        unsigned char * pixels;                                 // Decoded RGBA pixels, flipped for GL
+        void * mapping;                                         // Memory-mapped disk cache file holding pixels, if any
+        size_t mappingSize;                                     // Length of mapping
+        int width, height;                                      // Dimensions of pixels
+        unsigned refCount;                                      // Number of acquire() calls not yet released
+        unsigned version;                                       // Incremented whenever pixels change
+        bool ready;                                             // Whether pixels have been decoded
+        bool failed;                                            // Whether decoding the file failed
+        std::shared_future<bool> loaded;                        // Becomes true or false when decoding finishes
+        TextureMap textures;                                    // Context -> (texture, uploaded version)
+        std::mutex pixelMutex;                                  // Held while pixels are written or uploaded
+    };
+
+    static Entry * acquire(const std::string& filename, bool async = false);
+
+    static Entry * create(unsigned char * pixels, int width, int height);
+
+    static bool isReady(Entry * entry);
+
+    static bool hasFailed(Entry * entry);
+
+    static bool wait(Entry * entry);
+
+    static void release(Entry * entry);
+
+    static GLuint bindTexture(Entry * entry);
+
+    static void updatePixels(Entry * entry, const unsigned char * data);
+
+    static void prepare(Entry * entry);
+
+    static void update();
+
+    static void deleteTextureLater(GLFWwindow * context, GLuint texture);
+
+    static void deleteBufferLater(GLFWwindow * context, GLuint buffer);
+
+    static void contextCreated(GLFWwindow * context);
+
+    static void contextDestroyed(GLFWwindow * context);
+
+    static void setDiskCacheDirectory(const std::string& directory);
+
+    static std::string getDiskCacheDirectory();
+ private:
+    typedef std::map<std::string, Entry*> EntryMap;
+    typedef std::map<GLFWwindow*, std::vector<GLuint> > OrphanMap;
+
+    static EntryMap entries;                                    // All live entries, keyed by filename
+    static OrphanMap orphans;                                   // Textures of released entries, by context
+    static OrphanMap orphanBuffers;                             // Buffers passed to deleteBufferLater(), by context
+    static std::set<GLFWwindow*> liveContexts;                  // Contexts created and not yet destroyed
+    static std::set<GLFWwindow*> renderContexts;                // Live contexts that have called update()
+    static std::set<Entry*> prepared;                           // Entries passed to prepare() not yet uploaded everywhere
+    static unsigned createdCount;                               // Number of entries made by create(), for naming them
+    static std::string diskCacheDirectory;                      // Where decoded files are cached; empty if disabled
+    static bool diskCacheConfigured;                            // Whether diskCacheDirectory has been set or read from the environment
+    static std::mutex cacheMutex;                               // Protects everything above, but not uploads
+
+    static GLuint upload(Entry * entry, GLFWwindow * context);
+
+    static bool isUploaded(Entry * entry, GLFWwindow * context);
+
+    static bool decode(Entry * entry);
+
+    static unsigned char * loadPixels(const std::string& filename, int& width, int& height, void *& mapping, size_t& mappingSize);
+
+    static void freePixels(unsigned char * pixels, void * mapping, size_t mappingSize);
+
+    static std::string diskCachePath(const std::string& sourcePath);
+};
+
+}
+
+#endif /* TEXTURECACHE_H_ */
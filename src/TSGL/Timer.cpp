@@ -1,7 +1,18 @@
 #include "Timer.h"
 
+#ifdef __linux__
+  #include <errno.h>
+  #include <time.h>         // For clock_nanosleep
+#endif
+
 namespace tsgl {
 
+#ifdef _WIN32
+const double Timer::SPIN_TIME = 0.002;      // Windows only sleeps in whole scheduler ticks
+#else
+const double Timer::SPIN_TIME = 0.0002;
+#endif
+
 /*!
  * \brief Default Timer constructor method.
  * \details This is the default constructor for the Timer class.
@@ -29,6 +40,15 @@ unsigned int Timer::getReps() const {
     return std::chrono::duration_cast<duration_d>(highResClock::now() - start_time).count() / period_.count();
 }
 
+/*!
+ * \brief Gets the Timer's period.
+ * \return The time in seconds between the points sleep() wakes at.
+ */
+double Timer::getPeriod() {
+    mutexLock sleepLock(sleep_);
+    return period_.count();
+}
+
 // Get the time since start
 /*!
  * \brief Gets the elapsed time since starting the timer
@@ -78,6 +98,18 @@ void Timer::reset(double period) {
     last_rep = 0;
 }
 
+/*!
+ * \brief Changes the Timer's period without resetting it.
+ * \details Unlike reset(), this keeps the starting time, so the next call to sleep() waits for
+ *   the new period after the last one.
+ *   \param period The new period for the Timer. Setting this less than or equal to 0 does nothing.
+ */
+void Timer::setPeriod(double period) {
+    if (period <= 0) return;
+    mutexLock sleepLock(sleep_);
+    period_ = duration_d(period);
+}
+
 // Sleep the thread until the period has passed
 /*!
  * \brief Sleeps the Timer's current thread until its period elapses.
@@ -86,8 +118,8 @@ void Timer::reset(double period) {
  * \details If the Timer's period has elapsed since last call, the thread will continue execution
  *   normally until the next call to sleep().
  *   \param update Whether to update the timer's last_rep status or not.
- * \note This function does not guarantee the thread will resume immediately after the time expires.
- *   Depending on your OS, the thread may sleep for longer.
+ * \note The thread sleeps until shortly before the period expires, then spins the rest of the way,
+ *   so it usually resumes within a few microseconds of the deadline even when the OS oversleeps.
  * \see getTimeBetweenSleeps(), to get the actual elapsed time between sleeps.
  */
 void Timer::sleep(bool update) {
@@ -101,13 +133,24 @@ void Timer::sleep(bool update) {
     if (update)
       last_time = sleep_time;
 
-    long double nano = std::chrono::duration_cast<duration_d>(sleep_time - highResClock::now()).count();
-    std::this_thread::sleep_for(std::chrono::nanoseconds((long long) (nano * 1000000000)));
+    threadSleepUntil(sleep_time);
 
     time_between_sleeps = std::chrono::duration_cast<duration_d>(highResClock::now() - sleep_time).count()
         + period_.count();
 }
 
+/*!
+ * \brief Marks the end of a period without sleeping.
+ * \details This function is for loops that are paced by something other than the Timer, such as
+ *   the monitor's refresh. It starts the next period now and updates getTimeBetweenSleeps().
+ */
+void Timer::tick() {
+    timepoint_d now = highResClock::now();
+    mutexLock sleepLock(sleep_);
+    time_between_sleeps = std::chrono::duration_cast<duration_d>(now - last_time).count();
+    last_time = now;
+}
+
 // Sleep the thread for a specified duration
 /*!
  * \brief Sleeps the current thread for the specified duration.
@@ -119,4 +162,29 @@ void Timer::threadSleepFor(double duration) {
     std::this_thread::sleep_for(std::chrono::nanoseconds((long long) (duration * 1000000000)));
 }
 
+/*!
+ * \brief Sleeps the current thread until a point in time.
+ * \details This function sleeps until shortly before <code>deadline</code>, against an absolute deadline where the OS
+ *   supports one, and then spins until it passes, since the OS may wake a sleeping thread well after it asked.
+ *   \param deadline The time to resume at.
+ */
+void Timer::threadSleepUntil(timepoint_d deadline) {
+    double remaining = std::chrono::duration_cast<duration_d>(deadline - highResClock::now()).count();
+    if (remaining > SPIN_TIME) {
+      #ifdef __linux__
+        // high_resolution_clock may follow the wall clock, so sleep against the monotonic one instead
+        timespec wake;
+        clock_gettime(CLOCK_MONOTONIC, &wake);
+        long long nano = wake.tv_nsec + (long long) ((remaining - SPIN_TIME) * 1000000000);
+        wake.tv_sec += nano / 1000000000;
+        wake.tv_nsec = nano % 1000000000;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR);
+      #else
+        std::this_thread::sleep_for(std::chrono::nanoseconds((long long) ((remaining - SPIN_TIME) * 1000000000)));
+      #endif
+    }
+    while (highResClock::now() < deadline)
+        std::this_thread::yield();
+}
+
 }
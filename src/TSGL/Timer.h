@@ -16,6 +16,15 @@ typedef std::chrono::time_point<highResClock, duration_d> timepoint_d;
 
 namespace tsgl {
 
+/*! \brief Ways a Canvas can schedule its frames. */
+enum FramePacing {
+    PACE_FIXED,         ///< Draw at the Canvas' fixed rate, sleeping until each frame is due
+    PACE_VSYNC,         ///< Draw once per refresh of the monitor, waiting for it in glfwSwapBuffers()
+    PACE_UNCAPPED,      ///< Draw as fast as possible
+    PACE_ADAPTIVE,      ///< Draw at the Canvas' fixed rate, lowering it toward a floor while frames take too long
+    PACE_ON_CHANGE      ///< Draw at up to the Canvas' fixed rate, but only when something drawn changes or input arrives
+};
+
 /*! \class Timer
  *  \brief A class for various timing operations.
  *  \details Timer provides a simple timer for timing, sleeping threads, and keeping track of the
@@ -30,6 +39,8 @@ class Timer {
     timepoint_d start_time, last_time;
     std::mutex sleep_;
     double time_between_sleeps;
+
+    static const double SPIN_TIME;                  // Seconds before a deadline to stop sleeping and start spinning
  public:
     Timer(double period);
 
@@ -37,6 +48,8 @@ class Timer {
 
     unsigned int getReps() const;
 
+    double getPeriod();
+
     double getTime() const;
 
     double getTimeBetweenSleeps() const;
@@ -45,9 +58,15 @@ class Timer {
 
     void reset(double period = 0);
 
+    void setPeriod(double period);
+
     void sleep(bool update = true);
 
+    void tick();
+
     static void threadSleepFor(double duration);    // Sleep the thread for a specified duration
+
+    static void threadSleepUntil(timepoint_d deadline);
 };
 
 }
@@ -25,10 +25,8 @@ TriangleStrip::TriangleStrip(float centerX, float centerY, float centerZ, int nu
     numberOfOutlineVertices = numVertices;
     isOutlined = false;
     attribMutex.unlock();
-    for (int i = 0; i < numVertices; i++) {
-        addVertex(x[i] - centerX, y[i] - centerY, z[i] - centerZ, color);
-        addOutlineVertex(x[i] - centerX, y[i] - centerY, z[i] - centerZ, GRAY);
-    }
+    addVertices(x, y, z, centerX, centerY, centerZ, color);
+    addOutlineVertices(x, y, z, centerX, centerY, centerZ, GRAY);
 }
 
 /*!
@@ -54,9 +52,7 @@ TriangleStrip::TriangleStrip(float centerX, float centerY, float centerZ, int nu
     numberOfOutlineVertices = numVertices;
     isOutlined = false;
     attribMutex.unlock();
-    for (int i = 0; i < numVertices; i++) {
-        addVertex(x[i] - centerX, y[i] - centerY, z[i] - centerZ, color[i]);
-        addOutlineVertex(x[i] - centerX, y[i] - centerY, z[i] - centerZ, GRAY);
-    }
+    addVertices(x, y, z, centerX, centerY, centerZ, WHITE, color);
+    addOutlineVertices(x, y, z, centerX, centerY, centerZ, GRAY);
 }
 }
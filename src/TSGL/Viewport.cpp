@@ -0,0 +1,110 @@
+#include "Viewport.h"
+
+#include <algorithm>
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new Viewport.
+  * \details Called by Canvas::addViewport().
+  *   \param x The x coordinate in pixels of the left of the Viewport, from the left of the window.
+  *   \param y The y coordinate in pixels of the top of the Viewport, from the top of the window.
+  *   \param width The width of the Viewport in pixels.
+  *   \param height The height of the Viewport in pixels.
+  *   \param background The Background to draw behind the Viewport's Drawables, or nullptr to create one.
+  *   \param color The clear color of the Background the Viewport creates, if it creates one.
+  *   \param signal The ChangeSignal of the Canvas the Viewport belongs to.
+  * \return A new Viewport.
+  */
+Viewport::Viewport(GLint x, GLint y, GLint width, GLint height, Background * background, const ColorFloat &color,
+                   ChangeSignal * signal) {
+    myX = x, myY = y;
+    myWidth = width, myHeight = height;
+    mySignal = signal;
+    objectMutex.setSignal(mySignal);
+
+    defaultBackground = (background == nullptr);
+    if (defaultBackground) {
+        myBackground = new Background(myWidth, myHeight, color);
+    } else {
+        myBackground = background;
+        if (myBackground->getWidth() != myWidth || myBackground->getHeight() != myHeight)
+            TsglDebug("A Viewport's Background should be the same size as the Viewport.");
+    }
+    myBackground->setChangeSignal(mySignal);
+
+    // Look at the whole Background, as a Canvas or CartesianCanvas of the same size would
+    myAspect = (float) myWidth / myHeight;
+    myCamera = new Camera(glm::vec3(0.0f, 0.0f, (myHeight / 2) / tan(glm::pi<float>()/6)),glm::vec3(0.0f,1.0f,0.0f),glm::vec3(0.0f,0.0f,0.0f));
+    CartesianBackground * cart = dynamic_cast<CartesianBackground*>(myBackground);
+    if (cart) {
+        myAspect = (float) (cart->getCartWidth() / cart->getCartHeight());
+        myCamera->setPosition((float) (cart->getMaxX() + cart->getMinX()) / 2, (float) (cart->getMaxY() + cart->getMinY()) / 2,
+                              ((float) cart->getCartHeight() / 2) / tan(glm::pi<float>()/6));
+    }
+    myCamera->setChangeSignal(mySignal);
+}
+
+ /*!
+  * \brief Viewport destructor method.
+  * \details Frees the Camera, and the Background if the Viewport created it. Drawables added to the Viewport are not freed,
+  *   but no longer raise the Canvas' ChangeSignal, which is deleted with the Canvas.
+  */
+Viewport::~Viewport() {
+    objectMutex.lock();
+    takePendingObjects();
+    for (unsigned i = 0; i < objectBuffer.size(); i++)
+        objectBuffer[i]->setChangeSignal(nullptr);
+    objectMutex.unlock();
+    delete myCamera;
+    if (defaultBackground)
+        delete myBackground;
+    else
+        myBackground->setChangeSignal(nullptr);
+}
+
+ /*!
+  * \brief Adds a Drawable to the Viewport.
+  *   \param shapePtr Pointer to the Drawable to add to this Viewport.
+  */
+void Viewport::add(Drawable * shapePtr) {
+    shapePtr->setChangeSignal(mySignal);
+    pendingObjects.push(shapePtr);
+    objectMutex.raise();
+}
+
+// Called with objectMutex locked, to bring objectBuffer up to date with every add()
+void Viewport::takePendingObjects() {
+    std::vector<Drawable*> * objects = &objectBuffer;
+    pendingObjects.drain([objects](Drawable * d) { objects->push_back(d); });
+}
+
+ /*!
+  * \brief Removes a Drawable from the Viewport.
+  *   \param shapePtr Pointer to the Drawable to remove from this Viewport.
+  * \warning The Drawable being deleted or going out of scope before remove() is called will cause a segmentation fault.
+  */
+void Viewport::remove(Drawable * shapePtr) {
+    objectMutex.lock();
+    takePendingObjects();
+    objectBuffer.erase(std::remove(objectBuffer.begin(), objectBuffer.end(), shapePtr), objectBuffer.end());
+    objectMutex.unlock();
+    shapePtr->setChangeSignal(nullptr);
+}
+
+ /*!
+  * \brief Removes all Drawables from the Viewport.
+  *   \param shouldFreeMemory Whether the pointers will be deleted as well as removed. (Defaults to false.)
+  */
+void Viewport::clearObjectBuffer(bool shouldFreeMemory) {
+    objectMutex.lock();
+    takePendingObjects();
+    if (shouldFreeMemory) {
+        for (unsigned i = 0; i < objectBuffer.size(); i++)
+            delete objectBuffer[i];
+    }
+    objectBuffer.clear();
+    objectMutex.unlock();
+}
+
+}
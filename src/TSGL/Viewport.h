@@ -0,0 +1,98 @@
+/*
+ * Viewport.h provides a class for drawing a separate scene into part of a Canvas' window.
+ */
+
+#ifndef VIEWPORT_H_
+#define VIEWPORT_H_
+
+#include <vector>
+
+#include "Background.h"         // For the Viewport's own Background
+#include "Camera.h"             // For the Viewport's own Camera
+#include "CartesianBackground.h"
+#include "ChangeSignal.h"       // For waking the Canvas when the Viewport changes
+#include "Drawable.h"
+#include "SubmissionQueue.h"    // For adding Drawables from many threads without waiting on each other
+
+namespace tsgl {
+
+class Canvas;
+
+/*! \class Viewport
+ *  \brief A rectangle of a Canvas' window with its own Camera, Background and Drawables.
+ *  \details Viewports let one Canvas show several scenes side by side, such as a comparison between two
+ *    algorithms, without opening a window for each. Every Viewport is drawn by the Canvas' rendering thread
+ *    in the same pass as the Canvas' own scene, into the same window, after it and in the order they were added.
+ *  \details A Viewport's Background is the size of the Viewport, and its Camera starts out looking at the
+ *    Background the way a Canvas' Camera looks at its own, so Drawables use the same coordinates in a Viewport as
+ *    they would on a Canvas of the Viewport's size. With a CartesianBackground, they use its Cartesian coordinates.
+ *  \note Viewports are created with Canvas::addViewport() or Canvas::addViewportGrid(), and are deleted along with their Canvas.
+ */
+class Viewport {
+ private:
+    GLint myX, myY;                             // Top left corner, in pixels from the top left of the window
+    GLint myWidth, myHeight;
+    float myAspect;                             // Aspect ratio of the world the Viewport shows
+    Camera * myCamera;
+    Background * myBackground;
+    bool defaultBackground;                     // Whether myBackground was created by the Viewport
+    std::vector<Drawable*> objectBuffer;
+    ChangeMutex objectMutex;
+    SubmissionQueue<Drawable*> pendingObjects;  // Drawables added since objectBuffer was last updated
+    ChangeSignal * mySignal;                    // The Canvas' ChangeSignal, raised when Drawables are added or removed
+
+    Viewport(GLint x, GLint y, GLint width, GLint height, Background * background, const ColorFloat &color,
+             ChangeSignal * signal);
+
+    ~Viewport();
+
+    void takePendingObjects();
+
+    friend class Canvas;                        // Creates, draws and deletes Viewports
+ public:
+    void add(Drawable * shapePtr);
+
+    void remove(Drawable * shapePtr);
+
+    void clearObjectBuffer(bool shouldFreeMemory = false);
+
+    /*!
+     * \brief Accessor for the Viewport's Background.
+     * \return A pointer to the Background drawn behind the Viewport's Drawables.
+     */
+    Background * getBackground() { return myBackground; }
+
+    /*!
+     * \brief Accessor for the Viewport's Camera.
+     * \return A pointer to the Camera the Viewport's Background and Drawables are viewed through.
+     */
+    Camera * getCamera() { return myCamera; }
+
+    /*!
+     * \brief Accessor for the x-position of the Viewport.
+     * \return The x coordinate in pixels of the left of the Viewport, from the left of the window.
+     */
+    GLint getX() { return myX; }
+
+    /*!
+     * \brief Accessor for the y-position of the Viewport.
+     * \return The y coordinate in pixels of the top of the Viewport, from the top of the window.
+     */
+    GLint getY() { return myY; }
+
+    /*!
+     * \brief Accessor for the width of the Viewport.
+     * \return The width of the Viewport in pixels.
+     */
+    GLint getWidth() { return myWidth; }
+
+    /*!
+     * \brief Accessor for the height of the Viewport.
+     * \return The height of the Viewport in pixels.
+     */
+    GLint getHeight() { return myHeight; }
+};
+
+}
+
+#endif /* VIEWPORT_H_ */
@@ -49,7 +49,7 @@ void VisualTaskQueue::showLegend(int threads) {
   showingLegend = true;
   const int TEXTW = 24, GAP = 4;
   if (threads == -1)
-    threads = omp_get_num_threads();
+    threads = TaskPool::getThreadCount();
 
   //Ugly calculations :(
   int offset = border+space;
@@ -99,7 +99,7 @@ void VisualTaskQueue::update(int index, VQState state) {
     blockSize,
     0,0,0,
     Colors::blend(
-      Colors::highContrastColor(omp_get_thread_num()),(state == RUNNING) ? BLACK : WHITE,0.5f
+      Colors::highContrastColor(TaskPool::getThreadNumber()),(state == RUNNING) ? BLACK : WHITE,0.5f
     )
   );
 }
@@ -9,6 +9,7 @@
 #include <omp.h>
 
 #include "Canvas.h"
+#include "TaskPool.h"       // For telling TaskPool workers apart
 #include "tsgl.h"
 
 namespace tsgl {
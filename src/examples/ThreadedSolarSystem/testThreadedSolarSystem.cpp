@@ -70,18 +70,21 @@ void ssFunction(Canvas& can) {
 
     while (can.isOpen()) {
         can.sleep();
-        #pragma omp parallel
-        {
-            unsigned tid = omp_get_thread_num();
-            unsigned numThreads = omp_get_num_threads();
+        // Move every planet in the same frame
+        can.batch([&]() {
+            #pragma omp parallel
+            {
+                unsigned tid = omp_get_thread_num();
+                unsigned numThreads = omp_get_num_threads();
 
-            for(unsigned i = tid; i < 9; i += numThreads){
-                ThreadData * td = new ThreadData(tid, planetArray[i], rotationArray[i]);
-                // printf("Thread %d out of %d running planet %d\n", 
-                //         tid, numThreads - 1, i);
-                td->changePitch();
+                for(unsigned i = tid; i < 9; i += numThreads){
+                    ThreadData * td = new ThreadData(tid, planetArray[i], rotationArray[i]);
+                    // printf("Thread %d out of %d running planet %d\n", 
+                    //         tid, numThreads - 1, i);
+                    td->changePitch();
+                }
             }
-        }
+        });
     }
 
     delete sun;
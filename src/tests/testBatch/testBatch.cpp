@@ -0,0 +1,76 @@
+/*
+ * testBatch.cpp
+ *
+ * Usage: ./testBatch <width> <height> <numberOfThreads>
+ */
+
+#include <tsgl.h>
+#include <omp.h>
+#include <vector>
+
+using namespace tsgl;
+
+/*!
+ * \brief Recolors columns of squares from an OpenMP parallel region inside a batch.
+ * \details
+ * - A grid of squares has one column per thread.
+ * - Each step, batch() runs an OpenMP parallel region. Every thread in it pauses drawing, recolors its own column,
+ *   waits at a barrier for the others, and resumes drawing, so the threads join the batch's update as they start.
+ * - Every column changes color at once: the Canvas never draws a frame with only some of them changed.
+ * - Every other step does the same without the batch, so each thread's pause waits on the others at the barrier.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param threads The number of threads, and of columns.
+ */
+void batchFunction(Canvas& can, int threads) {
+    const int ROWS = 8;
+    const float WW = can.getWindowWidth(), WH = can.getWindowHeight();
+    float side = std::min(WW / threads, WH / ROWS) * 0.8f;
+
+    std::vector<Rectangle*> squares;
+    for (int c = 0; c < threads; c++)
+        for (int r = 0; r < ROWS; r++) {
+            squares.push_back(new Rectangle((c + 0.5f) * WW / threads - WW/2, (r + 0.5f) * WH / ROWS - WH/2, 0,
+                                            side, side, 0, 0, 0, WHITE));
+            can.add(squares.back());
+        }
+
+    int step = 0;
+    while (can.isOpen()) {
+        can.sleep();
+        ColorFloat color = ColorHSV(step % 6, 1.0f, 1.0f);
+        std::function<void()> recolor = [&]() {
+            #pragma omp parallel num_threads(threads)
+            {
+                int tid = omp_get_thread_num();
+                can.pauseDrawing();
+                for (int r = 0; r < ROWS; r++)
+                    squares[tid * ROWS + r]->setColor(color);
+                #pragma omp barrier
+                can.resumeDrawing();
+            }
+        };
+        if (step % 2)
+            can.batch(recolor);
+        else
+            recolor();
+        step++;
+    }
+
+    for (unsigned i = 0; i < squares.size(); i++)
+        delete squares[i];
+}
+
+//Takes command-line arguments for the width and height of the window and the number of threads
+int main(int argc, char * argv[]) {
+    int w = (argc > 1) ? atoi(argv[1]) : 0.9*Canvas::getDisplayHeight();
+    int h = (argc > 2) ? atoi(argv[2]) : w/2;
+    if (w <= 0 || h <= 0) {
+        w = 0.9*Canvas::getDisplayHeight();
+        h = w/2;
+    }
+    int t = (argc > 3) ? atoi(argv[3]) : omp_get_num_procs();
+    if (t <= 0) t = omp_get_num_procs();
+    Canvas c(-1, -1, w, h, "Batched Parallel Updates", BLACK);
+    c.run(batchFunction, t);
+}
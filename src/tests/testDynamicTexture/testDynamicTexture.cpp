@@ -0,0 +1,75 @@
+/*
+ * testDynamicTexture.cpp
+ *
+ * Usage: ./testDynamicTexture <width> <height> <numThreads>
+ */
+
+#include <tsgl.h>
+#include <vector>
+
+using namespace tsgl;
+
+/*!
+ * \brief Streams animated pixels from memory into DynamicTextures on a Canvas.
+ * \details
+ * - A full-frame RGBA plasma is recomputed in parallel and uploaded with update() every frame.
+ * - A grayscale DynamicTexture is updated one 16-row band at a time, showing sub-rectangle updates.
+ * - The plasma is spun in 3D to show that a DynamicTexture is an ordinary Drawable.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param numberOfThreads The number of threads computing the plasma.
+ */
+void dynamicTextureFunction(Canvas& can, int numberOfThreads) {
+    const int PW = 256, PH = 256;
+    int ww = can.getWindowWidth(), hh = can.getWindowHeight();
+    int side = std::min(ww/3, hh*9/10);     // Fit both textures in short windows too
+
+    DynamicTexture * plasma = new DynamicTexture(-ww/4, 0, 0, PW, PH, PIXEL_RGBA, side, side, 0, 0, 0);
+    can.add(plasma);
+    DynamicTexture * bands = new DynamicTexture(ww/4, 0, 0, PW, PH, PIXEL_GRAY, side, side, 0, 0, 0);
+    can.add(bands);
+
+    std::vector<unsigned char> rgba(PW * PH * 4);
+    std::vector<unsigned char> band(PW * 16);
+    float t = 0.0f;
+    int bandRow = 0;
+    while (can.isOpen()) {
+        can.sleep();
+        #pragma omp parallel for num_threads(numberOfThreads)
+        for (int y = 0; y < PH; y++) {
+            for (int x = 0; x < PW; x++) {
+                float v = sin(x / 16.0f + t) + sin(y / 8.0f - t) + sin((x + y) / 32.0f + 2 * t);
+                unsigned char* p = &rgba[(y * PW + x) * 4];
+                p[0] = (unsigned char) (127 + 127 * sin(v * PI));
+                p[1] = (unsigned char) (127 + 127 * sin(v * PI + 2));
+                p[2] = (unsigned char) (127 + 127 * sin(v * PI + 4));
+                p[3] = 255;
+            }
+        }
+        plasma->update(rgba.data());
+        plasma->changeYawBy(0.5);
+
+        unsigned char shade = (unsigned char) (can.getFrameNumber() * 7);
+        for (unsigned i = 0; i < band.size(); i++)
+            band[i] = shade;
+        bands->update(band.data(), 0, bandRow, PW, 16);
+        bandRow = (bandRow + 16) % PH;
+
+        t += 0.05f;
+    }
+
+    delete plasma;
+    delete bands;
+}
+
+//Takes command-line arguments for the width and height of the screen and the number of threads
+int main(int argc, char * argv[]) {
+    int w = (argc > 1) ? atoi(argv[1]) : 1.2*Canvas::getDisplayHeight();
+    int h = (argc > 2) ? atoi(argv[2]) : 0.5*w;
+    if(w <= 0 || h <= 0) { //Check width and height validity
+      w = 1.2*Canvas::getDisplayHeight(); h = 0.5*w;
+    }
+    int t = (argc > 3) ? atoi(argv[3]) : omp_get_num_procs();
+    Canvas c(-1, -1, w, h ,"Dynamic Textures", BLACK);
+    c.run(dynamicTextureFunction, t);
+}
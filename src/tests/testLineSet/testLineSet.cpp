@@ -0,0 +1,78 @@
+/*
+ * testLineSet.cpp
+ *
+ * Usage: ./testLineSet <width> <height> <numberOfSegments>
+ */
+
+#include <tsgl.h>
+#include <vector>
+
+using namespace tsgl;
+
+/*!
+ * \brief Draws a large, animated web of line segments with a single LineSet.
+ * \details
+ * - A LineSet is filled with <code>numberOfSegments</code> segments joining random points on a ring.
+ * - Every frame, the endpoints are moved in place with one ranged update() call.
+ * - A second LineSet gives each of its segments a color of its own.
+ * - Pressing the space bar clears the colored LineSet and refills it.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param numberOfSegments The number of segments in the web.
+ */
+void lineSetFunction(Canvas& can, int numberOfSegments) {
+    int ww = can.getWindowWidth(), hh = can.getWindowHeight();
+    float radius = std::min(ww, hh) / 3.0f;
+
+    std::vector<float> angles(numberOfSegments * 2);
+    for (unsigned i = 0; i < angles.size(); i++)
+        angles[i] = saferand(0, 36000) / 36000.0f * 2 * PI;
+
+    LineSet * web = new LineSet(0, 0, 0, 0, 0, 0, ColorFloat(1, 1, 1, 0.1), numberOfSegments);
+    std::vector<GLfloat> segments(numberOfSegments * 6, 0.0f);
+    web->append(numberOfSegments, segments.data());
+    can.add(web);
+
+    LineSet * spokes = new LineSet(0, 0, 0, 0, 0, 0, WHITE);
+    for (int i = 0; i < 360; i += 5)
+        spokes->append(0, 0, 0, radius * 1.2 * cos(i * PI / 180), radius * 1.2 * sin(i * PI / 180), 0, ColorHSV(i / 60.0f, 1, 1));
+    can.add(spokes);
+
+    can.bindToButton(TSGL_SPACE, TSGL_PRESS, [&spokes, radius]() {
+        spokes->clear();
+        int step = saferand(2, 10);
+        for (int i = 0; i < 360; i += step)
+            spokes->append(0, 0, 0, radius * 1.2 * cos(i * PI / 180), radius * 1.2 * sin(i * PI / 180), 0, ColorHSV(i / 60.0f, 1, 1));
+    });
+
+    float t = 0.0f;
+    while (can.isOpen()) {
+        can.sleep();
+        for (int i = 0; i < numberOfSegments; i++) {
+            float a1 = angles[i*2] + t, a2 = angles[i*2 + 1] - t;
+            segments[i*6]     = radius * cos(a1);
+            segments[i*6 + 1] = radius * sin(a1);
+            segments[i*6 + 3] = radius * cos(a2);
+            segments[i*6 + 4] = radius * sin(a2);
+        }
+        web->update(0, numberOfSegments, segments.data());
+        spokes->changeYawBy(0.2);
+        t += 0.002f;
+    }
+
+    delete web;
+    delete spokes;
+}
+
+//Takes command-line arguments for the width and height of the screen and the number of segments
+int main(int argc, char * argv[]) {
+    int w = (argc > 1) ? atoi(argv[1]) : 0.9*Canvas::getDisplayHeight();
+    int h = (argc > 2) ? atoi(argv[2]) : w;
+    if(w <= 0 || h <= 0) { //Check width and height validity
+      w = 0.9*Canvas::getDisplayHeight(); h = w;
+    }
+    int n = (argc > 3) ? atoi(argv[3]) : 100000;
+    if (n <= 0) n = 100000;
+    Canvas c(-1, -1, w, h, "Line Sets", BLACK);
+    c.run(lineSetFunction, n);
+}
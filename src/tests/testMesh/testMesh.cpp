@@ -0,0 +1,80 @@
+/*
+ * testMesh.cpp
+ *
+ * Usage: ./testMesh <width> <height> <filename> <scale>
+ */
+
+#include <tsgl.h>
+#include <cmath>
+
+using namespace tsgl;
+
+/*!
+ * \brief Spins a Mesh loaded from a file, or a generated torus.
+ * \details
+ * - If a file name is given as the third argument, the OBJ or PLY file is loaded into a Mesh
+ *   and scaled by the fourth argument (1 by default).
+ * - Otherwise, a torus with a quarter of a million triangles is built from arrays.
+ * - Every frame, the Mesh turns a little about two axes.
+ * - Pressing the space bar switches its color between white and orange.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param argc The number of command-line arguments.
+ * \param argv The command-line arguments.
+ */
+void meshFunction(Canvas& can, int argc, char * argv[]) {
+    Mesh * mesh;
+    if (argc <= 3) {
+        const int RINGS = 500, SIDES = 250;
+        const float R = 200, r = 80;
+        std::vector<GLfloat> vertices(RINGS * SIDES * 3);
+        std::vector<GLuint> indices(RINGS * SIDES * 6);
+        for (int i = 0; i < RINGS; i++) {
+            float u = 2 * PI * i / RINGS;
+            for (int j = 0; j < SIDES; j++) {
+                float v = 2 * PI * j / SIDES;
+                GLfloat * p = &vertices[(i * SIDES + j) * 3];
+                p[0] = (R + r * cos(v)) * cos(u);
+                p[1] = (R + r * cos(v)) * sin(u);
+                p[2] = r * sin(v);
+                GLuint a = i * SIDES + j, b = ((i + 1) % RINGS) * SIDES + j;
+                GLuint c = i * SIDES + (j + 1) % SIDES, d = ((i + 1) % RINGS) * SIDES + (j + 1) % SIDES;
+                GLuint quad[6] = { a, b, d, a, d, c };
+                std::copy(quad, quad + 6, &indices[(i * SIDES + j) * 6]);
+            }
+        }
+        mesh = new Mesh(0, 0, 0, RINGS * SIDES, vertices.data(), RINGS * SIDES * 2, indices.data(), 0, 0, 0);
+    } else {
+        float scale = (argc > 4) ? atof(argv[4]) : 1;
+        mesh = new Mesh(0, 0, 0, argv[3], scale, 0, 0, 0);
+    }
+    printf("%d vertices, %d triangles\n", mesh->getVertexCount(), mesh->getTriangleCount());
+    can.add(mesh);
+
+    bool white = true;
+    can.bindToButton(TSGL_SPACE, TSGL_PRESS, [&mesh, &white]() {
+        white = !white;
+        mesh->setColor(white ? WHITE : ORANGE);
+    });
+
+    float rotation = 0.0f;
+    while (can.isOpen()) {
+        can.sleep();
+        mesh->setPitch(rotation);
+        mesh->setRoll(rotation * 0.7f);
+        rotation += 0.5f;
+    }
+
+    delete mesh;
+}
+
+//Takes command-line arguments for the width and height of the screen, a mesh file and its scale
+int main(int argc, char * argv[]) {
+    int w = (argc > 1) ? atoi(argv[1]) : 0.9*Canvas::getDisplayHeight();
+    int h = (argc > 2) ? atoi(argv[2]) : w;
+    if(w <= 0 || h <= 0) { //Check width and height validity
+      w = 0.9*Canvas::getDisplayHeight(); h = w;
+    }
+    Canvas c(-1, -1, w, h, "Meshes", BLACK);
+    c.run(meshFunction, argc, argv);
+}
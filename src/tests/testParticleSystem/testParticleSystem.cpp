@@ -0,0 +1,72 @@
+/*
+ * testParticleSystem.cpp
+ *
+ * Usage: ./testParticleSystem <width> <height> <numberOfParticles> <numThreads>
+ */
+
+#include <tsgl.h>
+
+using namespace tsgl;
+
+/*!
+ * \brief Launches fireworks made of particles from a single ParticleSystem.
+ * \details
+ * - A ParticleSystem with room for <code>numberOfParticles</code> particles is added to the Canvas.
+ * - Every frame, a burst of particles is emitted at a random point with a random hue.
+ * - step() moves every particle under gravity and drag, and fades it out.
+ * - update() gives the particles a twinkle, split across <code>threads</code> threads.
+ * - Faded particles are removed with removeFaded().
+ * - Pressing the space bar switches between round and square particles.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param numberOfParticles The greatest number of particles alive at once.
+ * \param threads The number of threads to update the particles with.
+ */
+void particleFunction(Canvas& can, int numberOfParticles, int threads) {
+    int ww = can.getWindowWidth(), hh = can.getWindowHeight();
+    ParticleSystem * sparks = new ParticleSystem(0, 0, 0, 0, 0, 0, numberOfParticles);
+    can.add(sparks);
+
+    bool round = true;
+    can.bindToButton(TSGL_SPACE, TSGL_PRESS, [&sparks, &round]() {
+        round = !round;
+        sparks->setRound(round);
+    });
+
+    int burst = std::max(1, numberOfParticles / 200);
+    int frame = 0;
+    while (can.isOpen()) {
+        can.sleep();
+        float cx = saferand(-ww/3, ww/3), cy = saferand(-hh/4, hh/3);
+        ColorFloat color = ColorHSV(saferand(0, 599) / 100.0f, 1, 1);
+        for (int i = 0; i < burst; i++) {
+            float angle = randfloat(10000) * 2 * PI, speed = randfloat(10000) * 250;
+            if (sparks->emit(cx, cy, 0, speed * cos(angle), speed * sin(angle), 0, color, 2) < 0)
+                break;
+        }
+        float dt = can.getTimeBetweenSleeps();
+        sparks->step(dt, 0, -150, 0, 0.8f, 0.4f);
+        int phase = ++frame;
+        sparks->update([phase](ParticleSystem::Particles& p, int first, int last) {
+            for (int i = first; i < last; i++)
+                p.size[i] = 2 + ((i + phase) % 8 == 0 ? 2 : 0);
+        }, threads);
+        sparks->removeFaded();
+    }
+
+    delete sparks;
+}
+
+//Takes command-line arguments for the width and height of the screen, the number of particles and the number of threads
+int main(int argc, char * argv[]) {
+    int w = (argc > 1) ? atoi(argv[1]) : 0.9*Canvas::getDisplayHeight();
+    int h = (argc > 2) ? atoi(argv[2]) : w;
+    if(w <= 0 || h <= 0) { //Check width and height validity
+      w = 0.9*Canvas::getDisplayHeight(); h = w;
+    }
+    int n = (argc > 3) ? atoi(argv[3]) : 500000;
+    if (n <= 0) n = 500000;
+    int t = (argc > 4) ? atoi(argv[4]) : omp_get_num_procs();
+    Canvas c(-1, -1, w, h, "Particle System", BLACK);
+    c.run(particleFunction, n, t);
+}
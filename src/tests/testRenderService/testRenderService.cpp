@@ -0,0 +1,90 @@
+/*
+ * testRenderService.cpp
+ *
+ * Usage: ./testRenderService <numberOfCanvases> <squaresPerCanvas>
+ */
+
+#include <tsgl.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace tsgl;
+
+/*!
+ * \brief Spins a ring of squares on one of several Canvases drawn by the RenderService.
+ * \details
+ * - Every Canvas is drawn by the RenderService's single thread rather than a thread of its own.
+ * - Even-numbered Canvases draw every frame; odd-numbered ones use PACE_ON_CHANGE, and stop drawing
+ *   while the space bar pauses them.
+ * - Pressing B on a Canvas holds a batch on it for two seconds. Its squares jump only once the batch ends,
+ *   and the other Canvases keep animating in the meantime.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param index Which of the Canvases this is.
+ * \param squares The number of squares in the ring.
+ */
+void spinFunction(Canvas& can, int index, int squares) {
+    if (index % 2)
+        can.setFramePacing(PACE_ON_CHANGE);
+    float radius = std::min(can.getWindowWidth(), can.getWindowHeight()) / 3.0f;
+    float side = radius * 2 * PI / squares / 2;
+
+    std::vector<Rectangle*> ring;
+    for (int i = 0; i < squares; i++) {
+        float a = i * 2 * PI / squares;
+        ring.push_back(new Rectangle(radius * cos(a), radius * sin(a), 0, side, side, 0, 0, 0,
+                                     ColorHSV(6.0f * i / squares, 1, 1)));
+        can.add(ring.back());
+    }
+
+    std::atomic<bool> paused(false), batchRequested(false);
+    can.bindToButton(TSGL_SPACE, TSGL_PRESS, [&paused]() { paused = !paused; });
+    // Key handlers run on the rendering thread, which draws every Canvas, so the batch itself is held below
+    can.bindToButton(TSGL_B, TSGL_PRESS, [&batchRequested]() { batchRequested = true; });
+
+    float t = 0.0f;
+    while (can.isOpen()) {
+        can.sleep();
+        if (batchRequested.exchange(false)) {
+            can.batch([&]() {
+                for (int i = 0; i < squares; i++)
+                    ring[i]->changeRollBy(45);
+                can.sleepFor(2.0f);
+            });
+        }
+        if (paused) continue;
+        for (int i = 0; i < squares; i++) {
+            float a = i * 2 * PI / squares + t;
+            ring[i]->setCenter(radius * cos(a), radius * sin(a), 0);
+            ring[i]->changeYawBy(1);
+        }
+        t += (index % 2) ? -0.01f : 0.01f;
+    }
+
+    for (unsigned i = 0; i < ring.size(); i++)
+        delete ring[i];
+}
+
+//Takes command-line arguments for the number of Canvases and the number of squares on each
+int main(int argc, char * argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 4;
+    if (n <= 0) n = 4;
+    int squares = (argc > 2) ? atoi(argv[2]) : 24;
+    if (squares <= 0) squares = 24;
+    int size = Canvas::getDisplayHeight() / 3;
+
+    RenderService::setEnabled(true);
+    std::vector<Canvas*> canvases;
+    for (int i = 0; i < n; i++)
+        canvases.push_back(new Canvas((i % 4) * (size + 10), (i / 4) * (size + 40), size, size,
+                                      "Render Service " + std::to_string(i + 1), BLACK));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < n; i++)
+        threads.push_back(std::thread([&canvases, i, squares]() { canvases[i]->run(spinFunction, i, squares); }));
+    for (int i = 0; i < n; i++)
+        threads[i].join();
+    for (int i = 0; i < n; i++)
+        delete canvases[i];
+}
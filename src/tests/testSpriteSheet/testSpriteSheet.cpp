@@ -0,0 +1,72 @@
+/*
+ * testSpriteSheet.cpp
+ *
+ * Usage: ./testSpriteSheet <width> <height> <numSprites>
+ */
+
+#include <tsgl.h>
+
+using namespace tsgl;
+
+/*!
+ * \brief Draws many Sprites from two SpriteSheets on a Canvas.
+ * \details Showcases batched sprite drawing.
+ * - An atlas is packed from three image files, and <code>numSprites</code> Sprites are scattered across the Canvas,
+ *   each showing one of the three files and spinning.
+ * - A second SpriteSheet splits a single image into a 4x2 grid, and one Sprite cycles through the cells.
+ * - Each SpriteSheet draws all of its Sprites in one batch, regardless of how many there are.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param numSprites The number of Sprites to scatter across the Canvas.
+ */
+void spriteSheetFunction(Canvas& can, int numSprites) {
+    int ww = can.getWindowWidth(), hh = can.getWindowHeight();
+
+    std::vector<std::string> files;
+    files.push_back("pics/cow.jpg");
+    files.push_back("pics/sky_main.jpg");
+    files.push_back("pics/colorfulKeyboard.jpg");
+    SpriteSheet * atlas = new SpriteSheet(files);
+    can.add(atlas);
+
+    std::vector<Sprite*> sprites;
+    for (int i = 0; i < numSprites; i++) {
+        float x = saferand(-ww/2, ww/2), y = saferand(-hh/2, hh/2);
+        float alpha = (i % 4 == 0) ? 0.5f : 1.0f;
+        sprites.push_back(new Sprite(x, y, 0, atlas, i % atlas->getRegionCount(), 40, 30, saferand(0, 359), 0, 0, alpha));
+    }
+
+    SpriteSheet * grid = new SpriteSheet("pics/colorfulKeyboard.jpg", 4, 2);
+    can.add(grid);
+    Sprite * animated = new Sprite(0, 0, 1, grid, 0, ww/4, hh/4, 0, 0, 0);
+
+    float floatVal = 0.0f;
+    while (can.isOpen()) {
+        can.sleep();
+        for (unsigned i = 0; i < sprites.size(); i++)
+            sprites[i]->changeYawBy(1);
+        if (can.getFrameNumber() % 15 == 0)
+            animated->setRegion((animated->getRegion() + 1) % grid->getRegionCount());
+        animated->setCenterY(sin(floatVal) * hh/4);
+        floatVal += 0.02;
+    }
+
+    delete animated;
+    for (unsigned i = 0; i < sprites.size(); i++)
+        delete sprites[i];
+    delete grid;
+    delete atlas;
+}
+
+//Takes command-line arguments for the width and height of the screen and the number of sprites
+int main(int argc, char * argv[]) {
+    int w = (argc > 1) ? atoi(argv[1]) : 1.2*Canvas::getDisplayHeight();
+    int h = (argc > 2) ? atoi(argv[2]) : 0.75*w;
+    if(w <= 0 || h <= 0) { //Check width and height validity
+      w = 1.2*Canvas::getDisplayHeight(); h = 0.75*w;
+    }
+    int numSprites = (argc > 3) ? atoi(argv[3]) : 2000;
+    if (numSprites <= 0) numSprites = 2000;
+    Canvas c(-1, -1, w, h ,"Sprite Sheets", WHITE);
+    c.run(spriteSheetFunction, numSprites);
+}
@@ -0,0 +1,73 @@
+/*
+ * testStreamingPolyline.cpp
+ *
+ * Usage: ./testStreamingPolyline <width> <height> <samplesPerFrame>
+ */
+
+#include <tsgl.h>
+
+using namespace tsgl;
+
+/*!
+ * \brief Plots two live signals with StreamingPolylines.
+ * \details
+ * - The top StreamingPolyline keeps only the most recent samples, so its window scrolls across the screen.
+ * - The bottom StreamingPolyline keeps every sample, advancing one pixel per frame, and is cleared
+ *   whenever it reaches the right edge of the window.
+ * - Every frame, <code>samplesPerFrame</code> samples of a noisy sine wave are appended to each.
+ * - Pressing the space bar clears both plots.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param samplesPerFrame The number of samples appended to each plot every frame.
+ */
+void streamingPolylineFunction(Canvas& can, int samplesPerFrame) {
+    int ww = can.getWindowWidth(), hh = can.getWindowHeight();
+    int window = samplesPerFrame * 240;       // About four seconds of samples at 60 frames per second
+    StreamingPolyline * recent = new StreamingPolyline(ww/2, hh/4, 0, 0, 0, 0, GREEN, window);
+    StreamingPolyline * history = new StreamingPolyline(-ww/2, -hh/4, 0, 0, 0, 0, YELLOW);
+    can.add(recent);
+    can.add(history);
+
+    int sample = 0, historySample = 0;
+    can.bindToButton(TSGL_SPACE, TSGL_PRESS, [&recent, &history, &sample, &historySample]() {
+        recent->clear();
+        history->clear();
+        sample = historySample = 0;
+    });
+
+    std::vector<GLfloat> recentBatch(samplesPerFrame * 2), historyBatch(samplesPerFrame * 2);
+    while (can.isOpen()) {
+        can.sleep();
+        if (historySample / samplesPerFrame >= ww) {
+            history->clear();
+            historySample = 0;
+        }
+        for (int i = 0; i < samplesPerFrame; i++, sample++, historySample++) {
+            float y = hh/8 * sin(sample / 200.0f) + saferand(-hh/64, hh/64);
+            recentBatch[i*2] = (double) sample * ww / window;
+            recentBatch[i*2 + 1] = y;
+            historyBatch[i*2] = (float) historySample / samplesPerFrame;
+            historyBatch[i*2 + 1] = y;
+        }
+        recent->append(samplesPerFrame, recentBatch.data());
+        history->append(samplesPerFrame, historyBatch.data());
+        // Scroll the recent window so that its newest sample is at the right edge
+        recent->setCenterX(ww/2 - recentBatch[samplesPerFrame*2 - 2]);
+    }
+
+    delete recent;
+    delete history;
+}
+
+//Takes command-line arguments for the width and height of the screen and the number of samples per frame
+int main(int argc, char * argv[]) {
+    int w = (argc > 1) ? atoi(argv[1]) : 0.9*Canvas::getDisplayHeight();
+    int h = (argc > 2) ? atoi(argv[2]) : w;
+    if(w <= 0 || h <= 0) { //Check width and height validity
+      w = 0.9*Canvas::getDisplayHeight(); h = w;
+    }
+    int n = (argc > 3) ? atoi(argv[3]) : 1000;
+    if (n <= 0) n = 1000;
+    Canvas c(-1, -1, w, h, "Streaming Polylines", BLACK);
+    c.run(streamingPolylineFunction, n);
+}
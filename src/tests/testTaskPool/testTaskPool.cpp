@@ -0,0 +1,93 @@
+/*
+ * testTaskPool.cpp
+ *
+ * Usage: ./testTaskPool <width> <numberOfWorkers>
+ */
+
+#include <tsgl.h>
+#include <atomic>
+#include <complex>
+
+using namespace tsgl;
+
+/*!
+ * \brief Renders Julia sets row by row with a TaskPool, showing what each worker does.
+ * \details
+ * - A TaskPool with <code>numberOfWorkers</code> workers renders each row of the image with parallelFor().
+ * - A VisualTaskQueue shows which thread rendered each row. Its legend has one more entry than there are workers,
+ *   for the thread that waits on parallelFor(), which renders rows too.
+ * - A ProgressBar under the image fills as its share of the rows is rendered, one segment per share.
+ * - A Spectrogram counts the rows each thread rendered.
+ * - Pressing the space bar renders a different Julia set; pressing C cancels the current one part way through.
+ * .
+ * \param can Reference to the Canvas being drawn to.
+ * \param numberOfWorkers The number of workers in the TaskPool.
+ */
+void taskPoolFunction(Canvas& can, int numberOfWorkers) {
+    Background * bg = can.getBackground();
+    const int WW = can.getWindowWidth(), BAR = 40, IH = can.getWindowHeight() - BAR, DEPTH = 255;
+    TaskPool pool(numberOfWorkers);
+
+    VisualTaskQueue vq(IH);
+    vq.showLegend(pool.getWorkers() + 1);
+    ProgressBar * pb = new ProgressBar(0, -can.getWindowHeight()/2 + BAR/2, 0, WW - 20, BAR/2, 0, IH, pool.getWorkers() + 1, 0, 0, 0);
+    can.add(pb);
+    Spectrogram sp(RADIAL, 300);
+
+    pool.setVisualTaskQueue(&vq);
+    pool.setProgressBar(pb);
+    pool.setSpectrogram(&sp);
+
+    std::atomic<bool> redraw(true);
+    can.bindToButton(TSGL_SPACE, TSGL_PRESS, [&redraw]() { redraw = true; });
+    can.bindToButton(TSGL_C, TSGL_PRESS, [&pool]() { pool.cancel(); });
+
+    float angle = 0;
+    while (can.isOpen()) {
+        if (!redraw.exchange(false)) {
+            can.sleep();
+            vq.sleep();
+            continue;
+        }
+        std::complex<float> k(0.7885f * cos(angle), 0.7885f * sin(angle));
+        angle += 0.4f;
+        vq.reset();
+        for (int s = 0; s < pb->getSegs(); s++)
+            pb->update(0, s);
+
+        bool finished = pool.parallelFor(0, IH, [&](int row) {
+            float y = can.getWindowHeight()/2 - row;
+            for (int col = 0; col < WW && !pool.isCancelled(); col++) {
+                std::complex<float> z(3.0f * col / WW - 1.5f, 3.0f * row / IH - 1.5f);
+                int iterations = 0;
+                while (std::abs(z) < 2.0f && iterations != DEPTH) {
+                    z = z * z + k;
+                    iterations++;
+                }
+                float mult = (float) iterations / DEPTH;
+                bg->drawPixel(col - WW/2, y, ColorHSV(6.0f * mult, 1.0f, (iterations == DEPTH) ? 0.0f : 1.0f));
+            }
+        }, 1);
+        pool.wait();    // Lets the pool run again if it was cancelled
+        sp.draw(1.0f);
+        if (!finished)
+            printf("Cancelled; press the space bar to render another Julia set.\n");
+    }
+
+    pool.setVisualTaskQueue(nullptr);
+    pool.setProgressBar(nullptr);
+    pool.setSpectrogram(nullptr);
+    sp.finish();
+    vq.close();
+    delete pb;
+}
+
+//Takes command-line arguments for the width of the window and the number of workers in the TaskPool
+int main(int argc, char * argv[]) {
+    int w = (argc > 1) ? atoi(argv[1]) : 0.6*Canvas::getDisplayHeight();
+    if (w <= 0) w = 0.6*Canvas::getDisplayHeight();
+    int t = (argc > 2) ? atoi(argv[2]) : 0;    // 0 starts one worker per core
+    if (t < 0) t = 0;
+    Canvas c(-1, -1, w, w + 40, "Task Pool", BLACK);
+    c.run(taskPoolFunction, t);
+}
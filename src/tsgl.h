@@ -16,6 +16,7 @@
 #include <TSGL/IntegralViewer.h>
 #include <TSGL/Keynums.h>
 #include <TSGL/Spectrogram.h>
+#include <TSGL/TaskPool.h>
 #include <TSGL/Timer.h>
 #include <TSGL/Util.h>
 #include <TSGL/VisualTaskQueue.h>